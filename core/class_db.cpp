@@ -1168,6 +1168,30 @@ StringName ClassDB::get_property_setter(StringName p_class, const StringName &p_
 	return StringName();
 }
 
+bool ClassDB::get_property_setter_bind(const StringName &p_class, const StringName &p_property, MethodBind *&r_setter, int &r_index) {
+
+	// resolves the same setter set_property() would call, so it can be cached and called directly
+	ClassInfo *type = classes.getptr(p_class);
+	ClassInfo *check = type;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+
+			if (!psg->setter || !psg->_setptr) {
+				return false;
+			}
+
+			r_setter = psg->_setptr;
+			r_index = psg->index;
+			return true;
+		}
+
+		check = check->inherits_ptr;
+	}
+
+	return false;
+}
+
 StringName ClassDB::get_property_getter(StringName p_class, const StringName &p_property) {
 
 	ClassInfo *type = classes.getptr(p_class);
@@ -364,6 +364,7 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 					*r_error = OK;
 				ResourceCache::lock.read_unlock();
 				_remove_from_loading_map(local_path);
+				ResourceCache::soft_retain(res);
 				return res;
 			}
 		}
@@ -407,6 +408,7 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 
 	if (!p_no_cache) {
 		_remove_from_loading_map(local_path);
+		ResourceCache::soft_retain(res);
 	}
 
 	if (_loaded_callback) {
@@ -0,0 +1,454 @@
+/*************************************************************************/
+/*  mesh_simplifier.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "mesh_simplifier.h"
+
+#include "core/hash_map.h"
+#include "core/local_vector.h"
+#include "core/sort_array.h"
+
+namespace {
+
+struct Quadric {
+
+	double a2, b2, c2, d2;
+	double ab, ac, ad, bc, bd, cd;
+	double weight;
+
+	void add_plane(const Vector3 &p_normal, double p_d, double p_weight) {
+
+		double a = p_normal.x;
+		double b = p_normal.y;
+		double c = p_normal.z;
+
+		a2 += a * a * p_weight;
+		b2 += b * b * p_weight;
+		c2 += c * c * p_weight;
+		d2 += p_d * p_d * p_weight;
+		ab += a * b * p_weight;
+		ac += a * c * p_weight;
+		ad += a * p_d * p_weight;
+		bc += b * c * p_weight;
+		bd += b * p_d * p_weight;
+		cd += c * p_d * p_weight;
+		weight += p_weight;
+	}
+
+	void add(const Quadric &p_q) {
+
+		a2 += p_q.a2;
+		b2 += p_q.b2;
+		c2 += p_q.c2;
+		d2 += p_q.d2;
+		ab += p_q.ab;
+		ac += p_q.ac;
+		ad += p_q.ad;
+		bc += p_q.bc;
+		bd += p_q.bd;
+		cd += p_q.cd;
+		weight += p_q.weight;
+	}
+
+	// mean squared distance of p_point to the planes, weighted by area
+	double error(const Vector3 &p_point) const {
+
+		if (weight <= 0.0) {
+			return 0.0;
+		}
+
+		double x = p_point.x;
+		double y = p_point.y;
+		double z = p_point.z;
+
+		double e = a2 * x * x + b2 * y * y + c2 * z * z + d2 + 2.0 * (ab * x * y + ac * x * z + bc * y * z + ad * x + bd * y + cd * z);
+		return MAX(e, 0.0) / weight;
+	}
+
+	Quadric() {
+		a2 = b2 = c2 = d2 = 0.0;
+		ab = ac = ad = bc = bd = cd = 0.0;
+		weight = 0.0;
+	}
+};
+
+struct Collapse {
+
+	int from;
+	int to;
+	double error;
+
+	bool operator<(const Collapse &p_other) const {
+		return error < p_other.error;
+	}
+};
+
+struct PositionHasher {
+
+	static _FORCE_INLINE_ uint32_t hash(const Vector3 &p_pos) {
+		uint32_t h = hash_djb2_one_float(p_pos.x);
+		h = hash_djb2_one_float(p_pos.y, h);
+		return hash_djb2_one_float(p_pos.z, h);
+	}
+};
+
+} // namespace
+
+Vector<int> MeshSimplifier::simplify(const Vector<Vector3> &p_vertices, const Vector<int> &p_indices, int p_target_index_count, float p_target_error, float *r_error) {
+
+	if (r_error) {
+		*r_error = 0.0;
+	}
+
+	ERR_FAIL_COND_V(p_indices.size() % 3 != 0, p_indices);
+
+	int vertex_count = p_vertices.size();
+	const Vector3 *vertices = p_vertices.ptr();
+
+	LocalVector<int> indices;
+	indices.resize(p_indices.size());
+	for (int i = 0; i < p_indices.size(); i++) {
+		ERR_FAIL_INDEX_V(p_indices[i], vertex_count, p_indices);
+		indices[i] = p_indices[i];
+	}
+
+	if ((int)indices.size() <= p_target_index_count) {
+		return p_indices;
+	}
+
+	/* FIND SHARED POSITIONS */
+
+	// vertices that only differ in their attributes (normals, uvs) share a position
+	LocalVector<int> position;
+	position.resize(vertex_count);
+
+	LocalVector<int> position_users;
+	position_users.resize(vertex_count);
+
+	{
+		HashMap<Vector3, int, PositionHasher> position_map;
+		for (int i = 0; i < vertex_count; i++) {
+
+			const int *existing = position_map.getptr(vertices[i]);
+			if (existing) {
+				position[i] = *existing;
+			} else {
+				position_map.set(vertices[i], i);
+				position[i] = i;
+			}
+			position_users[i] = 0;
+		}
+
+		for (int i = 0; i < vertex_count; i++) {
+			position_users[position[i]]++;
+		}
+	}
+
+	/* LOCK SEAMS AND BORDERS */
+
+	LocalVector<bool> locked;
+	locked.resize(vertex_count);
+
+	{
+		LocalVector<bool> position_locked;
+		position_locked.resize(vertex_count);
+		for (int i = 0; i < vertex_count; i++) {
+			position_locked[i] = position_users[position[i]] > 1;
+		}
+
+		// edges used by a single triangle are open borders, more than two is non manifold
+		HashMap<uint64_t, int> edge_users;
+		for (uint32_t i = 0; i < indices.size(); i += 3) {
+			for (int j = 0; j < 3; j++) {
+
+				uint32_t a = position[indices[i + j]];
+				uint32_t b = position[indices[i + (j + 1) % 3]];
+				if (a == b) {
+					continue;
+				}
+				if (a > b) {
+					SWAP(a, b);
+				}
+
+				uint64_t key = (uint64_t(a) << 32) | b;
+				int *users = edge_users.getptr(key);
+				if (users) {
+					(*users)++;
+				} else {
+					edge_users.set(key, 1);
+				}
+			}
+		}
+
+		const uint64_t *k = NULL;
+		while ((k = edge_users.next(k))) {
+			if (edge_users[*k] != 2) {
+				position_locked[*k >> 32] = true;
+				position_locked[*k & 0xFFFFFFFF] = true;
+			}
+		}
+
+		for (int i = 0; i < vertex_count; i++) {
+			locked[i] = position_locked[position[i]];
+		}
+	}
+
+	/* BUILD QUADRICS */
+
+	LocalVector<Quadric> quadrics;
+	quadrics.resize(vertex_count);
+
+	for (uint32_t i = 0; i < indices.size(); i += 3) {
+
+		const Vector3 &p0 = vertices[indices[i + 0]];
+		const Vector3 &p1 = vertices[indices[i + 1]];
+		const Vector3 &p2 = vertices[indices[i + 2]];
+
+		Vector3 normal = (p1 - p0).cross(p2 - p0);
+		real_t area = normal.length();
+		if (area <= CMP_EPSILON2) {
+			continue;
+		}
+		normal /= area;
+
+		for (int j = 0; j < 3; j++) {
+			quadrics[indices[i + j]].add_plane(normal, -normal.dot(p0), area * 0.5);
+		}
+	}
+
+	/* COLLAPSE */
+
+	double error_limit = double(p_target_error) * double(p_target_error);
+	double max_error = 0.0;
+
+	LocalVector<int> adjacency_offsets;
+	LocalVector<int> adjacency;
+	LocalVector<Collapse> collapses;
+	LocalVector<bool> touched;
+	LocalVector<bool> removed;
+	touched.resize(vertex_count);
+
+	// every pass collapses as many independent vertices as it can, then starts over
+	// with fresh adjacency, until the target or the error limit is reached
+	while ((int)indices.size() > p_target_index_count) {
+
+		int triangle_count = indices.size() / 3;
+
+		adjacency_offsets.resize(vertex_count + 1);
+		for (int i = 0; i <= vertex_count; i++) {
+			adjacency_offsets[i] = 0;
+		}
+		for (uint32_t i = 0; i < indices.size(); i++) {
+			adjacency_offsets[indices[i] + 1]++;
+		}
+		for (int i = 0; i < vertex_count; i++) {
+			adjacency_offsets[i + 1] += adjacency_offsets[i];
+		}
+		adjacency.resize(indices.size());
+		{
+			LocalVector<int> fill;
+			fill.resize(vertex_count);
+			for (int i = 0; i < vertex_count; i++) {
+				fill[i] = adjacency_offsets[i];
+			}
+			for (uint32_t i = 0; i < indices.size(); i++) {
+				adjacency[fill[indices[i]]++] = i / 3;
+			}
+		}
+
+		collapses.clear();
+		for (uint32_t i = 0; i < indices.size(); i += 3) {
+			for (int j = 0; j < 3; j++) {
+
+				int a = indices[i + j];
+				int b = indices[i + (j + 1) % 3];
+
+				// shared edges show up once in each direction, only look at one of them
+				if (a > b && adjacency_offsets[b] != adjacency_offsets[b + 1]) {
+					bool shared = false;
+					for (int k = adjacency_offsets[a]; k < adjacency_offsets[a + 1]; k++) {
+						const int *tri = &indices[adjacency[k] * 3];
+						if ((tri[0] == b && tri[2] == a) || (tri[1] == b && tri[0] == a) || (tri[2] == b && tri[1] == a)) {
+							shared = true;
+							break;
+						}
+					}
+					if (shared) {
+						continue;
+					}
+				}
+
+				// pick the cheaper direction
+				Collapse c;
+				c.from = -1;
+				c.error = 0.0;
+
+				if (!locked[a]) {
+					c.from = a;
+					c.to = b;
+					c.error = quadrics[a].error(vertices[b]);
+				}
+				if (!locked[b]) {
+					double error = quadrics[b].error(vertices[a]);
+					if (c.from == -1 || error < c.error) {
+						c.from = b;
+						c.to = a;
+						c.error = error;
+					}
+				}
+
+				if (c.from != -1) {
+					collapses.push_back(c);
+				}
+			}
+		}
+
+		if (collapses.size() == 0) {
+			break;
+		}
+
+		SortArray<Collapse> sorter;
+		sorter.sort(collapses.ptr(), collapses.size());
+
+		// each collapse removes about two triangles, but many are skipped because their
+		// neighbors already collapsed this pass, so allow a bit more than the error of
+		// the last collapse needed to reach the target
+		double pass_error_limit = error_limit;
+		uint32_t collapse_goal = (indices.size() - MAX(p_target_index_count, 0)) / 6;
+		if (collapse_goal < collapses.size()) {
+			pass_error_limit = MIN(pass_error_limit, collapses[collapse_goal].error * 1.5);
+		}
+
+		for (int i = 0; i < vertex_count; i++) {
+			touched[i] = false;
+		}
+		removed.resize(triangle_count);
+		for (int i = 0; i < triangle_count; i++) {
+			removed[i] = false;
+		}
+
+		int collapsed = 0;
+		int remaining = triangle_count;
+
+		for (uint32_t i = 0; i < collapses.size(); i++) {
+
+			const Collapse &c = collapses[i];
+
+			if (c.error > pass_error_limit || remaining * 3 <= p_target_index_count) {
+				break;
+			}
+
+			if (touched[c.from] || touched[c.to]) {
+				continue;
+			}
+
+			// the collapse must not flip any triangle that survives it
+			bool flips = false;
+			int degenerate = 0;
+
+			for (int j = adjacency_offsets[c.from]; j < adjacency_offsets[c.from + 1]; j++) {
+
+				const int *tri = &indices[adjacency[j] * 3];
+				if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) {
+					degenerate++;
+					continue;
+				}
+
+				Vector3 p[3] = { vertices[tri[0]], vertices[tri[1]], vertices[tri[2]] };
+				Vector3 normal = (p[1] - p[0]).cross(p[2] - p[0]);
+
+				for (int k = 0; k < 3; k++) {
+					if (tri[k] == c.from) {
+						p[k] = vertices[c.to];
+					}
+				}
+				Vector3 new_normal = (p[1] - p[0]).cross(p[2] - p[0]);
+
+				// also refuse to fold triangles over steeply, later collapses could flip them
+				if (normal.dot(new_normal) <= 0.25 * normal.length() * new_normal.length()) {
+					flips = true;
+					break;
+				}
+			}
+
+			if (flips) {
+				continue;
+			}
+
+			for (int j = adjacency_offsets[c.from]; j < adjacency_offsets[c.from + 1]; j++) {
+
+				int t = adjacency[j];
+				int *tri = &indices[t * 3];
+				for (int k = 0; k < 3; k++) {
+					touched[tri[k]] = true;
+					if (tri[k] == c.from) {
+						tri[k] = c.to;
+					}
+				}
+
+				if (position[tri[0]] == position[tri[1]] || position[tri[1]] == position[tri[2]] || position[tri[2]] == position[tri[0]]) {
+					removed[t] = true;
+				}
+			}
+
+			quadrics[c.to].add(quadrics[c.from]);
+			max_error = MAX(max_error, c.error);
+
+			remaining -= degenerate;
+			collapsed++;
+		}
+
+		if (collapsed == 0) {
+			break;
+		}
+
+		uint32_t write = 0;
+		for (int i = 0; i < triangle_count; i++) {
+			if (removed[i]) {
+				continue;
+			}
+			indices[write++] = indices[i * 3 + 0];
+			indices[write++] = indices[i * 3 + 1];
+			indices[write++] = indices[i * 3 + 2];
+		}
+		indices.resize(write);
+	}
+
+	if (r_error) {
+		*r_error = Math::sqrt(max_error);
+	}
+
+	Vector<int> result;
+	result.resize(indices.size());
+	for (uint32_t i = 0; i < indices.size(); i++) {
+		result.write[i] = indices[i];
+	}
+
+	return result;
+}
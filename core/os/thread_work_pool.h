@@ -0,0 +1,127 @@
+/*************************************************************************/
+/*  thread_work_pool.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef THREAD_WORK_POOL_H
+#define THREAD_WORK_POOL_H
+
+#include "core/os/memory.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/safe_refcount.h"
+
+// Persistent set of worker threads for splitting per-frame work into
+// independent elements. Unlike thread_process_array(), the threads are created
+// once in init() and reused by every do_work() call, so it can be used on hot
+// paths. The calling thread takes part in the work and do_work() only returns
+// once every element has been processed. do_work() is not reentrant.
+
+class ThreadWorkPool {
+
+	struct BaseWork {
+		SafeNumeric<uint32_t> *index;
+		uint32_t max_elements;
+
+		virtual void work() = 0;
+		virtual ~BaseWork() {}
+	};
+
+	template <class C, class M, class U>
+	struct Work : public BaseWork {
+		C *instance;
+		M method;
+		U userdata;
+
+		virtual void work() {
+			while (true) {
+				uint32_t work_index = BaseWork::index->postincrement();
+				if (work_index >= BaseWork::max_elements) {
+					break;
+				}
+				(instance->*method)(work_index, userdata);
+			}
+		}
+	};
+
+	struct ThreadData {
+		Thread thread;
+		Semaphore start;
+		Semaphore completed;
+		SafeFlag exit;
+		BaseWork *work;
+
+		ThreadData() { work = nullptr; }
+	};
+
+	SafeNumeric<uint32_t> index;
+	ThreadData *threads;
+	uint32_t thread_count;
+
+	static void _thread_function(void *p_user);
+
+public:
+	template <class C, class M, class U>
+	void do_work(uint32_t p_elements, C *p_instance, M p_method, U p_userdata) {
+
+		Work<C, M, U> w;
+		w.index = &index;
+		w.max_elements = p_elements;
+		w.instance = p_instance;
+		w.method = p_method;
+		w.userdata = p_userdata;
+
+		index.set(0);
+
+		// Don't wake up more threads than there are elements left for them.
+		uint32_t used_threads = MIN(thread_count, p_elements > 0 ? p_elements - 1 : 0);
+		for (uint32_t i = 0; i < used_threads; i++) {
+			threads[i].work = &w;
+			threads[i].start.post();
+		}
+
+		w.work();
+
+		for (uint32_t i = 0; i < used_threads; i++) {
+			threads[i].completed.wait();
+			threads[i].work = nullptr;
+		}
+	}
+
+	_FORCE_INLINE_ uint32_t get_thread_count() const { return thread_count; }
+
+	// Pass -1 to use one thread less than the processor count, as the caller
+	// takes part in the work too.
+	void init(int p_thread_count = -1);
+	void finish();
+
+	ThreadWorkPool();
+	~ThreadWorkPool();
+};
+
+#endif // THREAD_WORK_POOL_H
@@ -0,0 +1,144 @@
+/*************************************************************************/
+/*  radix_sort.h                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include "core/local_vector.h"
+#include "core/typedefs.h"
+
+// Stable LSD radix sort by 64-bit keys, eight bits per pass.
+// Keys are read once per element into a packed key+value array, instead of
+// once per comparison as with SortArray, and passes over bytes that are the
+// same for all keys are skipped. Sorting by a wider key can be done by sorting
+// by the least significant part first, as each sort is stable.
+// The scratch arrays are kept between calls, so keep the sorter around.
+
+template <class T>
+class RadixSort {
+
+	enum {
+		INSERTION_SORT_THRESHOLD = 32,
+	};
+
+	struct Pair {
+		uint64_t key;
+		T value;
+	};
+
+	LocalVector<Pair, uint32_t, true> pairs;
+	LocalVector<Pair, uint32_t, true> scratch;
+
+	static void _insertion_sort(Pair *p_pairs, uint32_t p_count) {
+		for (uint32_t i = 1; i < p_count; i++) {
+			Pair pair = p_pairs[i];
+			uint32_t j = i;
+			while (j > 0 && pair.key < p_pairs[j - 1].key) {
+				p_pairs[j] = p_pairs[j - 1];
+				j--;
+			}
+			p_pairs[j] = pair;
+		}
+	}
+
+public:
+	// Orders floats the same way as their unsigned integer keys.
+	static _FORCE_INLINE_ uint32_t float_to_key(float p_value) {
+		union {
+			float f;
+			uint32_t u;
+		} c;
+		c.f = p_value;
+		return (c.u & 0x80000000) ? ~c.u : (c.u | 0x80000000);
+	}
+
+	template <class KeyGetter>
+	void sort(T *p_array, uint32_t p_count, const KeyGetter &p_get_key) {
+
+		if (p_count < 2) {
+			return;
+		}
+
+		if (pairs.size() < p_count) {
+			pairs.resize(p_count);
+			scratch.resize(p_count);
+		}
+
+		Pair *src = pairs.ptr();
+		Pair *dst = scratch.ptr();
+
+		for (uint32_t i = 0; i < p_count; i++) {
+			src[i].key = p_get_key(p_array[i]);
+			src[i].value = p_array[i];
+		}
+
+		if (p_count <= INSERTION_SORT_THRESHOLD) {
+			_insertion_sort(src, p_count);
+		} else {
+			// Histograms for all eight passes are built in a single read.
+			uint32_t counts[8][256];
+			zeromem(counts, sizeof(counts));
+			for (uint32_t i = 0; i < p_count; i++) {
+				uint64_t key = src[i].key;
+				for (int b = 0; b < 8; b++) {
+					counts[b][(key >> (b * 8)) & 0xFF]++;
+				}
+			}
+
+			for (int b = 0; b < 8; b++) {
+				const uint32_t shift = b * 8;
+				uint32_t *count = counts[b];
+
+				if (count[(src[0].key >> shift) & 0xFF] == p_count) {
+					continue; // All keys share this byte.
+				}
+
+				uint32_t offset = 0;
+				for (int i = 0; i < 256; i++) {
+					uint32_t c = count[i];
+					count[i] = offset;
+					offset += c;
+				}
+
+				for (uint32_t i = 0; i < p_count; i++) {
+					dst[count[(src[i].key >> shift) & 0xFF]++] = src[i];
+				}
+
+				SWAP(src, dst);
+			}
+		}
+
+		for (uint32_t i = 0; i < p_count; i++) {
+			p_array[i] = src[i].value;
+		}
+	}
+};
+
+#endif // RADIX_SORT_H
@@ -463,6 +463,142 @@ void ResourceCache::clear() {
 void ResourceCache::reload_externals() {
 }
 
+Mutex ResourceCache::soft_mutex;
+List<ResourceCache::SoftEntry> ResourceCache::soft_lru;
+HashMap<ObjectID, List<ResourceCache::SoftEntry>::Element *> ResourceCache::soft_map;
+uint64_t ResourceCache::soft_budget = 0;
+uint64_t ResourceCache::soft_retained_bytes = 0;
+
+void ResourceCache::_soft_trim(List<Ref<Resource> > &r_evicted) {
+
+	// only resources nothing else references count against the budget, the
+	// others would stay in memory even if they were evicted. They are a part
+	// of the retained ones, so there is nothing to do while those fit.
+	if (soft_retained_bytes <= soft_budget) {
+		return;
+	}
+
+	uint64_t unreferenced = 0;
+	for (List<SoftEntry>::Element *E = soft_lru.front(); E; E = E->next()) {
+		if (E->get().resource->reference_get_count() == 1) {
+			unreferenced += E->get().size;
+		}
+	}
+
+	List<SoftEntry>::Element *E = soft_lru.back();
+	while (E && unreferenced > soft_budget) {
+		List<SoftEntry>::Element *prev = E->prev();
+		if (E->get().resource->reference_get_count() == 1) {
+			unreferenced -= E->get().size;
+			soft_retained_bytes -= E->get().size;
+			soft_map.erase(E->get().resource->get_instance_id());
+			r_evicted.push_back(E->get().resource); //freed by the caller, outside of the lock
+			soft_lru.erase(E);
+		}
+		E = prev;
+	}
+}
+
+void ResourceCache::_soft_clear(List<Ref<Resource> > &r_evicted) {
+
+	for (List<SoftEntry>::Element *E = soft_lru.front(); E; E = E->next()) {
+		r_evicted.push_back(E->get().resource);
+	}
+	soft_lru.clear();
+	soft_map.clear();
+	soft_retained_bytes = 0;
+}
+
+void ResourceCache::soft_retain(const Ref<Resource> &p_resource) {
+
+	if (soft_budget == 0 || p_resource.is_null()) {
+		return;
+	}
+
+	{
+		MutexLock lock(soft_mutex);
+
+		List<SoftEntry>::Element **E = soft_map.getptr(p_resource->get_instance_id());
+		if (E) {
+			soft_lru.move_to_front(*E);
+			return;
+		}
+	}
+
+	// measured once, outside of the lock, the resource was usually just loaded
+	uint64_t size = p_resource->get_memory_usage();
+	if (size == 0) {
+		return;
+	}
+
+	List<Ref<Resource> > evicted;
+	{
+		MutexLock lock(soft_mutex);
+
+		List<SoftEntry>::Element **E = soft_map.getptr(p_resource->get_instance_id());
+		if (E) {
+			soft_lru.move_to_front(*E); //retained by another thread in the meantime
+			return;
+		}
+
+		SoftEntry entry;
+		entry.resource = p_resource;
+		entry.size = size;
+		soft_map[p_resource->get_instance_id()] = soft_lru.push_front(entry);
+		soft_retained_bytes += size;
+
+		_soft_trim(evicted);
+	}
+}
+
+void ResourceCache::set_soft_budget(uint64_t p_bytes) {
+
+	List<Ref<Resource> > evicted;
+	{
+		MutexLock lock(soft_mutex);
+		soft_budget = p_bytes;
+		if (soft_budget == 0) {
+			//disabled, let go of everything still retained
+			_soft_clear(evicted);
+		} else {
+			_soft_trim(evicted);
+		}
+	}
+}
+
+uint64_t ResourceCache::get_soft_budget() {
+
+	return soft_budget;
+}
+
+void ResourceCache::clear_soft_cache() {
+
+	List<Ref<Resource> > evicted;
+	{
+		MutexLock lock(soft_mutex);
+		_soft_clear(evicted);
+	}
+}
+
+int ResourceCache::get_soft_cached_count() {
+
+	MutexLock lock(soft_mutex);
+	return soft_lru.size();
+}
+
+uint64_t ResourceCache::get_soft_cached_bytes() {
+
+	// references change outside of the cache, so this is counted when asked
+	MutexLock lock(soft_mutex);
+	uint64_t unreferenced = 0;
+	for (List<SoftEntry>::Element *E = soft_lru.front(); E; E = E->next()) {
+		if (E->get().resource->reference_get_count() == 1) {
+			unreferenced += E->get().size;
+		}
+	}
+	return unreferenced;
+}
+
 bool ResourceCache::has(const String &p_path) {
 
 	lock.read_lock();
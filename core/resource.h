@@ -33,6 +33,7 @@
 
 #include "core/class_db.h"
 #include "core/object.h"
+#include "core/os/mutex.h"
 #include "core/ref_ptr.h"
 #include "core/reference.h"
 #include "core/safe_refcount.h"
@@ -132,6 +133,7 @@ public:
 	bool is_translation_remapped() const;
 
 	virtual RID get_rid() const; // some resources may offer conversion to RID
+	virtual uint64_t get_memory_usage() const { return 0; } // approximate bytes held, used by the resource soft cache
 
 #ifdef TOOLS_ENABLED
 	//helps keep IDs same number when loading/saving scenes. -1 clears ID and it Returns -1 when no id stored
@@ -158,6 +160,22 @@ class ResourceCache {
 	static void clear();
 	friend void register_core_types();
 
+	// Soft cache: recently loaded resources are kept referenced, so they survive
+	// while nothing else uses them, until their size exceeds the budget.
+	struct SoftEntry {
+		Ref<Resource> resource;
+		uint64_t size; // get_memory_usage() when the resource was retained
+	};
+
+	static Mutex soft_mutex;
+	static List<SoftEntry> soft_lru; // most recently used first
+	static HashMap<ObjectID, List<SoftEntry>::Element *> soft_map;
+	static uint64_t soft_budget;
+	static uint64_t soft_retained_bytes; // referenced or not
+
+	static void _soft_trim(List<Ref<Resource> > &r_evicted);
+	static void _soft_clear(List<Ref<Resource> > &r_evicted);
+
 public:
 	static void reload_externals();
 	static bool has(const String &p_path);
@@ -165,6 +183,13 @@ public:
 	static void dump(const char *p_file = NULL, bool p_short = false);
 	static void get_cached_resources(List<Ref<Resource> > *p_resources);
 	static int get_cached_resource_count();
+
+	static void soft_retain(const Ref<Resource> &p_resource);
+	static void set_soft_budget(uint64_t p_bytes);
+	static uint64_t get_soft_budget();
+	static void clear_soft_cache();
+	static int get_soft_cached_count();
+	static uint64_t get_soft_cached_bytes();
 };
 
 #endif
@@ -37,8 +37,27 @@
 #include "servers/visual/rasterizer.h"
 #include "servers/visual_server.h"
 
+// What would have been drawn, so the server side of rendering can be profiled without a GPU.
+struct RasterizerDummyRenderInfo {
+	uint64_t object_count;
+	uint64_t draw_call_count;
+	uint64_t _2d_item_count;
+	uint64_t _2d_draw_call_count;
+
+	void reset() {
+		object_count = 0;
+		draw_call_count = 0;
+		_2d_item_count = 0;
+		_2d_draw_call_count = 0;
+	}
+
+	RasterizerDummyRenderInfo() { reset(); }
+};
+
 class RasterizerSceneDummy : public RasterizerScene {
 public:
+	RasterizerDummyRenderInfo *info;
+
 	/* SHADOW ATLAS API */
 
 	RID shadow_atlas_create() { return RID(); }
@@ -106,15 +125,23 @@ public:
 	void gi_probe_instance_set_transform_to_data(RID p_probe, const Transform &p_xform) {}
 	void gi_probe_instance_set_bounds(RID p_probe, const Vector3 &p_bounds) {}
 
-	void render_scene(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_ortogonal, InstanceBase **p_cull_result, int p_cull_count, RID *p_light_cull_result, int p_light_cull_count, RID *p_reflection_probe_cull_result, int p_reflection_probe_cull_count, RID p_environment, RID p_shadow_atlas, RID p_reflection_atlas, RID p_reflection_probe, int p_reflection_probe_pass) {}
-	void render_shadow(RID p_light, RID p_shadow_atlas, int p_pass, InstanceBase **p_cull_result, int p_cull_count) {}
+	void render_scene(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_ortogonal, InstanceBase **p_cull_result, int p_cull_count, RID *p_light_cull_result, int p_light_cull_count, RID *p_reflection_probe_cull_result, int p_reflection_probe_cull_count, RID p_environment, RID p_shadow_atlas, RID p_reflection_atlas, RID p_reflection_probe, int p_reflection_probe_pass) {
+		info->object_count += p_cull_count;
+		for (int i = 0; i < p_cull_count; i++) {
+			// one draw per surface, materials are sized to the surface count
+			info->draw_call_count += MAX(p_cull_result[i]->materials.size(), 1);
+		}
+	}
+	void render_shadow(RID p_light, RID p_shadow_atlas, int p_pass, InstanceBase **p_cull_result, int p_cull_count) {
+		info->draw_call_count += p_cull_count;
+	}
 
 	void set_scene_pass(uint64_t p_pass) {}
 	void set_debug_draw_mode(VS::ViewportDebugDraw p_debug_draw) {}
 
 	bool free(RID p_rid) { return true; }
 
-	RasterizerSceneDummy() {}
+	RasterizerSceneDummy() { info = NULL; }
 	~RasterizerSceneDummy() {}
 };
 
@@ -148,8 +175,16 @@ public:
 		VS::BlendShapeMode blend_shape_mode;
 	};
 
+	struct DummyLight : public RID_Data {
+		VS::LightType type;
+		float param[VS::LIGHT_PARAM_MAX];
+	};
+
 	mutable RID_Owner<DummyTexture> texture_owner;
 	mutable RID_Owner<DummyMesh> mesh_owner;
+	mutable RID_Owner<DummyLight> light_owner;
+
+	RasterizerDummyRenderInfo info_final; // previous frame, as reported by get_render_info()
 
 	RID texture_create() {
 
@@ -400,6 +435,8 @@ public:
 		return m->surfaces[p_surface].bone_aabbs;
 	}
 
+	void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<float> &p_errors, const Vector<PoolVector<uint8_t> > &p_index_arrays) {}
+
 	void mesh_remove_surface(RID p_mesh, int p_index) {
 		DummyMesh *m = mesh_owner.getornull(p_mesh);
 		ERR_FAIL_COND(!m);
@@ -416,7 +453,19 @@ public:
 	void mesh_set_custom_aabb(RID p_mesh, const AABB &p_aabb) {}
 	AABB mesh_get_custom_aabb(RID p_mesh) const { return AABB(); }
 
-	AABB mesh_get_aabb(RID p_mesh, RID p_skeleton) const { return AABB(); }
+	AABB mesh_get_aabb(RID p_mesh, RID p_skeleton) const {
+		const DummyMesh *m = mesh_owner.getornull(p_mesh);
+		ERR_FAIL_COND_V(!m, AABB());
+		AABB aabb;
+		for (int i = 0; i < m->surfaces.size(); i++) {
+			if (i == 0) {
+				aabb = m->surfaces[i].aabb;
+			} else {
+				aabb.merge_with(m->surfaces[i].aabb);
+			}
+		}
+		return aabb;
+	}
 	void mesh_clear(RID p_mesh) {}
 
 	/* MULTIMESH API */
@@ -471,19 +520,36 @@ public:
 	int skeleton_get_bone_count(RID p_skeleton) const { return 0; }
 	void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform) {}
 	Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const { return Transform(); }
+	void skeleton_set_bone_transforms(RID p_skeleton, const Vector<Transform> &p_transforms) {}
 	void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) {}
 	Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const { return Transform2D(); }
 
 	/* Light API */
 
-	RID light_create(VS::LightType p_type) { return RID(); }
+	RID light_create(VS::LightType p_type) {
+		// kept so that lights are culled like with a real driver
+		DummyLight *light = memnew(DummyLight);
+		light->type = p_type;
+		for (int i = 0; i < VS::LIGHT_PARAM_MAX; i++) {
+			light->param[i] = 0;
+		}
+		light->param[VS::LIGHT_PARAM_ENERGY] = 1.0;
+		light->param[VS::LIGHT_PARAM_RANGE] = 1.0;
+		light->param[VS::LIGHT_PARAM_SPOT_ANGLE] = 45;
+		return light_owner.make_rid(light);
+	}
 
 	RID directional_light_create() { return light_create(VS::LIGHT_DIRECTIONAL); }
 	RID omni_light_create() { return light_create(VS::LIGHT_OMNI); }
 	RID spot_light_create() { return light_create(VS::LIGHT_SPOT); }
 
 	void light_set_color(RID p_light, const Color &p_color) {}
-	void light_set_param(RID p_light, VS::LightParam p_param, float p_value) {}
+	void light_set_param(RID p_light, VS::LightParam p_param, float p_value) {
+		DummyLight *light = light_owner.getornull(p_light);
+		ERR_FAIL_COND(!light);
+		ERR_FAIL_INDEX(p_param, VS::LIGHT_PARAM_MAX);
+		light->param[p_param] = p_value;
+	}
 	void light_set_shadow(RID p_light, bool p_enabled) {}
 	void light_set_shadow_color(RID p_light, const Color &p_color) {}
 	void light_set_projector(RID p_light, RID p_texture) {}
@@ -507,9 +573,35 @@ public:
 
 	bool light_has_shadow(RID p_light) const { return false; }
 
-	VS::LightType light_get_type(RID p_light) const { return VS::LIGHT_OMNI; }
-	AABB light_get_aabb(RID p_light) const { return AABB(); }
-	float light_get_param(RID p_light, VS::LightParam p_param) { return 0.0; }
+	VS::LightType light_get_type(RID p_light) const {
+		const DummyLight *light = light_owner.getornull(p_light);
+		ERR_FAIL_COND_V(!light, VS::LIGHT_OMNI);
+		return light->type;
+	}
+	AABB light_get_aabb(RID p_light) const {
+		const DummyLight *light = light_owner.getornull(p_light);
+		ERR_FAIL_COND_V(!light, AABB());
+		switch (light->type) {
+			case VS::LIGHT_SPOT: {
+				float len = light->param[VS::LIGHT_PARAM_RANGE];
+				float size = Math::tan(Math::deg2rad(light->param[VS::LIGHT_PARAM_SPOT_ANGLE])) * len;
+				return AABB(Vector3(-size, -size, -len), Vector3(size * 2, size * 2, len));
+			}
+			case VS::LIGHT_OMNI: {
+				float r = light->param[VS::LIGHT_PARAM_RANGE];
+				return AABB(-Vector3(r, r, r), Vector3(r, r, r) * 2);
+			}
+			default: {
+				return AABB();
+			}
+		}
+	}
+	float light_get_param(RID p_light, VS::LightParam p_param) {
+		const DummyLight *light = light_owner.getornull(p_light);
+		ERR_FAIL_COND_V(!light, 0.0);
+		ERR_FAIL_INDEX_V(p_param, VS::LIGHT_PARAM_MAX, 0.0);
+		return light->param[p_param];
+	}
 	Color light_get_color(RID p_light) { return Color(); }
 	bool light_get_use_gi(RID p_light) { return false; }
 	VS::LightBakeMode light_get_bake_mode(RID p_light) { return VS::LightBakeMode::LIGHT_BAKE_DISABLED; }
@@ -726,6 +818,8 @@ public:
 	VS::InstanceType get_base_type(RID p_rid) const {
 		if (mesh_owner.owns(p_rid)) {
 			return VS::INSTANCE_MESH;
+		} else if (light_owner.owns(p_rid)) {
+			return VS::INSTANCE_LIGHT;
 		} else if (lightmap_capture_data_owner.owns(p_rid)) {
 			return VS::INSTANCE_LIGHTMAP_CAPTURE;
 		}
@@ -744,6 +838,11 @@ public:
 			DummyMesh *mesh = mesh_owner.getornull(p_rid);
 			mesh_owner.free(p_rid);
 			memdelete(mesh);
+		} else if (light_owner.owns(p_rid)) {
+			// delete the light
+			DummyLight *light = light_owner.getornull(p_rid);
+			light_owner.free(p_rid);
+			memdelete(light);
 		} else if (lightmap_capture_data_owner.owns(p_rid)) {
 			// delete the lightmap
 			LightmapCapture *lightmap_capture = lightmap_capture_data_owner.getornull(p_rid);
@@ -766,7 +865,20 @@ public:
 	void render_info_end_capture() {}
 	int get_captured_render_info(VS::RenderInfo p_info) { return 0; }
 
-	uint64_t get_render_info(VS::RenderInfo p_info) { return 0; }
+	uint64_t get_render_info(VS::RenderInfo p_info) {
+		switch (p_info) {
+			case VS::INFO_OBJECTS_IN_FRAME:
+				return info_final.object_count;
+			case VS::INFO_DRAW_CALLS_IN_FRAME:
+				return info_final.draw_call_count;
+			case VS::INFO_2D_ITEMS_IN_FRAME:
+				return info_final._2d_item_count;
+			case VS::INFO_2D_DRAW_CALLS_IN_FRAME:
+				return info_final._2d_draw_call_count;
+			default:
+				return 0;
+		}
+	}
 	String get_video_adapter_name() const { return String(); }
 	String get_video_adapter_vendor() const { return String(); }
 
@@ -778,6 +890,8 @@ public:
 
 class RasterizerCanvasDummy : public RasterizerCanvas {
 public:
+	RasterizerDummyRenderInfo *info;
+
 	RID light_internal_create() { return RID(); }
 	void light_internal_update(RID p_rid, Light *p_light) {}
 	void light_internal_free(RID p_rid) {}
@@ -785,7 +899,13 @@ public:
 	void canvas_begin(){};
 	void canvas_end(){};
 
-	void canvas_render_items(Item *p_item_list, int p_z, const Color &p_modulate, Light *p_light, const Transform2D &p_transform){};
+	void canvas_render_items(Item *p_item_list, int p_z, const Color &p_modulate, Light *p_light, const Transform2D &p_transform) {
+		while (p_item_list) {
+			info->_2d_item_count++;
+			info->_2d_draw_call_count += p_item_list->commands.size();
+			p_item_list = p_item_list->next;
+		}
+	};
 	void canvas_debug_viewport_shadows(Light *p_lights_with_shadow){};
 
 	void canvas_light_shadow_buffer_update(RID p_buffer, const Transform2D &p_light_xform, int p_light_mask, float p_near, float p_far, LightOccluderInstance *p_occluders, CameraMatrix *p_xform_cache) {}
@@ -794,7 +914,7 @@ public:
 
 	void draw_window_margins(int *p_margins, RID *p_margin_textures) {}
 
-	RasterizerCanvasDummy() {}
+	RasterizerCanvasDummy() { info = NULL; }
 	~RasterizerCanvasDummy() {}
 };
 
@@ -803,6 +923,7 @@ protected:
 	RasterizerCanvasDummy canvas;
 	RasterizerStorageDummy storage;
 	RasterizerSceneDummy scene;
+	RasterizerDummyRenderInfo info;
 
 public:
 	RasterizerStorage *get_storage() { return &storage; }
@@ -813,10 +934,14 @@ public:
 	void set_shader_time_scale(float p_scale) {}
 
 	void initialize() {}
-	void begin_frame(double frame_step) {}
+	void begin_frame(double frame_step) {
+		storage.info_final = info;
+		info.reset();
+	}
 	void set_current_render_target(RID p_render_target) {}
 	void restore_render_target(bool p_3d_was_drawn) {}
 	void clear_render_target(const Color &p_color) {}
+	void clear_render_target_rect(const Rect2 &p_rect, const Color &p_color) {}
 	void blit_render_target_to_screen(RID p_render_target, const Rect2 &p_screen_rect, int p_screen = 0) {}
 	void output_lens_distorted_to_screen(RID p_render_target, const Rect2 &p_screen_rect, float p_k1, float p_k2, const Vector2 &p_eye_center, float p_oversample) {}
 	void end_frame(bool p_swap_buffers) {}
@@ -838,7 +963,10 @@ public:
 
 	virtual const char *gl_check_for_error(bool p_print_error = true) { return nullptr; }
 
-	RasterizerDummy() {}
+	RasterizerDummy() {
+		canvas.info = &info;
+		scene.info = &info;
+	}
 	~RasterizerDummy() {}
 };
 
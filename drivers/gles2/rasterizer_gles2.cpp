@@ -264,6 +264,7 @@ void RasterizerGLES2::initialize() {
 #endif // CAN_DEBUG
 
 	print_line("OpenGL ES 2.0 Renderer: " + VisualServer::get_singleton()->get_video_adapter_name());
+	shader_cache = memnew(ShaderCacheGLES2);
 	storage->initialize();
 	canvas->initialize();
 	scene->initialize();
@@ -334,6 +335,15 @@ void RasterizerGLES2::clear_render_target(const Color &p_color) {
 
 	storage->frame.clear_request = true;
 	storage->frame.clear_request_color = p_color;
+	storage->frame.clear_request_rect = Rect2();
+}
+
+void RasterizerGLES2::clear_render_target_rect(const Rect2 &p_rect, const Color &p_color) {
+	ERR_FAIL_COND(!storage->frame.current_rt);
+
+	storage->frame.clear_request = true;
+	storage->frame.clear_request_color = p_color;
+	storage->frame.clear_request_rect = p_rect;
 }
 
 void RasterizerGLES2::set_boot_image(const Ref<Image> &p_image, const Color &p_color, bool p_scale, bool p_use_filter) {
@@ -529,6 +539,7 @@ RasterizerGLES2::RasterizerGLES2() {
 	storage->canvas = canvas;
 	scene->storage = storage;
 	storage->scene = scene;
+	shader_cache = NULL;
 
 	time_total = 0;
 	time_scale = 1;
@@ -538,4 +549,7 @@ RasterizerGLES2::~RasterizerGLES2() {
 
 	memdelete(storage);
 	memdelete(canvas);
+	if (shader_cache) {
+		memdelete(shader_cache);
+	}
 }
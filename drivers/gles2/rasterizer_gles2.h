@@ -34,6 +34,7 @@
 #include "rasterizer_canvas_gles2.h"
 #include "rasterizer_scene_gles2.h"
 #include "rasterizer_storage_gles2.h"
+#include "shader_cache_gles2.h"
 #include "servers/visual/rasterizer.h"
 
 class RasterizerGLES2 : public Rasterizer {
@@ -43,6 +44,7 @@ class RasterizerGLES2 : public Rasterizer {
 	RasterizerStorageGLES2 *storage;
 	RasterizerCanvasGLES2 *canvas;
 	RasterizerSceneGLES2 *scene;
+	ShaderCacheGLES2 *shader_cache;
 
 	double time_total;
 	float time_scale;
@@ -60,6 +62,7 @@ public:
 	virtual void set_current_render_target(RID p_render_target);
 	virtual void restore_render_target(bool p_3d_was_drawn);
 	virtual void clear_render_target(const Color &p_color);
+	virtual void clear_render_target_rect(const Rect2 &p_rect, const Color &p_color);
 	virtual void blit_render_target_to_screen(RID p_render_target, const Rect2 &p_screen_rect, int p_screen = 0);
 	virtual void output_lens_distorted_to_screen(RID p_render_target, const Rect2 &p_screen_rect, float p_k1, float p_k2, const Vector2 &p_eye_center, float p_oversample);
 	virtual void end_frame(bool p_swap_buffers);
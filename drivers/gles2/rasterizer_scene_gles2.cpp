@@ -1648,8 +1648,21 @@ void RasterizerSceneGLES2::_render_geometry(RenderList::Element *p_element) {
 			// drawing
 
 			if (s->index_array_len > 0) {
-				glDrawElements(gl_primitive[s->primitive], s->index_array_len, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, 0);
-				storage->info.render.vertices_count += s->index_array_len;
+				int index_array_len = s->index_array_len;
+
+				if (s->lods.size()) {
+					// the LOD is picked per instance, so the index buffer is bound here rather than in _setup_geometry
+					const RasterizerStorageGLES2::Surface::LOD *lod = s->get_lod(p_element->instance->lod_error);
+					if (lod) {
+						glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lod->index_id);
+						index_array_len = lod->index_array_len;
+					} else {
+						glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s->index_id);
+					}
+				}
+
+				glDrawElements(gl_primitive[s->primitive], index_array_len, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, 0);
+				storage->info.render.vertices_count += index_array_len;
 			} else {
 				glDrawArrays(gl_primitive[s->primitive], 0, s->array_len);
 				storage->info.render.vertices_count += s->array_len;
@@ -34,6 +34,8 @@
 /* Must come before shaders or the Windows build fails... */
 #include "rasterizer_storage_gles2.h"
 
+#include "core/radix_sort.h"
+
 #include "shaders/cube_to_dp.glsl.gen.h"
 #include "shaders/effect_blur.glsl.gen.h"
 #include "shaders/scene.glsl.gen.h"
@@ -632,61 +634,66 @@ public:
 
 		// sorts
 
+		// Sorted with a radix sort over keys packed next to the element pointers,
+		// so elements are only dereferenced once per sort.
+		RadixSort<Element *> sorter;
+
 		struct SortByKey {
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				if (A->depth_key == B->depth_key) {
-					return A->sort_key < B->sort_key;
-				} else {
-					return A->depth_key < B->depth_key;
-				}
+			_FORCE_INLINE_ uint64_t operator()(const Element *A) const {
+				return A->sort_key;
 			}
 		};
 
-		void sort_by_key(bool p_alpha) {
-			SortArray<Element *, SortByKey> sorter;
+		struct SortByDepthKey {
+			_FORCE_INLINE_ uint64_t operator()(const Element *A) const {
+				return A->depth_key;
+			}
+		};
 
+		void sort_by_key(bool p_alpha) {
+			// The key is depth_key followed by sort_key, too wide for one pass, so
+			// sort by the less significant part first and rely on stability.
 			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
+				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count, SortByKey());
+				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count, SortByDepthKey());
 			} else {
-				sorter.sort(elements, element_count);
+				sorter.sort(elements, element_count, SortByKey());
+				sorter.sort(elements, element_count, SortByDepthKey());
 			}
 		}
 
 		struct SortByDepth {
 
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				return A->instance->depth < B->instance->depth;
+			_FORCE_INLINE_ uint64_t operator()(const Element *A) const {
+				return RadixSort<Element *>::float_to_key(A->instance->depth);
 			}
 		};
 
 		void sort_by_depth(bool p_alpha) { //used for shadows
 
-			SortArray<Element *, SortByDepth> sorter;
 			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
+				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count, SortByDepth());
 			} else {
-				sorter.sort(elements, element_count);
+				sorter.sort(elements, element_count, SortByDepth());
 			}
 		}
 
 		struct SortByReverseDepthAndPriority {
 
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				if (A->priority == B->priority) {
-					return A->instance->depth > B->instance->depth;
-				} else {
-					return A->priority < B->priority;
-				}
+			_FORCE_INLINE_ uint64_t operator()(const Element *A) const {
+				// Priority is signed, bias it so it orders as unsigned.
+				uint64_t priority = uint32_t(A->priority + 32768);
+				uint32_t reverse_depth = ~RadixSort<Element *>::float_to_key(A->instance->depth);
+				return (priority << 32) | reverse_depth;
 			}
 		};
 
 		void sort_by_reverse_depth_and_priority(bool p_alpha) { //used for alpha
 
-			SortArray<Element *, SortByReverseDepthAndPriority> sorter;
 			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
+				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count, SortByReverseDepthAndPriority());
 			} else {
-				sorter.sort(elements, element_count);
+				sorter.sort(elements, element_count, SortByReverseDepthAndPriority());
 			}
 		}
 
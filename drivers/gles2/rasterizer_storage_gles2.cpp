@@ -2813,6 +2813,61 @@ Vector<AABB> RasterizerStorageGLES2::mesh_surface_get_skeleton_aabb(RID p_mesh,
 	return mesh->surfaces[p_surface]->skeleton_bone_aabb;
 }
 
+void RasterizerStorageGLES2::_mesh_surface_clear_lods(Surface *p_surface) {
+
+	for (int i = 0; i < p_surface->lods.size(); i++) {
+
+		const Surface::LOD &lod = p_surface->lods[i];
+		glDeleteBuffers(1, &lod.index_id);
+
+		p_surface->total_data_size -= lod.index_array_len * p_surface->attribs[VS::ARRAY_INDEX].stride;
+		info.vertex_mem -= lod.index_array_len * p_surface->attribs[VS::ARRAY_INDEX].stride;
+	}
+
+	p_surface->lods.clear();
+}
+
+void RasterizerStorageGLES2::mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<float> &p_errors, const Vector<PoolVector<uint8_t> > &p_index_arrays) {
+
+	Mesh *mesh = mesh_owner.getornull(p_mesh);
+	ERR_FAIL_COND(!mesh);
+	ERR_FAIL_INDEX(p_surface, mesh->surfaces.size());
+	ERR_FAIL_COND(p_errors.size() != p_index_arrays.size());
+
+	Surface *surface = mesh->surfaces[p_surface];
+
+	_mesh_surface_clear_lods(surface);
+
+	if (!surface->index_id) {
+		ERR_FAIL_COND_MSG(p_errors.size(), "Mesh LODs require an index array.");
+		return;
+	}
+
+	int index_stride = surface->attribs[VS::ARRAY_INDEX].stride;
+
+	for (int i = 0; i < p_errors.size(); i++) {
+
+		ERR_CONTINUE(p_index_arrays[i].size() == 0 || p_index_arrays[i].size() % index_stride != 0);
+		ERR_CONTINUE(i > 0 && p_errors[i] < p_errors[i - 1]);
+
+		Surface::LOD lod;
+		lod.error = p_errors[i];
+		lod.index_array_len = p_index_arrays[i].size() / index_stride;
+
+		PoolVector<uint8_t>::Read ir = p_index_arrays[i].read();
+
+		glGenBuffers(1, &lod.index_id);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lod.index_id);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, p_index_arrays[i].size(), ir.ptr(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); //unbind
+
+		surface->total_data_size += p_index_arrays[i].size();
+		info.vertex_mem += p_index_arrays[i].size();
+
+		surface->lods.push_back(lod);
+	}
+}
+
 void RasterizerStorageGLES2::mesh_remove_surface(RID p_mesh, int p_surface) {
 
 	Mesh *mesh = mesh_owner.getornull(p_mesh);
@@ -2834,6 +2889,8 @@ void RasterizerStorageGLES2::mesh_remove_surface(RID p_mesh, int p_surface) {
 		glDeleteBuffers(1, &surface->blend_shapes[i].vertex_id);
 	}
 
+	_mesh_surface_clear_lods(surface);
+
 	info.vertex_mem -= surface->total_data_size;
 
 	memdelete(surface);
@@ -3769,6 +3826,41 @@ Transform RasterizerStorageGLES2::skeleton_bone_get_transform(RID p_skeleton, in
 
 	return ret;
 }
+void RasterizerStorageGLES2::skeleton_set_bone_transforms(RID p_skeleton, const Vector<Transform> &p_transforms) {
+	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
+	ERR_FAIL_COND(!skeleton);
+
+	ERR_FAIL_COND(p_transforms.size() > skeleton->size);
+	ERR_FAIL_COND(skeleton->use_2d);
+
+	float *bone_data = skeleton->bone_data.ptrw();
+	const Transform *transforms = p_transforms.ptr();
+
+	for (int i = 0; i < p_transforms.size(); i++) {
+		const Transform &xform = transforms[i];
+		float *data = &bone_data[i * 4 * 3];
+
+		data[0] = xform.basis[0].x;
+		data[1] = xform.basis[0].y;
+		data[2] = xform.basis[0].z;
+		data[3] = xform.origin.x;
+
+		data[4] = xform.basis[1].x;
+		data[5] = xform.basis[1].y;
+		data[6] = xform.basis[1].z;
+		data[7] = xform.origin.y;
+
+		data[8] = xform.basis[2].x;
+		data[9] = xform.basis[2].y;
+		data[10] = xform.basis[2].z;
+		data[11] = xform.origin.z;
+	}
+
+	if (!skeleton->update_list.in_list()) {
+		skeleton_update_list.add(&skeleton->update_list);
+	}
+}
+
 void RasterizerStorageGLES2::skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) {
 	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
 	ERR_FAIL_COND(!skeleton);
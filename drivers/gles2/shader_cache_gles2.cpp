@@ -0,0 +1,333 @@
+/*************************************************************************/
+/*  shader_cache_gles2.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "shader_cache_gles2.h"
+
+#include "core/crypto/crypto_core.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/project_settings.h"
+
+#ifdef ANDROID_ENABLED
+#include <EGL/egl.h>
+#endif
+
+#define _GL_PROGRAM_BINARY_LENGTH 0x8741
+#define _GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+
+static const uint8_t entry_magic[4] = { 'G', 'S', 'C', 'E' };
+
+ShaderCacheGLES2 *ShaderCacheGLES2::singleton = NULL;
+
+String ShaderCacheGLES2::hash_program(const String &p_name, const Vector<const char *> &p_vertex_strings, const Vector<const char *> &p_fragment_strings) const {
+
+	CryptoCore::SHA256Context ctx;
+	ctx.start();
+
+	CharString name = p_name.utf8();
+	ctx.update((const uint8_t *)name.get_data(), name.length());
+	CharString driver = driver_info.utf8();
+	ctx.update((const uint8_t *)driver.get_data(), driver.length());
+
+	// The stages are separated by a byte that can't appear in shader code.
+	static const uint8_t separator = 0;
+
+	for (int i = 0; i < p_vertex_strings.size(); i++) {
+		ctx.update((const uint8_t *)p_vertex_strings[i], strlen(p_vertex_strings[i]));
+	}
+	ctx.update(&separator, 1);
+	for (int i = 0; i < p_fragment_strings.size(); i++) {
+		ctx.update((const uint8_t *)p_fragment_strings[i], strlen(p_fragment_strings[i]));
+	}
+
+	unsigned char hash[32];
+	ctx.finish(hash);
+	return String::hex_encode_buffer(hash, 32);
+}
+
+bool ShaderCacheGLES2::_read_entry(const String &p_path, uint32_t &r_format, Vector<uint8_t> &r_data) {
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	if (!f) {
+		return false;
+	}
+
+	bool valid = false;
+
+	uint8_t magic[4];
+	if (f->get_buffer(magic, 4) == 4 && memcmp(magic, entry_magic, 4) == 0 && f->get_32() == CACHE_FORMAT_VERSION) {
+
+		r_format = f->get_32();
+		uint32_t length = f->get_32();
+		uint8_t checksum[32];
+		f->get_buffer(checksum, 32);
+
+		// A truncated or padded file is treated as corrupt.
+		if (length > 0 && f->get_position() + length == f->get_len()) {
+
+			r_data.resize(length);
+			if (f->get_buffer(r_data.ptrw(), length) == length) {
+
+				unsigned char hash[32];
+				CryptoCore::sha256(r_data.ptr(), length, hash);
+				valid = memcmp(hash, checksum, 32) == 0;
+			}
+		}
+	}
+
+	memdelete(f);
+
+	if (!valid) {
+		_remove_entry(p_path);
+	}
+
+	return valid;
+}
+
+bool ShaderCacheGLES2::_write_entry(const String &p_path, uint32_t p_format, const uint8_t *p_data, uint32_t p_size) {
+
+	unsigned char checksum[32];
+	CryptoCore::sha256(p_data, p_size, checksum);
+
+	// Write to a temporary file and move it into place, so a crash or full disk
+	// never leaves a partially written entry behind.
+	String tmp_path = p_path + ".tmp";
+
+	FileAccess *f = FileAccess::open(tmp_path, FileAccess::WRITE);
+	if (!f) {
+		return false;
+	}
+
+	f->store_buffer(entry_magic, 4);
+	f->store_32(CACHE_FORMAT_VERSION);
+	f->store_32(p_format);
+	f->store_32(p_size);
+	f->store_buffer(checksum, 32);
+	f->store_buffer(p_data, p_size);
+	bool ok = f->get_error() == OK;
+	memdelete(f);
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	if (!ok || da->rename(tmp_path, p_path) != OK) {
+		da->remove(tmp_path);
+		ok = false;
+	} else {
+		storage_size += p_size + 48;
+	}
+	memdelete(da);
+
+	if (storage_size > storage_size_limit) {
+		_purge_excess();
+	}
+
+	return ok;
+}
+
+void ShaderCacheGLES2::_remove_entry(const String &p_path) {
+
+	// Either corrupt or rejected by the driver, it will be regenerated and overwritten.
+	print_verbose("Discarding invalid shader cache entry: " + p_path);
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	da->remove(p_path);
+	memdelete(da);
+}
+
+bool ShaderCacheGLES2::retrieve(const String &p_program_hash, GLuint p_program) {
+
+	if (!supported) {
+		return false;
+	}
+
+	String path = storage_path.plus_file(p_program_hash + ".bin");
+	uint32_t format = 0;
+	Vector<uint8_t> data;
+	if (!_read_entry(path, format, data)) {
+		return false;
+	}
+
+#ifdef GLES_OVER_GL
+	glProgramBinary(p_program, format, data.ptr(), data.size());
+#else
+	program_binary(p_program, format, data.ptr(), data.size());
+#endif
+
+	GLint status = GL_FALSE;
+	glGetProgramiv(p_program, GL_LINK_STATUS, &status);
+	if (status != GL_TRUE) {
+		_remove_entry(path);
+		return false;
+	}
+
+	return true;
+}
+
+void ShaderCacheGLES2::store(const String &p_program_hash, GLuint p_program) {
+
+	if (!supported) {
+		return;
+	}
+
+	GLint length = 0;
+	glGetProgramiv(p_program, _GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0) {
+		return;
+	}
+
+	Vector<uint8_t> data;
+	data.resize(length);
+	GLenum format = 0;
+	GLsizei written = 0;
+#ifdef GLES_OVER_GL
+	glGetProgramBinary(p_program, length, &written, &format, data.ptrw());
+#else
+	get_program_binary(p_program, length, &written, &format, data.ptrw());
+#endif
+	if (written <= 0) {
+		return;
+	}
+
+	_write_entry(storage_path.plus_file(p_program_hash + ".bin"), format, data.ptr(), written);
+}
+
+struct ShaderCacheFileGLES2 {
+
+	String name;
+	uint64_t modified_time;
+	uint64_t size;
+
+	bool operator<(const ShaderCacheFileGLES2 &p_other) const { return modified_time < p_other.modified_time; }
+};
+
+void ShaderCacheGLES2::_purge_excess() {
+
+	DirAccess *da = DirAccess::open(storage_path);
+	if (!da) {
+		return;
+	}
+
+	Vector<ShaderCacheFileGLES2> files;
+	storage_size = 0;
+
+	da->list_dir_begin();
+	String name = da->get_next();
+	while (name != String()) {
+		if (!da->current_is_dir()) {
+			String path = storage_path.plus_file(name);
+			FileAccess *f = FileAccess::open(path, FileAccess::READ);
+			if (f) {
+				ShaderCacheFileGLES2 file;
+				file.name = name;
+				file.modified_time = FileAccess::get_modified_time(path);
+				file.size = f->get_len();
+				storage_size += file.size;
+				files.push_back(file);
+				memdelete(f);
+			}
+		}
+		name = da->get_next();
+	}
+	da->list_dir_end();
+
+	if (storage_size > storage_size_limit) {
+		// Evict the oldest entries, leaving some headroom so this does not run on every store.
+		files.sort();
+		uint64_t target = storage_size_limit - storage_size_limit / 4;
+		for (int i = 0; i < files.size() && storage_size > target; i++) {
+			if (da->remove(files[i].name) == OK) {
+				storage_size -= files[i].size;
+			}
+		}
+	}
+
+	memdelete(da);
+}
+
+ShaderCacheGLES2::ShaderCacheGLES2() {
+
+	singleton = this;
+
+	supported = false;
+#if !defined(GLES_OVER_GL)
+	get_program_binary = NULL;
+	program_binary = NULL;
+#endif
+	storage_size = 0;
+	storage_size_limit = uint64_t(MAX(1, int(GLOBAL_GET("rendering/gles2/shaders/shader_cache_size_mb")))) * 1024 * 1024;
+
+	if (!GLOBAL_GET("rendering/gles2/shaders/use_shader_cache")) {
+		return;
+	}
+
+#if defined(GLAD_ENABLED)
+	supported = GLAD_GL_ARB_get_program_binary;
+#elif defined(ANDROID_ENABLED)
+	String extensions = (const char *)glGetString(GL_EXTENSIONS);
+	if (extensions.find("GL_OES_get_program_binary") != -1) {
+		get_program_binary = (GetProgramBinaryFunc)eglGetProcAddress("glGetProgramBinaryOES");
+		program_binary = (ProgramBinaryFunc)eglGetProcAddress("glProgramBinaryOES");
+		supported = get_program_binary && program_binary;
+	}
+#else
+	// iOS and WebGL don't expose program binaries.
+	supported = false;
+#endif
+
+	if (supported) {
+		// Some drivers expose the entry points but support no binary formats at all.
+		GLint format_count = 0;
+		glGetIntegerv(_GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+		supported = format_count > 0;
+	}
+
+	if (!supported) {
+		print_verbose("Shader cache: program binaries not supported by the driver.");
+		return;
+	}
+
+	storage_path = "user://shader_cache/gles2";
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	supported = da->dir_exists(storage_path) || da->make_dir_recursive(storage_path) == OK;
+	memdelete(da);
+
+	if (!supported) {
+		ERR_PRINT("Couldn't create shader cache directory, shader cache disabled.");
+		return;
+	}
+
+	_purge_excess();
+
+	driver_info = String((const char *)glGetString(GL_VENDOR)) + "|" + String((const char *)glGetString(GL_RENDERER)) + "|" + String((const char *)glGetString(GL_VERSION));
+}
+
+ShaderCacheGLES2::~ShaderCacheGLES2() {
+
+	singleton = NULL;
+}
@@ -0,0 +1,92 @@
+/*************************************************************************/
+/*  shader_cache_gles2.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SHADER_CACHE_GLES2_H
+#define SHADER_CACHE_GLES2_H
+
+#include "core/ustring.h"
+#include "core/vector.h"
+
+#include "platform_config.h"
+#ifndef GLES2_INCLUDE_H
+#include <GLES2/gl2.h>
+#else
+#include GLES2_INCLUDE_H
+#endif
+
+// Persistent cache of linked program binaries, stored in the user data
+// directory. Uses ARB_get_program_binary on desktop and OES_get_program_binary
+// on mobile. Entries are keyed by a hash of the full shader source plus the
+// driver identification strings, so a driver update simply misses the cache.
+
+class ShaderCacheGLES2 {
+
+	enum {
+		CACHE_FORMAT_VERSION = 1,
+	};
+
+	static ShaderCacheGLES2 *singleton;
+
+	bool supported;
+	String storage_path;
+	String driver_info;
+	uint64_t storage_size;
+	uint64_t storage_size_limit;
+
+#if !defined(GLES_OVER_GL)
+	typedef void (*GetProgramBinaryFunc)(GLuint, GLsizei, GLsizei *, GLenum *, void *);
+	typedef void (*ProgramBinaryFunc)(GLuint, GLenum, const void *, GLint);
+
+	GetProgramBinaryFunc get_program_binary;
+	ProgramBinaryFunc program_binary;
+#endif
+
+	bool _read_entry(const String &p_path, uint32_t &r_format, Vector<uint8_t> &r_data);
+	bool _write_entry(const String &p_path, uint32_t p_format, const uint8_t *p_data, uint32_t p_size);
+	void _remove_entry(const String &p_path);
+	void _purge_excess();
+
+public:
+	_FORCE_INLINE_ static ShaderCacheGLES2 *get_singleton() { return singleton; }
+
+	// Whether the cache is enabled and program binaries can be cached with this driver.
+	_FORCE_INLINE_ bool is_supported() const { return supported; }
+
+	String hash_program(const String &p_name, const Vector<const char *> &p_vertex_strings, const Vector<const char *> &p_fragment_strings) const;
+
+	// Loads the binary into the (empty) program, returns false on a miss or if it failed to link.
+	bool retrieve(const String &p_program_hash, GLuint p_program);
+	void store(const String &p_program_hash, GLuint p_program);
+
+	ShaderCacheGLES2();
+	~ShaderCacheGLES2();
+};
+
+#endif // SHADER_CACHE_GLES2_H
@@ -36,6 +36,7 @@
 #include "core/string_builder.h"
 #include "rasterizer_gles2.h"
 #include "rasterizer_storage_gles2.h"
+#include "shader_cache_gles2.h"
 
 // #define DEBUG_OPENGL
 
@@ -209,6 +210,8 @@ ShaderGLES2::Version *ShaderGLES2::get_current_version() {
 	}
 
 	// keep them around during the function
+	CharString vertex_code_string;
+	CharString vertex_code_globals;
 	CharString code_string;
 	CharString code_string2;
 	CharString code_globals;
@@ -241,27 +244,82 @@ ShaderGLES2::Version *ShaderGLES2::get_current_version() {
 	strings.push_back(vertex_code0.get_data());
 
 	if (cc) {
-		code_globals = cc->vertex_globals.ascii();
-		strings.push_back(code_globals.get_data());
+		vertex_code_globals = cc->vertex_globals.ascii();
+		strings.push_back(vertex_code_globals.get_data());
 	}
 
 	strings.push_back(vertex_code1.get_data());
 
 	if (cc) {
-		code_string = cc->vertex.ascii();
-		strings.push_back(code_string.get_data());
+		vertex_code_string = cc->vertex.ascii();
+		strings.push_back(vertex_code_string.get_data());
 	}
 
 	strings.push_back(vertex_code2.get_data());
 
 #ifdef DEBUG_SHADER
 
-	DEBUG_PRINT("\nVertex Code:\n\n" + String(code_string.get_data()));
+	DEBUG_PRINT("\nVertex Code:\n\n" + String(vertex_code_string.get_data()));
 
 #endif
 
+	// both stages are assembled before compiling, so the program can be looked up in the cache
+	Vector<const char *> vertex_strings = strings;
+
+	// fragment shader
+
+	strings.resize(string_base_size);
+
+	strings.push_back(fragment_code0.get_data());
+
+	if (cc) {
+		code_globals = cc->fragment_globals.ascii();
+		strings.push_back(code_globals.get_data());
+	}
+
+	strings.push_back(fragment_code1.get_data());
+
+	if (cc) {
+		code_string = cc->light.ascii();
+		strings.push_back(code_string.get_data());
+	}
+
+	strings.push_back(fragment_code2.get_data());
+
+	if (cc) {
+		code_string2 = cc->fragment.ascii();
+		strings.push_back(code_string2.get_data());
+	}
+
+	strings.push_back(fragment_code3.get_data());
+
+#ifdef DEBUG_SHADER
+
+	if (cc) {
+		DEBUG_PRINT("\nFragment Code:\n\n" + String(cc->fragment_globals));
+	}
+	DEBUG_PRINT("\nFragment Code:\n\n" + String(code_string.get_data()));
+#endif
+
+	ShaderCacheGLES2 *shader_cache = ShaderCacheGLES2::get_singleton();
+	String program_hash;
+
+	if (shader_cache && shader_cache->is_supported()) {
+		program_hash = shader_cache->hash_program(get_shader_name(), vertex_strings, strings);
+
+		if (shader_cache->retrieve(program_hash, v.id)) {
+			// linked straight from the binary, there are no shader objects to keep around
+			v.vert_id = 0;
+			v.frag_id = 0;
+			_finish_version(v, cc);
+			return &v;
+		}
+	}
+
+	// vertex shader
+
 	v.vert_id = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(v.vert_id, strings.size(), &strings[0], NULL);
+	glShaderSource(v.vert_id, vertex_strings.size(), &vertex_strings[0], NULL);
 	glCompileShader(v.vert_id);
 
 	GLint status;
@@ -290,7 +348,7 @@ ShaderGLES2::Version *ShaderGLES2::get_current_version() {
 
 			err_string += ilogmem;
 
-			_display_error_with_code(err_string, strings);
+			_display_error_with_code(err_string, vertex_strings);
 
 			Memory::free_static(ilogmem);
 			glDeleteShader(v.vert_id);
@@ -301,41 +359,6 @@ ShaderGLES2::Version *ShaderGLES2::get_current_version() {
 		ERR_FAIL_V(NULL);
 	}
 
-	strings.resize(string_base_size);
-
-	// fragment shader
-
-	strings.push_back(fragment_code0.get_data());
-
-	if (cc) {
-		code_globals = cc->fragment_globals.ascii();
-		strings.push_back(code_globals.get_data());
-	}
-
-	strings.push_back(fragment_code1.get_data());
-
-	if (cc) {
-		code_string = cc->light.ascii();
-		strings.push_back(code_string.get_data());
-	}
-
-	strings.push_back(fragment_code2.get_data());
-
-	if (cc) {
-		code_string2 = cc->fragment.ascii();
-		strings.push_back(code_string2.get_data());
-	}
-
-	strings.push_back(fragment_code3.get_data());
-
-#ifdef DEBUG_SHADER
-
-	if (cc) {
-		DEBUG_PRINT("\nFragment Code:\n\n" + String(cc->fragment_globals));
-	}
-	DEBUG_PRINT("\nFragment Code:\n\n" + String(code_string.get_data()));
-#endif
-
 	v.frag_id = glCreateShader(GL_FRAGMENT_SHADER);
 	glShaderSource(v.frag_id, strings.size(), &strings[0], NULL);
 	glCompileShader(v.frag_id);
@@ -387,6 +410,12 @@ ShaderGLES2::Version *ShaderGLES2::get_current_version() {
 		glBindAttribLocation(v.id, attribute_pairs[i].index, attribute_pairs[i].name);
 	}
 
+#ifdef GLES_OVER_GL
+	if (program_hash != String()) {
+		glProgramParameteri(v.id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+#endif
+
 	glLinkProgram(v.id);
 
 	glGetProgramiv(v.id, GL_LINK_STATUS, &status);
@@ -427,6 +456,16 @@ ShaderGLES2::Version *ShaderGLES2::get_current_version() {
 		ERR_FAIL_V(NULL);
 	}
 
+	if (program_hash != String()) {
+		shader_cache->store(program_hash, v.id);
+	}
+
+	_finish_version(v, cc);
+	return &v;
+}
+
+void ShaderGLES2::_finish_version(Version &v, CustomCode *cc) {
+
 	// get uniform locations
 
 	glUseProgram(v.id);
@@ -469,8 +508,6 @@ ShaderGLES2::Version *ShaderGLES2::get_current_version() {
 	if (cc) {
 		cc->versions.insert(conditional_version.version);
 	}
-
-	return &v;
 }
 
 GLint ShaderGLES2::get_uniform_location(const String &p_name) const {
@@ -174,6 +174,7 @@ private:
 	Vector<CharString> custom_defines;
 
 	Version *get_current_version();
+	void _finish_version(Version &v, CustomCode *cc);
 
 	static ShaderGLES2 *active;
 
@@ -153,8 +153,23 @@ void RasterizerCanvasBaseGLES3::canvas_begin() {
 				storage->frame.clear_request_color.g,
 				storage->frame.clear_request_color.b,
 				transparent ? storage->frame.clear_request_color.a : 1.0);
-		glClear(GL_COLOR_BUFFER_BIT);
+
+		const Rect2 &clear_rect = storage->frame.clear_request_rect;
+		if (!clear_rect.has_no_area()) {
+			// only clear the region that is going to be redrawn
+			int y = storage->frame.current_rt->height - (clear_rect.position.y + clear_rect.size.y);
+			if (storage->frame.current_rt->flags[RasterizerStorage::RENDER_TARGET_VFLIP])
+				y = clear_rect.position.y;
+
+			glEnable(GL_SCISSOR_TEST);
+			glScissor(clear_rect.position.x, y, clear_rect.size.x, clear_rect.size.y);
+			glClear(GL_COLOR_BUFFER_BIT);
+			glDisable(GL_SCISSOR_TEST);
+		} else {
+			glClear(GL_COLOR_BUFFER_BIT);
+		}
 		storage->frame.clear_request = false;
+		storage->frame.clear_request_rect = Rect2();
 		glColorMask(1, 1, 1, transparent ? 1 : 0);
 	}
 
@@ -45,6 +45,9 @@ static const GLenum gl_primitive[] = {
 
 void RasterizerCanvasGLES3::canvas_end() {
 	batch_canvas_end();
+	if (static_item_cache.enabled) {
+		_static_item_cache_evict();
+	}
 	RasterizerCanvasBaseGLES3::canvas_end();
 }
 
@@ -1484,8 +1487,7 @@ void RasterizerCanvasGLES3::render_joined_item(const BItemJoined &p_bij, RenderI
 		state.canvas_shader.set_uniform(CanvasShaderGLES3::SCREEN_PIXEL_SIZE, Vector2(1.0, 1.0));
 	}
 	if (unshaded || (state.canvas_item_modulate.a > 0.001 && (!r_ris.shader_cache || r_ris.shader_cache->canvas_item.light_mode != RasterizerStorageGLES3::Shader::CanvasItem::LIGHT_MODE_LIGHT_ONLY) && !p_ci->light_masked)) {
-		RasterizerStorageGLES3::Material *material_ptr = nullptr;
-		render_joined_item_commands(p_bij, NULL, reclip, material_ptr, false);
+		_render_joined_item_commands_unlit(p_bij, reclip);
 	}
 
 	if ((blend_mode == RasterizerStorageGLES3::Shader::CanvasItem::BLEND_MODE_MIX || blend_mode == RasterizerStorageGLES3::Shader::CanvasItem::BLEND_MODE_PMALPHA) && r_ris.item_group_light && !unshaded) {
@@ -2044,6 +2046,240 @@ void RasterizerCanvasGLES3::_batch_upload_buffers() {
 
 	// might not be necessary
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	if (static_item_cache.capture) {
+		_static_item_cache_capture();
+	}
+}
+
+void RasterizerCanvasGLES3::_bind_batch_vertex_array(RasterizerStorageCommon::FVF p_fvf) {
+	if (batch_gl_data.override_vertex_array) {
+		glBindVertexArray(batch_gl_data.override_vertex_array);
+		return;
+	}
+
+	switch (p_fvf) {
+		case RasterizerStorageCommon::FVF_UNBATCHED: // should not happen
+			break;
+		case RasterizerStorageCommon::FVF_REGULAR: // no change
+			glBindVertexArray(batch_gl_data.batch_vertex_array[0]);
+			break;
+		case RasterizerStorageCommon::FVF_COLOR:
+			glBindVertexArray(batch_gl_data.batch_vertex_array[1]);
+			break;
+		case RasterizerStorageCommon::FVF_LIGHT_ANGLE:
+			glBindVertexArray(batch_gl_data.batch_vertex_array[2]);
+			break;
+		case RasterizerStorageCommon::FVF_MODULATED:
+			glBindVertexArray(batch_gl_data.batch_vertex_array[3]);
+			break;
+		case RasterizerStorageCommon::FVF_LARGE:
+			glBindVertexArray(batch_gl_data.batch_vertex_array[4]);
+			break;
+	}
+}
+
+void RasterizerCanvasGLES3::_render_joined_item_commands_unlit(const BItemJoined &p_bij, bool &r_reclip) {
+	Item *ci = bdata.item_refs[p_bij.first_item_ref].item;
+
+	// only single items drawn with the hardware transform can be cached, as their vertices
+	// are in local space, and only those with enough commands to be worth a buffer
+	bool cacheable = static_item_cache.enabled && p_bij.is_single_item() && !p_bij.use_attrib_transform() && (ci->commands.size() >= static_item_cache.min_rects);
+
+#if defined(TOOLS_ENABLED) && defined(DEBUG_ENABLED)
+	if (bdata.diagnose_frame) {
+		cacheable = false;
+	}
+#endif
+
+	if (!cacheable) {
+		render_joined_item_commands(p_bij, NULL, r_reclip, nullptr, false);
+		return;
+	}
+
+	uint64_t key = (uint64_t)(uintptr_t)ci;
+	StaticItemCache::Entry *entry = static_item_cache.entries.getptr(key);
+	if (!entry) {
+		static_item_cache.entries.set(key, StaticItemCache::Entry());
+		entry = static_item_cache.entries.getptr(key);
+	}
+
+	bool unchanged = (entry->command_version == ci->command_version) && (entry->command_count == ci->commands.size()) && (entry->join_flags == p_bij.flags) && (entry->batch_flags == bdata.joined_item_batch_flags);
+	entry->last_used_frame = storage->frame.count;
+
+	if (unchanged && entry->built && _static_item_cache_validate(*entry)) {
+		// replay the recorded batches from the item's own vertex buffer
+		bdata.reset_flush();
+		bdata.fvf = entry->fvf;
+		bdata.use_colored_vertices = entry->fvf == RasterizerStorageCommon::FVF_COLOR;
+
+		for (unsigned int n = 0; n < entry->batch_textures.size(); n++) {
+			bdata.batch_textures.push_back(entry->batch_textures[n]);
+		}
+		for (unsigned int n = 0; n < entry->batches.size(); n++) {
+			*bdata.batches.request_with_grow() = entry->batches[n];
+		}
+
+		batch_gl_data.override_vertex_array = entry->vertex_array;
+		render_batches(NULL, r_reclip, nullptr);
+		batch_gl_data.override_vertex_array = 0;
+
+		bdata.reset_flush();
+		return;
+	}
+
+	if (!unchanged || entry->built) {
+		// changed since last seen, wait until it stays the same for a frame
+		// before spending a buffer on it
+		_static_item_cache_free_entry(*entry);
+		entry->rejected = false;
+		entry->command_version = ci->command_version;
+		entry->command_count = ci->commands.size();
+		entry->join_flags = p_bij.flags;
+		entry->batch_flags = bdata.joined_item_batch_flags;
+		render_joined_item_commands(p_bij, NULL, r_reclip, nullptr, false);
+		return;
+	}
+
+	if (entry->rejected) {
+		render_joined_item_commands(p_bij, NULL, r_reclip, nullptr, false);
+		return;
+	}
+
+	static_item_cache.capture = entry;
+	static_item_cache.capture_flushes = 0;
+	render_joined_item_commands(p_bij, NULL, r_reclip, nullptr, false);
+	static_item_cache.capture = nullptr;
+
+	// items that needed more than one flush, or contain anything other than rects,
+	// are not cached until their commands change
+	if (!entry->built || static_item_cache.capture_flushes != 1) {
+		_static_item_cache_free_entry(*entry);
+		entry->rejected = true;
+	}
+}
+
+bool RasterizerCanvasGLES3::_static_item_cache_validate(const StaticItemCache::Entry &p_entry) const {
+	// the recorded UVs depend on the texture sizes and flags at capture time
+	for (unsigned int n = 0; n < p_entry.batch_textures.size(); n++) {
+		const BatchTex &batch_texture = p_entry.batch_textures[n];
+		if (!batch_texture.RID_texture.is_valid()) {
+			continue;
+		}
+
+		RasterizerStorageGLES3::Texture *texture = _get_canvas_texture(batch_texture.RID_texture);
+		if (!texture) {
+			return false;
+		}
+
+		int w = texture->width;
+		int h = texture->height;
+		if (!w || !h) {
+			w = 1;
+			h = 1;
+		}
+
+		if ((batch_texture.tex_pixel_size.x != 1.0f / w) || (batch_texture.tex_pixel_size.y != 1.0f / h) || (batch_texture.flags != texture->flags)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void RasterizerCanvasGLES3::_static_item_cache_capture() {
+	StaticItemCache::Entry *entry = static_item_cache.capture;
+	static_item_cache.capture_flushes++;
+
+	if (static_item_cache.capture_flushes > 1) {
+		return;
+	}
+
+	const void *data = nullptr;
+	int vert_size = 0;
+	int num_verts = 0;
+	int vao_format = 0;
+
+	switch (bdata.fvf) {
+		case RasterizerStorageCommon::FVF_REGULAR: {
+			data = bdata.vertices.get_data();
+			vert_size = sizeof(BatchVertex);
+			num_verts = bdata.vertices.size();
+			vao_format = 0;
+		} break;
+		case RasterizerStorageCommon::FVF_COLOR: {
+			data = bdata.unit_vertices.get_unit(0);
+			vert_size = sizeof(BatchVertexColored);
+			num_verts = bdata.unit_vertices.size();
+			vao_format = 1;
+		} break;
+		default: {
+			return;
+		} break;
+	}
+
+	for (int n = 0; n < bdata.batches.size(); n++) {
+		if (bdata.batches[n].type != RasterizerStorageCommon::BT_RECT) {
+			return;
+		}
+	}
+
+	glGenBuffers(1, &entry->vertex_buffer);
+	glBindBuffer(GL_ARRAY_BUFFER, entry->vertex_buffer);
+	glBufferData(GL_ARRAY_BUFFER, vert_size * num_verts, data, GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glGenVertexArrays(1, &entry->vertex_array);
+	_batch_setup_vertex_array(entry->vertex_array, entry->vertex_buffer, vao_format);
+
+	entry->fvf = bdata.fvf;
+	entry->batches.resize(bdata.batches.size());
+	for (int n = 0; n < bdata.batches.size(); n++) {
+		entry->batches[n] = bdata.batches[n];
+	}
+	entry->batch_textures.resize(bdata.batch_textures.size());
+	for (int n = 0; n < bdata.batch_textures.size(); n++) {
+		entry->batch_textures[n] = bdata.batch_textures[n];
+	}
+	entry->built = true;
+}
+
+void RasterizerCanvasGLES3::_static_item_cache_free_entry(StaticItemCache::Entry &r_entry) {
+	if (r_entry.vertex_array) {
+		glDeleteVertexArrays(1, &r_entry.vertex_array);
+		r_entry.vertex_array = 0;
+	}
+	if (r_entry.vertex_buffer) {
+		glDeleteBuffers(1, &r_entry.vertex_buffer);
+		r_entry.vertex_buffer = 0;
+	}
+	r_entry.batches.clear();
+	r_entry.batch_textures.clear();
+	r_entry.built = false;
+}
+
+void RasterizerCanvasGLES3::_static_item_cache_evict() {
+	// once per frame, drop entries for items that have not been drawn for a while
+	// (freed, hidden or culled), items are only identified by pointer
+	uint64_t frame = storage->frame.count;
+	if (frame == static_item_cache.last_evict_frame) {
+		return;
+	}
+	static_item_cache.last_evict_frame = frame;
+
+	LocalVector<uint64_t> stale;
+	const uint64_t *k = nullptr;
+	while ((k = static_item_cache.entries.next(k))) {
+		StaticItemCache::Entry &entry = static_item_cache.entries[*k];
+		if ((frame - entry.last_used_frame) > 60) {
+			_static_item_cache_free_entry(entry);
+			stale.push_back(*k);
+		}
+	}
+
+	for (unsigned int n = 0; n < stale.size(); n++) {
+		static_item_cache.entries.erase(stale[n]);
+	}
 }
 
 void RasterizerCanvasGLES3::_batch_render_lines(const Batch &p_batch, RasterizerStorageGLES3::Material *p_material, bool p_anti_alias) {
@@ -2089,26 +2325,12 @@ void RasterizerCanvasGLES3::_batch_render_prepare() {
 	//	state.canvas_shader.set_uniform(CanvasShaderGLES3::CLIP_RECT_UV, p_rect->flags & CANVAS_RECT_CLIP_UV);
 	state.canvas_shader.set_uniform(CanvasShaderGLES3::CLIP_RECT_UV, false);
 
-	switch (bdata.fvf) {
-		case RasterizerStorageCommon::FVF_UNBATCHED: // should not happen
-			return;
-			break;
-		case RasterizerStorageCommon::FVF_REGULAR: // no change
-			glBindVertexArray(batch_gl_data.batch_vertex_array[0]);
-			break;
-		case RasterizerStorageCommon::FVF_COLOR:
-			glBindVertexArray(batch_gl_data.batch_vertex_array[1]);
-			break;
-		case RasterizerStorageCommon::FVF_LIGHT_ANGLE:
-			glBindVertexArray(batch_gl_data.batch_vertex_array[2]);
-			break;
-		case RasterizerStorageCommon::FVF_MODULATED:
-			glBindVertexArray(batch_gl_data.batch_vertex_array[3]);
-			break;
-		case RasterizerStorageCommon::FVF_LARGE:
-			glBindVertexArray(batch_gl_data.batch_vertex_array[4]);
-			break;
+	if (bdata.fvf == RasterizerStorageCommon::FVF_UNBATCHED) {
+		// should not happen
+		return;
 	}
+
+	_bind_batch_vertex_array(bdata.fvf);
 }
 
 void RasterizerCanvasGLES3::_batch_render_generic(const Batch &p_batch, RasterizerStorageGLES3::Material *p_material) {
@@ -2124,27 +2346,13 @@ void RasterizerCanvasGLES3::_batch_render_generic(const Batch &p_batch, Rasteriz
 	//	state.canvas_shader.set_uniform(CanvasShaderGLES3::CLIP_RECT_UV, p_rect->flags & CANVAS_RECT_CLIP_UV);
 	state.canvas_shader.set_uniform(CanvasShaderGLES3::CLIP_RECT_UV, false);
 
-	switch (bdata.fvf) {
-		case RasterizerStorageCommon::FVF_UNBATCHED: // should not happen
-			return;
-			break;
-		case RasterizerStorageCommon::FVF_REGULAR: // no change
-			glBindVertexArray(batch_gl_data.batch_vertex_array[0]);
-			break;
-		case RasterizerStorageCommon::FVF_COLOR:
-			glBindVertexArray(batch_gl_data.batch_vertex_array[1]);
-			break;
-		case RasterizerStorageCommon::FVF_LIGHT_ANGLE:
-			glBindVertexArray(batch_gl_data.batch_vertex_array[2]);
-			break;
-		case RasterizerStorageCommon::FVF_MODULATED:
-			glBindVertexArray(batch_gl_data.batch_vertex_array[3]);
-			break;
-		case RasterizerStorageCommon::FVF_LARGE:
-			glBindVertexArray(batch_gl_data.batch_vertex_array[4]);
-			break;
+	if (bdata.fvf == RasterizerStorageCommon::FVF_UNBATCHED) {
+		// should not happen
+		return;
 	}
 
+	_bind_batch_vertex_array(bdata.fvf);
+
 	// batch tex
 	const BatchTex &tex = bdata.batch_textures[p_batch.batch_texture_id];
 
@@ -2223,6 +2431,89 @@ void RasterizerCanvasGLES3::_batch_render_generic(const Batch &p_batch, Rasteriz
 	*/
 }
 
+void RasterizerCanvasGLES3::_batch_setup_vertex_array(GLuint p_vertex_array, GLuint p_vertex_buffer, int p_vao_format) {
+	int sizeof_vert = 0;
+	switch (p_vao_format) {
+		case 0:
+			sizeof_vert = sizeof(BatchVertex);
+			break;
+		case 1:
+			sizeof_vert = sizeof(BatchVertexColored);
+			break;
+		case 2:
+			sizeof_vert = sizeof(BatchVertexLightAngled);
+			break;
+		case 3:
+			sizeof_vert = sizeof(BatchVertexModulated);
+			break;
+		case 4:
+			sizeof_vert = sizeof(BatchVertexLarge);
+			break;
+	}
+
+	glBindVertexArray(p_vertex_array);
+	glBindBuffer(GL_ARRAY_BUFFER, p_vertex_buffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bdata.gl_index_buffer);
+
+	uint64_t pointer = 0;
+	glEnableVertexAttribArray(VS::ARRAY_VERTEX);
+	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, GL_FALSE, sizeof_vert, (const void *)pointer);
+
+	// always send UVs, even within a texture specified because a shader can still use UVs
+	glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
+	glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, GL_FALSE, sizeof_vert, CAST_INT_TO_UCHAR_PTR(pointer + (2 * 4)));
+
+	// optional attributes
+	bool a_color = false;
+	bool a_light_angle = false;
+	bool a_modulate = false;
+	bool a_large = false;
+
+	switch (p_vao_format) {
+		case 0:
+			break;
+		case 1: {
+			a_color = true;
+		} break;
+		case 2: {
+			a_color = true;
+			a_light_angle = true;
+		} break;
+		case 3: {
+			a_color = true;
+			a_light_angle = true;
+			a_modulate = true;
+		} break;
+		case 4: {
+			a_color = true;
+			a_light_angle = true;
+			a_modulate = true;
+			a_large = true;
+		} break;
+	}
+
+	if (a_color) {
+		glEnableVertexAttribArray(VS::ARRAY_COLOR);
+		glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, GL_FALSE, sizeof_vert, CAST_INT_TO_UCHAR_PTR(pointer + (4 * 4)));
+	}
+	if (a_light_angle) {
+		glEnableVertexAttribArray(VS::ARRAY_TANGENT);
+		glVertexAttribPointer(VS::ARRAY_TANGENT, 1, GL_FLOAT, GL_FALSE, sizeof_vert, CAST_INT_TO_UCHAR_PTR(pointer + (8 * 4)));
+	}
+	if (a_modulate) {
+		glEnableVertexAttribArray(VS::ARRAY_TEX_UV2);
+		glVertexAttribPointer(VS::ARRAY_TEX_UV2, 4, GL_FLOAT, GL_FALSE, sizeof_vert, CAST_INT_TO_UCHAR_PTR(pointer + (9 * 4)));
+	}
+	if (a_large) {
+		glEnableVertexAttribArray(VS::ARRAY_BONES);
+		glVertexAttribPointer(VS::ARRAY_BONES, 2, GL_FLOAT, GL_FALSE, sizeof_vert, CAST_INT_TO_UCHAR_PTR(pointer + (13 * 4)));
+		glEnableVertexAttribArray(VS::ARRAY_WEIGHTS);
+		glVertexAttribPointer(VS::ARRAY_WEIGHTS, 4, GL_FLOAT, GL_FALSE, sizeof_vert, CAST_INT_TO_UCHAR_PTR(pointer + (15 * 4)));
+	}
+
+	glBindVertexArray(0);
+}
+
 void RasterizerCanvasGLES3::initialize() {
 	gl_checkerror();
 	RasterizerCanvasBaseGLES3::initialize();
@@ -2267,89 +2558,13 @@ void RasterizerCanvasGLES3::initialize() {
 
 	// vertex array objects
 	for (int vao = 0; vao < 5; vao++) {
-
-		int sizeof_vert;
-		switch (vao) {
-			case 0:
-				sizeof_vert = sizeof(BatchVertex);
-				break;
-			case 1:
-				sizeof_vert = sizeof(BatchVertexColored);
-				break;
-			case 2:
-				sizeof_vert = sizeof(BatchVertexLightAngled);
-				break;
-			case 3:
-				sizeof_vert = sizeof(BatchVertexModulated);
-				break;
-			case 4:
-				sizeof_vert = sizeof(BatchVertexLarge);
-				break;
-		}
-
 		glGenVertexArrays(1, &batch_gl_data.batch_vertex_array[vao]);
-		glBindVertexArray(batch_gl_data.batch_vertex_array[vao]);
-		glBindBuffer(GL_ARRAY_BUFFER, bdata.gl_vertex_buffer);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bdata.gl_index_buffer);
-
-		uint64_t pointer = 0;
-		glEnableVertexAttribArray(VS::ARRAY_VERTEX);
-		glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, GL_FALSE, sizeof_vert, (const void *)pointer);
-
-		// always send UVs, even within a texture specified because a shader can still use UVs
-		glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
-		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, GL_FALSE, sizeof_vert, CAST_INT_TO_UCHAR_PTR(pointer + (2 * 4)));
-
-		// optional attributes
-		bool a_color = false;
-		bool a_light_angle = false;
-		bool a_modulate = false;
-		bool a_large = false;
-
-		switch (vao) {
-			case 0:
-				break;
-			case 1: {
-				a_color = true;
-			} break;
-			case 2: {
-				a_color = true;
-				a_light_angle = true;
-			} break;
-			case 3: {
-				a_color = true;
-				a_light_angle = true;
-				a_modulate = true;
-			} break;
-			case 4: {
-				a_color = true;
-				a_light_angle = true;
-				a_modulate = true;
-				a_large = true;
-			} break;
-		}
-
-		if (a_color) {
-			glEnableVertexAttribArray(VS::ARRAY_COLOR);
-			glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, GL_FALSE, sizeof_vert, CAST_INT_TO_UCHAR_PTR(pointer + (4 * 4)));
-		}
-		if (a_light_angle) {
-			glEnableVertexAttribArray(VS::ARRAY_TANGENT);
-			glVertexAttribPointer(VS::ARRAY_TANGENT, 1, GL_FLOAT, GL_FALSE, sizeof_vert, CAST_INT_TO_UCHAR_PTR(pointer + (8 * 4)));
-		}
-		if (a_modulate) {
-			glEnableVertexAttribArray(VS::ARRAY_TEX_UV2);
-			glVertexAttribPointer(VS::ARRAY_TEX_UV2, 4, GL_FLOAT, GL_FALSE, sizeof_vert, CAST_INT_TO_UCHAR_PTR(pointer + (9 * 4)));
-		}
-		if (a_large) {
-			glEnableVertexAttribArray(VS::ARRAY_BONES);
-			glVertexAttribPointer(VS::ARRAY_BONES, 2, GL_FLOAT, GL_FALSE, sizeof_vert, CAST_INT_TO_UCHAR_PTR(pointer + (13 * 4)));
-			glEnableVertexAttribArray(VS::ARRAY_WEIGHTS);
-			glVertexAttribPointer(VS::ARRAY_WEIGHTS, 4, GL_FLOAT, GL_FALSE, sizeof_vert, CAST_INT_TO_UCHAR_PTR(pointer + (15 * 4)));
-		}
+		_batch_setup_vertex_array(batch_gl_data.batch_vertex_array[vao], bdata.gl_vertex_buffer, vao);
+	}
+	batch_gl_data.override_vertex_array = 0;
 
-		glBindVertexArray(0);
-	} // for vao
+	static_item_cache.enabled = bdata.settings_use_batching && GLOBAL_GET("rendering/batching/options/use_static_item_cache");
+	static_item_cache.min_rects = GLOBAL_GET("rendering/batching/parameters/static_item_cache_min_rects");
 
 	// deal with ninepatch mode option
 	if (bdata.settings_ninepatch_mode == 1) {
@@ -2359,6 +2574,16 @@ void RasterizerCanvasGLES3::initialize() {
 	gl_checkerror();
 }
 
+void RasterizerCanvasGLES3::finalize() {
+	const uint64_t *k = nullptr;
+	while ((k = static_item_cache.entries.next(k))) {
+		_static_item_cache_free_entry(static_item_cache.entries[*k]);
+	}
+	static_item_cache.entries.clear();
+
+	RasterizerCanvasBaseGLES3::finalize();
+}
+
 RasterizerCanvasGLES3::RasterizerCanvasGLES3() {
 
 	batch_constructor();
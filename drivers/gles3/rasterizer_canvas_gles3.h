@@ -31,6 +31,8 @@
 #ifndef RASTERIZERCANVASGLES3_H
 #define RASTERIZERCANVASGLES3_H
 
+#include "core/hash_map.h"
+#include "core/local_vector.h"
 #include "drivers/gles_common/rasterizer_canvas_batcher.h"
 #include "rasterizer_canvas_base_gles3.h"
 
@@ -41,8 +43,64 @@ private:
 	struct BatchGLData {
 		// for batching
 		GLuint batch_vertex_array[5];
+
+		// if set, used instead of the shared vertex arrays (static item cache)
+		GLuint override_vertex_array;
 	} batch_gl_data;
 
+	// Single items made only of rects (tilemaps, static UI etc.) that have not changed
+	// since the previous frame get their batches and vertices stored in their own
+	// static vertex buffer, so later frames skip the fill and upload entirely and only
+	// issue the draw calls, with the item transform and modulate sent as uniforms.
+	struct StaticItemCache {
+		struct Entry {
+			uint32_t command_version;
+			int command_count;
+			uint16_t join_flags;
+			uint32_t batch_flags;
+			uint64_t last_used_frame;
+			bool built;
+			bool rejected;
+
+			GLuint vertex_buffer;
+			GLuint vertex_array;
+			RasterizerStorageCommon::FVF fvf;
+			LocalVector<Batch> batches;
+			LocalVector<BatchTex> batch_textures;
+
+			Entry() {
+				command_version = 0;
+				command_count = 0;
+				join_flags = 0;
+				batch_flags = 0;
+				last_used_frame = 0;
+				built = false;
+				rejected = false;
+				vertex_buffer = 0;
+				vertex_array = 0;
+				fvf = RasterizerStorageCommon::FVF_REGULAR;
+			}
+		};
+
+		HashMap<uint64_t, Entry> entries;
+
+		// entry being recorded by the current flush, if any
+		Entry *capture;
+		int capture_flushes;
+
+		bool enabled;
+		int min_rects;
+		uint64_t last_evict_frame;
+
+		StaticItemCache() {
+			capture = nullptr;
+			capture_flushes = 0;
+			enabled = false;
+			min_rects = 32;
+			last_evict_frame = 0;
+		}
+	} static_item_cache;
+
 public:
 	virtual void canvas_render_items_begin(const Color &p_modulate, Light *p_light, const Transform2D &p_base_transform);
 	virtual void canvas_render_items_end();
@@ -65,6 +123,15 @@ private:
 	void _batch_render_prepare();
 	void _batch_render_generic(const Batch &p_batch, RasterizerStorageGLES3::Material *p_material);
 	void _batch_render_lines(const Batch &p_batch, RasterizerStorageGLES3::Material *p_material, bool p_anti_alias);
+	void _batch_setup_vertex_array(GLuint p_vertex_array, GLuint p_vertex_buffer, int p_vao_format);
+	void _bind_batch_vertex_array(RasterizerStorageCommon::FVF p_fvf);
+
+	// static item cache
+	void _render_joined_item_commands_unlit(const BItemJoined &p_bij, bool &r_reclip);
+	bool _static_item_cache_validate(const StaticItemCache::Entry &p_entry) const;
+	void _static_item_cache_capture();
+	void _static_item_cache_free_entry(StaticItemCache::Entry &r_entry);
+	void _static_item_cache_evict();
 
 	// funcs used from rasterizer_canvas_batcher template
 	void gl_enable_scissor(int p_x, int p_y, int p_width, int p_height) const;
@@ -74,6 +141,7 @@ private:
 
 public:
 	void initialize();
+	void finalize();
 	RasterizerCanvasGLES3();
 };
 
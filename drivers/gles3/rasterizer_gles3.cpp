@@ -187,6 +187,7 @@ void RasterizerGLES3::initialize() {
 	*/
 
 	print_line("OpenGL ES 3.0 Renderer: " + VisualServer::get_singleton()->get_video_adapter_name());
+	shader_cache = memnew(ShaderCacheGLES3);
 	storage->initialize();
 	canvas->initialize();
 	scene->initialize();
@@ -269,6 +270,16 @@ void RasterizerGLES3::clear_render_target(const Color &p_color) {
 
 	storage->frame.clear_request = true;
 	storage->frame.clear_request_color = p_color;
+	storage->frame.clear_request_rect = Rect2();
+}
+
+void RasterizerGLES3::clear_render_target_rect(const Rect2 &p_rect, const Color &p_color) {
+
+	ERR_FAIL_COND(!storage->frame.current_rt);
+
+	storage->frame.clear_request = true;
+	storage->frame.clear_request_color = p_color;
+	storage->frame.clear_request_rect = p_rect;
 }
 
 void RasterizerGLES3::set_boot_image(const Ref<Image> &p_image, const Color &p_color, bool p_scale, bool p_use_filter) {
@@ -456,6 +467,7 @@ RasterizerGLES3::RasterizerGLES3() {
 	storage->canvas = canvas;
 	scene->storage = storage;
 	storage->scene = scene;
+	shader_cache = NULL;
 
 	time_total = 0;
 	time_scale = 1;
@@ -466,4 +478,7 @@ RasterizerGLES3::~RasterizerGLES3() {
 	memdelete(storage);
 	memdelete(canvas);
 	memdelete(scene);
+	if (shader_cache) {
+		memdelete(shader_cache);
+	}
 }
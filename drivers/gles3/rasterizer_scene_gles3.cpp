@@ -1537,9 +1537,22 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 #endif
 					if (s->index_array_len > 0) {
 
-				glDrawElements(gl_primitive[s->primitive], s->index_array_len, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, 0);
+				int index_array_len = s->index_array_len;
+
+				if (s->lods.size() && !(s->blend_shapes.size() && e->instance->blend_values.size())) {
+					// the LOD is picked per instance, so the array is bound here rather than in _setup_geometry
+					const RasterizerStorageGLES3::Surface::LOD *lod = s->get_lod(e->instance->lod_error);
+					if (lod) {
+						glBindVertexArray(lod->array_id);
+						index_array_len = lod->index_array_len;
+					} else {
+						glBindVertexArray(s->array_id);
+					}
+				}
 
-				storage->info.render.vertices_count += s->index_array_len;
+				glDrawElements(gl_primitive[s->primitive], index_array_len, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, 0);
+
+				storage->info.render.vertices_count += index_array_len;
 
 			} else {
 
@@ -1832,6 +1845,161 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 	}
 }
 
+static bool _rid_vectors_equal(const Vector<RID> &p_a, const Vector<RID> &p_b) {
+
+	int size = p_a.size();
+	if (size != p_b.size()) {
+		return false;
+	}
+
+	const RID *a = p_a.ptr();
+	const RID *b = p_b.ptr();
+	if (a == b) {
+		return true;
+	}
+
+	for (int i = 0; i < size; i++) {
+		if (a[i] != b[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool RasterizerSceneGLES3::RenderList::can_auto_instance(const Element *p_element) {
+
+	const InstanceBase *instance = p_element->instance;
+	if (instance->base_type != VS::INSTANCE_MESH || instance->skeleton.is_valid()) {
+		return false;
+	}
+
+	// Per instance GI data is set up as uniforms, which can't vary inside a draw.
+	if (p_element->sort_key & (SORT_KEY_GI_PROBES_FLAG | SORT_KEY_LIGHTMAP_FLAG | SORT_KEY_LIGHTMAP_CAPTURE_FLAG)) {
+		return false;
+	}
+
+	const RasterizerStorageGLES3::Surface *s = static_cast<const RasterizerStorageGLES3::Surface *>(p_element->geometry);
+	if (s->blend_shapes.size() && instance->blend_values.size()) {
+		return false;
+	}
+
+	return true;
+}
+
+int RasterizerSceneGLES3::RenderList::get_auto_instancing_run(Element *const *p_elements, int p_count, bool p_match_lights) {
+
+	if (p_count < 2 || !can_auto_instance(p_elements[0])) {
+		return 1;
+	}
+
+	const Element *first = p_elements[0];
+	const RasterizerStorageGLES3::Surface::LOD *lod = static_cast<const RasterizerStorageGLES3::Surface *>(first->geometry)->get_lod(first->instance->lod_error);
+	int count = 1;
+	int max_count = MIN(p_count, (int)MAX_AUTO_INSTANCES);
+
+	while (count < max_count) {
+
+		const Element *e = p_elements[count];
+
+		// Same sort key means same shading, culling and depth layer.
+		if (e->geometry != first->geometry || e->material != first->material || e->owner != first->owner || e->sort_key != first->sort_key) {
+			break;
+		}
+
+		if (lod != static_cast<const RasterizerStorageGLES3::Surface *>(e->geometry)->get_lod(e->instance->lod_error)) {
+			break;
+		}
+
+		if (!can_auto_instance(e)) {
+			break;
+		}
+
+		if (e->instance->layer_mask != first->instance->layer_mask || e->instance->baked_light != first->instance->baked_light) {
+			break;
+		}
+
+		if (p_match_lights && (!_rid_vectors_equal(e->instance->light_instances, first->instance->light_instances) || !_rid_vectors_equal(e->instance->reflection_probe_instances, first->instance->reflection_probe_instances))) {
+			break;
+		}
+
+		count++;
+	}
+
+	return count;
+}
+
+void RasterizerSceneGLES3::_setup_auto_instancing(RenderList::Element *const *p_elements, int p_count) {
+
+	RasterizerStorageGLES3::Surface *s = static_cast<RasterizerStorageGLES3::Surface *>(p_elements[0]->geometry);
+
+	// Same layout as a MultiMesh with 3D transforms and no color or custom data.
+	state.auto_instancing_data.resize(p_count * 12);
+	float *data = state.auto_instancing_data.ptr();
+	for (int i = 0; i < p_count; i++) {
+		const Transform &xform = p_elements[i]->instance->transform;
+		float *d = &data[i * 12];
+		d[0] = xform.basis.elements[0][0];
+		d[1] = xform.basis.elements[0][1];
+		d[2] = xform.basis.elements[0][2];
+		d[3] = xform.origin.x;
+		d[4] = xform.basis.elements[1][0];
+		d[5] = xform.basis.elements[1][1];
+		d[6] = xform.basis.elements[1][2];
+		d[7] = xform.origin.y;
+		d[8] = xform.basis.elements[2][0];
+		d[9] = xform.basis.elements[2][1];
+		d[10] = xform.basis.elements[2][2];
+		d[11] = xform.origin.z;
+	}
+
+	const RasterizerStorageGLES3::Surface::LOD *lod = s->get_lod(p_elements[0]->instance->lod_error);
+	glBindVertexArray(lod ? lod->instancing_array_id : s->instancing_array_id);
+
+	glBindBuffer(GL_ARRAY_BUFFER, state.auto_instancing_buffer);
+	// Orphan the previous contents, the driver can hand out new storage instead of stalling.
+	glBufferData(GL_ARRAY_BUFFER, p_count * 12 * sizeof(float), data, GL_STREAM_DRAW);
+
+	int stride = 12 * sizeof(float);
+	glEnableVertexAttribArray(8);
+	glVertexAttribPointer(8, 4, GL_FLOAT, GL_FALSE, stride, NULL);
+	glVertexAttribDivisor(8, 1);
+	glEnableVertexAttribArray(9);
+	glVertexAttribPointer(9, 4, GL_FLOAT, GL_FALSE, stride, CAST_INT_TO_UCHAR_PTR(4 * 4));
+	glVertexAttribDivisor(9, 1);
+	glEnableVertexAttribArray(10);
+	glVertexAttribPointer(10, 4, GL_FLOAT, GL_FALSE, stride, CAST_INT_TO_UCHAR_PTR(8 * 4));
+	glVertexAttribDivisor(10, 1);
+
+	glDisableVertexAttribArray(11);
+	glVertexAttrib4f(11, 1, 1, 1, 1);
+	// Regular meshes see a zero INSTANCE_CUSTOM, keep it that way.
+	glDisableVertexAttribArray(12);
+	glVertexAttrib4f(12, 0, 0, 0, 0);
+}
+
+void RasterizerSceneGLES3::_render_auto_instanced(RenderList::Element *e, int p_count) {
+
+	RasterizerStorageGLES3::Surface *s = static_cast<RasterizerStorageGLES3::Surface *>(e->geometry);
+
+	if (s->index_array_len > 0) {
+
+		// the run shares one LOD, see get_auto_instancing_run()
+		const RasterizerStorageGLES3::Surface::LOD *lod = s->get_lod(e->instance->lod_error);
+		int index_array_len = lod ? lod->index_array_len : s->index_array_len;
+
+		glDrawElementsInstanced(gl_primitive[s->primitive], index_array_len, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, 0, p_count);
+
+		storage->info.render.vertices_count += index_array_len * p_count;
+
+	} else {
+
+		glDrawArraysInstanced(gl_primitive[s->primitive], 0, s->array_len, p_count);
+
+		storage->info.render.vertices_count += s->array_len * p_count;
+	}
+}
+
 void RasterizerSceneGLES3::_setup_light(RenderList::Element *e, const Transform &p_view_transform) {
 
 	int maxobj = state.max_forward_lights_per_object;
@@ -2044,6 +2212,10 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 
 	bool first = true;
 	bool prev_use_instancing = false;
+	bool prev_auto_instanced = false;
+
+	// Draw order matters for alpha, and the wireframe arrays have no instancing variant.
+	bool use_auto_instancing = state.use_auto_instancing && !p_alpha_pass && state.debug_draw != VS::VIEWPORT_DEBUG_DRAW_WIREFRAME;
 
 	storage->info.render.draw_call_count += p_element_count;
 	bool prev_opaque_prepass = false;
@@ -2198,7 +2370,13 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 			rebind = true;
 		}
 
-		bool use_instancing = e->instance->base_type == VS::INSTANCE_MULTIMESH || e->instance->base_type == VS::INSTANCE_PARTICLES;
+		int auto_instances = 1;
+		if (use_auto_instancing) {
+			bool match_lights = !p_shadow && !p_directional_add && !(e->sort_key & SORT_KEY_UNSHADED_FLAG);
+			auto_instances = RenderList::get_auto_instancing_run(&p_elements[i], p_element_count - i, match_lights);
+		}
+
+		bool use_instancing = e->instance->base_type == VS::INSTANCE_MULTIMESH || e->instance->base_type == VS::INSTANCE_PARTICLES || auto_instances > 1;
 
 		if (use_instancing != prev_use_instancing) {
 			state.scene_shader.set_conditional(SceneShaderGLES3::USE_INSTANCING, use_instancing);
@@ -2228,11 +2406,28 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 			}
 		}
 
+		if (!state.scene_shader.is_version_valid()) {
+			// Still compiling in the background (or failed to compile), skip the draw
+			// instead of drawing with whatever program is bound.
+			prev_material = material;
+			prev_shading = shading;
+			prev_skeleton = skeleton;
+			prev_use_instancing = use_instancing;
+			prev_opaque_prepass = use_opaque_prepass;
+			first = false;
+			i += auto_instances - 1;
+			continue;
+		}
+
 		if (!(e->sort_key & SORT_KEY_UNSHADED_FLAG) && !p_directional_add && !p_shadow) {
 			_setup_light(e, p_view_transform);
 		}
 
-		if (e->owner != prev_owner || prev_base_type != e->instance->base_type || prev_geometry != e->geometry) {
+		if (auto_instances > 1) {
+
+			_setup_auto_instancing(&p_elements[i], auto_instances);
+			storage->info.render.surface_switch_count++;
+		} else if (e->owner != prev_owner || prev_base_type != e->instance->base_type || prev_geometry != e->geometry || prev_auto_instanced) {
 
 			_setup_geometry(e, p_view_transform);
 			storage->info.render.surface_switch_count++;
@@ -2240,14 +2435,25 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 
 		_set_cull(e->sort_key & RenderList::SORT_KEY_MIRROR_FLAG, e->sort_key & RenderList::SORT_KEY_CULL_DISABLED_FLAG, p_reverse_cull);
 
-		state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, e->instance->transform);
+		if (auto_instances > 1) {
+
+			// Instance transforms come from the instance buffer.
+			state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, Transform());
+			_render_auto_instanced(e, auto_instances);
+
+			storage->info.render.draw_call_count -= auto_instances - 1;
+			i += auto_instances - 1;
+		} else {
 
-		_render_geometry(e);
+			state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, e->instance->transform);
+			_render_geometry(e);
+		}
 
 		prev_material = material;
 		prev_base_type = e->instance->base_type;
 		prev_geometry = e->geometry;
 		prev_owner = e->owner;
+		prev_auto_instanced = auto_instances > 1;
 		prev_shading = shading;
 		prev_skeleton = skeleton;
 		prev_use_instancing = use_instancing;
@@ -5294,6 +5500,20 @@ void RasterizerSceneGLES3::initialize() {
 		glGenVertexArrays(1, &state.immediate_array);
 	}
 
+	state.use_auto_instancing = GLOBAL_GET("rendering/batching/options/use_auto_instancing");
+	glGenBuffers(1, &state.auto_instancing_buffer);
+
+	{
+		// Compiling in the background needs a way to ask whether the driver is done without blocking.
+		bool parallel_compile_supported = storage->config.extensions.has("GL_KHR_parallel_shader_compile") || storage->config.extensions.has("GL_ARB_parallel_shader_compile");
+		bool async_compile = int(GLOBAL_GET("rendering/gles3/shaders/shader_compilation_mode")) == 1;
+		if (async_compile && !parallel_compile_supported) {
+			print_verbose("Asynchronous shader compilation requires KHR_parallel_shader_compile, falling back to synchronous.");
+			async_compile = false;
+		}
+		state.scene_shader.set_async_compile(async_compile);
+	}
+
 #ifdef GLES_OVER_GL
 	//"desktop" opengl needs this.
 	glEnable(GL_PROGRAM_POINT_SIZE);
@@ -5371,6 +5591,8 @@ void RasterizerSceneGLES3::iteration() {
 	storage->config.use_lightmap_filter_bicubic = GLOBAL_GET("rendering/quality/lightmapping/use_bicubic_sampling");
 	state.scene_shader.set_conditional(SceneShaderGLES3::USE_LIGHTMAP_FILTER_BICUBIC, storage->config.use_lightmap_filter_bicubic);
 	state.scene_shader.set_conditional(SceneShaderGLES3::VCT_QUALITY_HIGH, GLOBAL_GET("rendering/quality/voxel_cone_tracing/high_quality"));
+
+	state.scene_shader.update_pending_compiles();
 }
 
 void RasterizerSceneGLES3::finalize() {
@@ -34,6 +34,8 @@
 /* Must come before shaders or the Windows build fails... */
 #include "rasterizer_storage_gles3.h"
 
+#include "core/radix_sort.h"
+
 #include "drivers/gles3/shaders/cube_to_dp.glsl.gen.h"
 #include "drivers/gles3/shaders/effect_blur.glsl.gen.h"
 #include "drivers/gles3/shaders/exposure.glsl.gen.h"
@@ -183,6 +185,10 @@ public:
 		GLuint immediate_buffer;
 		GLuint immediate_array;
 
+		bool use_auto_instancing;
+		GLuint auto_instancing_buffer;
+		LocalVector<float> auto_instancing_data;
+
 		uint32_t ubo_light_size;
 		uint8_t *spot_array_tmp;
 		uint8_t *omni_array_tmp;
@@ -729,65 +735,68 @@ public:
 			alpha_element_count = 0;
 		}
 
-		//should eventually be replaced by radix
+		// Sorted with a radix sort over keys packed next to the element pointers,
+		// so elements are only dereferenced once per sort.
+		RadixSort<Element *> sorter;
 
 		struct SortByKey {
 
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				return A->sort_key < B->sort_key;
+			_FORCE_INLINE_ uint64_t operator()(const Element *A) const {
+				return A->sort_key;
 			}
 		};
 
 		void sort_by_key(bool p_alpha) {
 
-			SortArray<Element *, SortByKey> sorter;
 			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
+				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count, SortByKey());
 			} else {
-				sorter.sort(elements, element_count);
+				sorter.sort(elements, element_count, SortByKey());
 			}
 		}
 
 		struct SortByDepth {
 
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				return A->instance->depth < B->instance->depth;
+			_FORCE_INLINE_ uint64_t operator()(const Element *A) const {
+				return RadixSort<Element *>::float_to_key(A->instance->depth);
 			}
 		};
 
 		void sort_by_depth(bool p_alpha) { //used for shadows
 
-			SortArray<Element *, SortByDepth> sorter;
 			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
+				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count, SortByDepth());
 			} else {
-				sorter.sort(elements, element_count);
+				sorter.sort(elements, element_count, SortByDepth());
 			}
 		}
 
 		struct SortByReverseDepthAndPriority {
 
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				uint32_t layer_A = uint32_t(A->sort_key >> SORT_KEY_PRIORITY_SHIFT);
-				uint32_t layer_B = uint32_t(B->sort_key >> SORT_KEY_PRIORITY_SHIFT);
-				if (layer_A == layer_B) {
-					return A->instance->depth > B->instance->depth;
-				} else {
-					return layer_A < layer_B;
-				}
+			_FORCE_INLINE_ uint64_t operator()(const Element *A) const {
+				uint64_t layer = A->sort_key >> SORT_KEY_PRIORITY_SHIFT;
+				uint32_t reverse_depth = ~RadixSort<Element *>::float_to_key(A->instance->depth);
+				return (layer << 32) | reverse_depth;
 			}
 		};
 
 		void sort_by_reverse_depth_and_priority(bool p_alpha) { //used for alpha
 
-			SortArray<Element *, SortByReverseDepthAndPriority> sorter;
 			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
+				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count, SortByReverseDepthAndPriority());
 			} else {
-				sorter.sort(elements, element_count);
+				sorter.sort(elements, element_count, SortByReverseDepthAndPriority());
 			}
 		}
 
+		// Runs of plain mesh elements that can be drawn with a single instanced draw.
+		enum {
+			MAX_AUTO_INSTANCES = 1024,
+		};
+
+		static bool can_auto_instance(const Element *p_element);
+		static int get_auto_instancing_run(Element *const *p_elements, int p_count, bool p_match_lights);
+
 		_FORCE_INLINE_ Element *add_element() {
 
 			if (element_count + alpha_element_count >= max_elements)
@@ -840,6 +849,8 @@ public:
 	_FORCE_INLINE_ bool _setup_material(RasterizerStorageGLES3::Material *p_material, bool p_depth_pass, bool p_alpha_pass);
 	_FORCE_INLINE_ void _setup_geometry(RenderList::Element *e, const Transform &p_view_transform);
 	_FORCE_INLINE_ void _render_geometry(RenderList::Element *e);
+	void _setup_auto_instancing(RenderList::Element *const *p_elements, int p_count);
+	void _render_auto_instanced(RenderList::Element *e, int p_count);
 	void _setup_light(RenderList::Element *e, const Transform &p_view_transform);
 
 	void _render_list(RenderList::Element **p_elements, int p_element_count, const Transform &p_view_transform, const CameraMatrix &p_projection, RasterizerStorageGLES3::Sky *p_sky, bool p_reverse_cull, bool p_alpha_pass, bool p_shadow, bool p_directional_add, bool p_directional_shadows);
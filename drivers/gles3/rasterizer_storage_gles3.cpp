@@ -2429,6 +2429,7 @@ void RasterizerStorageGLES3::_update_shader(Shader *p_shader) const {
 	}
 
 	p_shader->shader->set_custom_shader_code(p_shader->custom_code_id, gen_code.vertex, gen_code.vertex_global, gen_code.fragment, gen_code.light, gen_code.fragment_global, gen_code.uniforms, gen_code.texture_uniforms, gen_code.defines);
+	p_shader->shader->prewarm_custom_shader(p_shader->custom_code_id);
 
 	p_shader->ubo_size = gen_code.uniform_total_size;
 	p_shader->ubo_offsets = gen_code.uniform_offsets;
@@ -4213,6 +4214,98 @@ Vector<AABB> RasterizerStorageGLES3::mesh_surface_get_skeleton_aabb(RID p_mesh,
 	return mesh->surfaces[p_surface]->skeleton_bone_aabb;
 }
 
+void RasterizerStorageGLES3::_mesh_surface_clear_lods(Surface *p_surface) {
+
+	for (int i = 0; i < p_surface->lods.size(); i++) {
+
+		const Surface::LOD &lod = p_surface->lods[i];
+		glDeleteBuffers(1, &lod.index_id);
+		glDeleteVertexArrays(1, &lod.array_id);
+		glDeleteVertexArrays(1, &lod.instancing_array_id);
+
+		p_surface->total_data_size -= lod.index_array_len * p_surface->attribs[VS::ARRAY_INDEX].stride;
+		info.vertex_mem -= lod.index_array_len * p_surface->attribs[VS::ARRAY_INDEX].stride;
+	}
+
+	p_surface->lods.clear();
+}
+
+void RasterizerStorageGLES3::mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<float> &p_errors, const Vector<PoolVector<uint8_t> > &p_index_arrays) {
+
+	Mesh *mesh = mesh_owner.getornull(p_mesh);
+	ERR_FAIL_COND(!mesh);
+	ERR_FAIL_INDEX(p_surface, mesh->surfaces.size());
+	ERR_FAIL_COND(p_errors.size() != p_index_arrays.size());
+
+	Surface *surface = mesh->surfaces[p_surface];
+
+	_mesh_surface_clear_lods(surface);
+
+	if (!surface->index_id) {
+		ERR_FAIL_COND_MSG(p_errors.size(), "Mesh LODs require an index array.");
+		return;
+	}
+
+	int index_stride = surface->attribs[VS::ARRAY_INDEX].stride;
+
+	for (int i = 0; i < p_errors.size(); i++) {
+
+		ERR_CONTINUE(p_index_arrays[i].size() == 0 || p_index_arrays[i].size() % index_stride != 0);
+		ERR_CONTINUE(i > 0 && p_errors[i] < p_errors[i - 1]);
+
+		Surface::LOD lod;
+		lod.error = p_errors[i];
+		lod.index_array_len = p_index_arrays[i].size() / index_stride;
+
+		PoolVector<uint8_t>::Read ir = p_index_arrays[i].read();
+
+		glGenBuffers(1, &lod.index_id);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lod.index_id);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, p_index_arrays[i].size(), ir.ptr(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); //unbind
+
+		for (int ai = 0; ai < 2; ai++) {
+
+			if (ai == 0) {
+				//for normal draw
+				glGenVertexArrays(1, &lod.array_id);
+				glBindVertexArray(lod.array_id);
+				glBindBuffer(GL_ARRAY_BUFFER, surface->vertex_id);
+			} else if (ai == 1) {
+				//for instancing draw (can be changed and no one cares)
+				glGenVertexArrays(1, &lod.instancing_array_id);
+				glBindVertexArray(lod.instancing_array_id);
+				glBindBuffer(GL_ARRAY_BUFFER, surface->vertex_id);
+			}
+
+			for (int j = 0; j < VS::ARRAY_MAX - 1; j++) {
+
+				const Surface::Attrib &attrib = surface->attribs[j];
+				if (!attrib.enabled)
+					continue;
+
+				if (attrib.integer) {
+					glVertexAttribIPointer(attrib.index, attrib.size, attrib.type, attrib.stride, CAST_INT_TO_UCHAR_PTR(attrib.offset));
+				} else {
+					glVertexAttribPointer(attrib.index, attrib.size, attrib.type, attrib.normalized, attrib.stride, CAST_INT_TO_UCHAR_PTR(attrib.offset));
+				}
+				glEnableVertexAttribArray(attrib.index);
+			}
+
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lod.index_id);
+
+			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		}
+
+		surface->total_data_size += p_index_arrays[i].size();
+		info.vertex_mem += p_index_arrays[i].size();
+
+		surface->lods.push_back(lod);
+	}
+}
+
 void RasterizerStorageGLES3::mesh_remove_surface(RID p_mesh, int p_surface) {
 
 	Mesh *mesh = mesh_owner.getornull(p_mesh);
@@ -4245,6 +4338,8 @@ void RasterizerStorageGLES3::mesh_remove_surface(RID p_mesh, int p_surface) {
 		glDeleteVertexArrays(1, &surface->instancing_array_wireframe_id);
 	}
 
+	_mesh_surface_clear_lods(surface);
+
 	info.vertex_mem -= surface->total_data_size;
 
 	memdelete(surface);
@@ -5447,6 +5542,43 @@ Transform RasterizerStorageGLES3::skeleton_bone_get_transform(RID p_skeleton, in
 
 	return ret;
 }
+void RasterizerStorageGLES3::skeleton_set_bone_transforms(RID p_skeleton, const Vector<Transform> &p_transforms) {
+
+	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
+
+	ERR_FAIL_COND(!skeleton);
+	ERR_FAIL_COND(p_transforms.size() > skeleton->size);
+	ERR_FAIL_COND(skeleton->use_2d);
+
+	float *texture = skeleton->skel_texture.ptrw();
+	const Transform *transforms = p_transforms.ptr();
+
+	for (int i = 0; i < p_transforms.size(); i++) {
+
+		const Transform &xform = transforms[i];
+		float *row = &texture[((i / 256) * 256) * 3 * 4 + (i % 256) * 4];
+
+		row[0] = xform.basis[0].x;
+		row[1] = xform.basis[0].y;
+		row[2] = xform.basis[0].z;
+		row[3] = xform.origin.x;
+		row += 256 * 4;
+		row[0] = xform.basis[1].x;
+		row[1] = xform.basis[1].y;
+		row[2] = xform.basis[1].z;
+		row[3] = xform.origin.y;
+		row += 256 * 4;
+		row[0] = xform.basis[2].x;
+		row[1] = xform.basis[2].y;
+		row[2] = xform.basis[2].z;
+		row[3] = xform.origin.z;
+	}
+
+	if (!skeleton->update_list.in_list()) {
+		skeleton_update_list.add(&skeleton->update_list);
+	}
+}
+
 void RasterizerStorageGLES3::skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) {
 
 	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
@@ -8399,6 +8531,12 @@ uint64_t RasterizerStorageGLES3::get_render_info(VS::RenderInfo p_info) {
 			return info.texture_mem;
 		case VS::INFO_VERTEX_MEM_USED:
 			return info.vertex_mem;
+		case VS::INFO_SHADER_COMPILES_IN_PROGRESS:
+			return ShaderGLES3::get_pending_compile_count();
+		case VS::INFO_SHADER_COMPILER_CACHE_HITS:
+			return shaders.compiler.get_cache_hits();
+		case VS::INFO_SHADER_COMPILER_CACHE_MISSES:
+			return shaders.compiler.get_cache_misses();
 		default:
 			return 0; //no idea either
 	}
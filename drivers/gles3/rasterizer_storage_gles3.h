@@ -687,6 +687,29 @@ public:
 
 		Vector<BlendShape> blend_shapes;
 
+		// simplified index arrays drawn from the same vertex buffer, by increasing error
+		struct LOD {
+			float error;
+			GLuint index_id;
+			GLuint array_id;
+			GLuint instancing_array_id;
+			int index_array_len;
+		};
+
+		Vector<LOD> lods;
+
+		// coarsest LOD whose error stays under p_max_error, NULL for the full index array
+		_FORCE_INLINE_ const LOD *get_lod(float p_max_error) const {
+			const LOD *lod = NULL;
+			for (int i = 0; i < lods.size(); i++) {
+				if (lods[i].error > p_max_error) {
+					break;
+				}
+				lod = &lods[i];
+			}
+			return lod;
+		}
+
 		AABB aabb;
 
 		int array_len;
@@ -789,6 +812,9 @@ public:
 	virtual Vector<PoolVector<uint8_t> > mesh_surface_get_blend_shapes(RID p_mesh, int p_surface) const;
 	virtual Vector<AABB> mesh_surface_get_skeleton_aabb(RID p_mesh, int p_surface) const;
 
+	void _mesh_surface_clear_lods(Surface *p_surface);
+	virtual void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<float> &p_errors, const Vector<PoolVector<uint8_t> > &p_index_arrays);
+
 	virtual void mesh_remove_surface(RID p_mesh, int p_surface);
 	virtual int mesh_get_surface_count(RID p_mesh) const;
 
@@ -950,6 +976,7 @@ public:
 	virtual int skeleton_get_bone_count(RID p_skeleton) const;
 	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform);
 	virtual Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const;
+	virtual void skeleton_set_bone_transforms(RID p_skeleton, const Vector<Transform> &p_transforms);
 	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform);
 	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const;
 	virtual void skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform);
@@ -1507,6 +1534,7 @@ public:
 
 		bool clear_request;
 		Color clear_request_color;
+		Rect2 clear_request_rect; // empty for the whole render target
 		float time[4];
 		float delta;
 		uint64_t count;
@@ -0,0 +1,398 @@
+/*************************************************************************/
+/*  shader_cache_gles3.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "shader_cache_gles3.h"
+
+#include "core/crypto/crypto_core.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/project_settings.h"
+
+static const uint8_t entry_magic[4] = { 'G', 'S', 'C', 'E' };
+
+ShaderCacheGLES3 *ShaderCacheGLES3::singleton = NULL;
+
+String ShaderCacheGLES3::hash_program(const String &p_name, const Vector<const char *> &p_vertex_strings, const Vector<const char *> &p_fragment_strings) const {
+
+	CryptoCore::SHA256Context ctx;
+	ctx.start();
+
+	CharString name = p_name.utf8();
+	ctx.update((const uint8_t *)name.get_data(), name.length());
+	CharString driver = driver_info.utf8();
+	ctx.update((const uint8_t *)driver.get_data(), driver.length());
+
+	// The stages are separated by a byte that can't appear in shader code.
+	static const uint8_t separator = 0;
+
+	for (int i = 0; i < p_vertex_strings.size(); i++) {
+		ctx.update((const uint8_t *)p_vertex_strings[i], strlen(p_vertex_strings[i]));
+	}
+	ctx.update(&separator, 1);
+	for (int i = 0; i < p_fragment_strings.size(); i++) {
+		ctx.update((const uint8_t *)p_fragment_strings[i], strlen(p_fragment_strings[i]));
+	}
+
+	unsigned char hash[32];
+	ctx.finish(hash);
+	return String::hex_encode_buffer(hash, 32);
+}
+
+bool ShaderCacheGLES3::_read_entry(const String &p_path, uint32_t &r_tag, Vector<uint8_t> &r_data) {
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	if (!f) {
+		return false;
+	}
+
+	bool valid = false;
+
+	uint8_t magic[4];
+	if (f->get_buffer(magic, 4) == 4 && memcmp(magic, entry_magic, 4) == 0 && f->get_32() == CACHE_FORMAT_VERSION) {
+
+		r_tag = f->get_32();
+		uint32_t length = f->get_32();
+		uint8_t checksum[32];
+		f->get_buffer(checksum, 32);
+
+		// A truncated or padded file is treated as corrupt.
+		if (length > 0 && f->get_position() + length == f->get_len()) {
+
+			r_data.resize(length);
+			if (f->get_buffer(r_data.ptrw(), length) == length) {
+
+				unsigned char hash[32];
+				CryptoCore::sha256(r_data.ptr(), length, hash);
+				valid = memcmp(hash, checksum, 32) == 0;
+			}
+		}
+	}
+
+	memdelete(f);
+
+	if (!valid) {
+		_remove_entry(p_path);
+	}
+
+	return valid;
+}
+
+bool ShaderCacheGLES3::_write_entry(const String &p_path, uint32_t p_tag, const uint8_t *p_data, uint32_t p_size) {
+
+	unsigned char checksum[32];
+	CryptoCore::sha256(p_data, p_size, checksum);
+
+	// Write to a temporary file and move it into place, so a crash or full disk
+	// never leaves a partially written entry behind.
+	String tmp_path = p_path + ".tmp";
+
+	FileAccess *f = FileAccess::open(tmp_path, FileAccess::WRITE);
+	if (!f) {
+		return false;
+	}
+
+	f->store_buffer(entry_magic, 4);
+	f->store_32(CACHE_FORMAT_VERSION);
+	f->store_32(p_tag);
+	f->store_32(p_size);
+	f->store_buffer(checksum, 32);
+	f->store_buffer(p_data, p_size);
+	bool ok = f->get_error() == OK;
+	memdelete(f);
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	if (!ok || da->rename(tmp_path, p_path) != OK) {
+		da->remove(tmp_path);
+		ok = false;
+	} else {
+		storage_size += p_size + 48;
+	}
+	memdelete(da);
+
+	if (storage_size > storage_size_limit) {
+		_purge_excess();
+	}
+
+	return ok;
+}
+
+void ShaderCacheGLES3::_remove_entry(const String &p_path) {
+
+	// Either corrupt or rejected by the driver, it will be regenerated and overwritten.
+	print_verbose("Discarding invalid shader cache entry: " + p_path);
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	da->remove(p_path);
+	memdelete(da);
+}
+
+bool ShaderCacheGLES3::retrieve(const String &p_program_hash, GLuint p_program) {
+
+	if (!supported) {
+		return false;
+	}
+
+	String path = storage_path.plus_file(p_program_hash + ".bin");
+	uint32_t format = 0;
+	Vector<uint8_t> data;
+	if (!_read_entry(path, format, data)) {
+		return false;
+	}
+
+	glProgramBinary(p_program, format, data.ptr(), data.size());
+
+	GLint status = GL_FALSE;
+	glGetProgramiv(p_program, GL_LINK_STATUS, &status);
+	if (status != GL_TRUE) {
+		_remove_entry(path);
+		return false;
+	}
+
+	return true;
+}
+
+void ShaderCacheGLES3::store(const String &p_program_hash, GLuint p_program) {
+
+	if (!supported) {
+		return;
+	}
+
+	GLint length = 0;
+	glGetProgramiv(p_program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0) {
+		return;
+	}
+
+	Vector<uint8_t> data;
+	data.resize(length);
+	GLenum format = 0;
+	GLsizei written = 0;
+	glGetProgramBinary(p_program, length, &written, &format, data.ptrw());
+	if (written <= 0) {
+		return;
+	}
+
+	_write_entry(storage_path.plus_file(p_program_hash + ".bin"), format, data.ptr(), written);
+}
+
+bool ShaderCacheGLES3::retrieve_data(const String &p_name, PoolVector<uint8_t> &r_data) {
+
+	if (!enabled) {
+		return false;
+	}
+
+	uint32_t tag = 0;
+	Vector<uint8_t> data;
+	if (!_read_entry(storage_path.plus_file(p_name + ".dat"), tag, data)) {
+		return false;
+	}
+
+	r_data.resize(data.size());
+	PoolVector<uint8_t>::Write w = r_data.write();
+	memcpy(w.ptr(), data.ptr(), data.size());
+	return true;
+}
+
+void ShaderCacheGLES3::store_data(const String &p_name, const PoolVector<uint8_t> &p_data) {
+
+	if (!enabled || p_data.size() == 0) {
+		return;
+	}
+
+	PoolVector<uint8_t>::Read r = p_data.read();
+	_write_entry(storage_path.plus_file(p_name + ".dat"), 0, r.ptr(), p_data.size());
+}
+
+Set<uint32_t> &ShaderCacheGLES3::_get_variants(const String &p_key) {
+
+	Set<uint32_t> *existing = variants.getptr(p_key);
+	if (existing) {
+		return *existing;
+	}
+
+	Set<uint32_t> &set = variants[p_key];
+
+	FileAccess *f = FileAccess::open(storage_path.plus_file(p_key + ".variants"), FileAccess::READ);
+	if (f) {
+		uint64_t count = f->get_len() / 4;
+		for (uint64_t i = 0; i < count; i++) {
+			set.insert(f->get_32());
+		}
+		memdelete(f);
+	}
+
+	return set;
+}
+
+void ShaderCacheGLES3::record_variant(const String &p_key, uint32_t p_version) {
+
+	if (!enabled) {
+		return;
+	}
+
+	Set<uint32_t> &set = _get_variants(p_key);
+	if (set.has(p_version)) {
+		return;
+	}
+	set.insert(p_version);
+
+	String path = storage_path.plus_file(p_key + ".variants");
+	FileAccess *f = FileAccess::open(path, FileAccess::READ_WRITE);
+	if (!f) {
+		f = FileAccess::open(path, FileAccess::WRITE);
+	}
+	if (f) {
+		f->seek_end();
+		f->store_32(p_version);
+		memdelete(f);
+	}
+}
+
+Vector<uint32_t> ShaderCacheGLES3::get_recorded_variants(const String &p_key) {
+
+	Vector<uint32_t> ret;
+	if (!enabled) {
+		return ret;
+	}
+
+	Set<uint32_t> &set = _get_variants(p_key);
+	for (Set<uint32_t>::Element *E = set.front(); E; E = E->next()) {
+		ret.push_back(E->get());
+	}
+	return ret;
+}
+
+struct ShaderCacheFile {
+
+	String name;
+	uint64_t modified_time;
+	uint64_t size;
+
+	bool operator<(const ShaderCacheFile &p_other) const { return modified_time < p_other.modified_time; }
+};
+
+void ShaderCacheGLES3::_purge_excess() {
+
+	DirAccess *da = DirAccess::open(storage_path);
+	if (!da) {
+		return;
+	}
+
+	Vector<ShaderCacheFile> files;
+	storage_size = 0;
+
+	da->list_dir_begin();
+	String name = da->get_next();
+	while (name != String()) {
+		if (!da->current_is_dir()) {
+			String path = storage_path.plus_file(name);
+			FileAccess *f = FileAccess::open(path, FileAccess::READ);
+			if (f) {
+				ShaderCacheFile file;
+				file.name = name;
+				file.modified_time = FileAccess::get_modified_time(path);
+				file.size = f->get_len();
+				storage_size += file.size;
+				files.push_back(file);
+				memdelete(f);
+			}
+		}
+		name = da->get_next();
+	}
+	da->list_dir_end();
+
+	if (storage_size > storage_size_limit) {
+		// Evict the oldest entries, leaving some headroom so this does not run on every store.
+		files.sort();
+		uint64_t target = storage_size_limit - storage_size_limit / 4;
+		for (int i = 0; i < files.size() && storage_size > target; i++) {
+			if (da->remove(files[i].name) == OK) {
+				storage_size -= files[i].size;
+				variants.erase(files[i].name.get_basename());
+			}
+		}
+	}
+
+	memdelete(da);
+}
+
+ShaderCacheGLES3::ShaderCacheGLES3() {
+
+	singleton = this;
+
+	enabled = false;
+	supported = false;
+	storage_size = 0;
+	storage_size_limit = uint64_t(MAX(1, int(GLOBAL_GET("rendering/gles3/shaders/shader_cache_size_mb")))) * 1024 * 1024;
+	prewarm = GLOBAL_GET("rendering/gles3/shaders/prewarm_recorded_variants");
+
+	if (!GLOBAL_GET("rendering/gles3/shaders/use_shader_cache")) {
+		return;
+	}
+
+	storage_path = "user://shader_cache/gles3";
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	enabled = da->dir_exists(storage_path) || da->make_dir_recursive(storage_path) == OK;
+	memdelete(da);
+
+	if (!enabled) {
+		ERR_PRINT("Couldn't create shader cache directory, shader cache disabled.");
+		return;
+	}
+
+	_purge_excess();
+
+#if defined(GLAD_ENABLED)
+	supported = GLAD_GL_ARB_get_program_binary;
+#elif defined(GLES_OVER_GL)
+	supported = false;
+#else
+	supported = true;
+#endif
+
+	if (supported) {
+		// Some drivers expose the entry points but support no binary formats at all.
+		GLint format_count = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+		supported = format_count > 0;
+	}
+
+	if (!supported) {
+		print_verbose("Shader cache: program binaries not supported by the driver.");
+		return;
+	}
+
+	driver_info = String((const char *)glGetString(GL_VENDOR)) + "|" + String((const char *)glGetString(GL_RENDERER)) + "|" + String((const char *)glGetString(GL_VERSION));
+}
+
+ShaderCacheGLES3::~ShaderCacheGLES3() {
+
+	singleton = NULL;
+}
@@ -0,0 +1,102 @@
+/*************************************************************************/
+/*  shader_cache_gles3.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SHADER_CACHE_GLES3_H
+#define SHADER_CACHE_GLES3_H
+
+#include "core/hash_map.h"
+#include "core/pool_vector.h"
+#include "core/set.h"
+#include "core/ustring.h"
+
+#include "platform_config.h"
+#ifndef GLES3_INCLUDE_H
+#include <GLES3/gl3.h>
+#else
+#include GLES3_INCLUDE_H
+#endif
+
+// Persistent cache of linked program binaries, stored in the user data
+// directory. Entries are keyed by a hash of the full shader source plus the
+// driver identification strings, so a driver update simply misses the cache.
+// It also records which variants of a custom shader were used, so they can be
+// compiled (or loaded) ahead of time on the next run, and stores arbitrary
+// data entries for the shader compiler output cache.
+
+class ShaderCacheGLES3 {
+
+	enum {
+		CACHE_FORMAT_VERSION = 1,
+	};
+
+	static ShaderCacheGLES3 *singleton;
+
+	bool enabled;
+	bool supported;
+	bool prewarm;
+	String storage_path;
+	String driver_info;
+	uint64_t storage_size;
+	uint64_t storage_size_limit;
+
+	HashMap<String, Set<uint32_t> > variants;
+
+	bool _read_entry(const String &p_path, uint32_t &r_tag, Vector<uint8_t> &r_data);
+	bool _write_entry(const String &p_path, uint32_t p_tag, const uint8_t *p_data, uint32_t p_size);
+	void _remove_entry(const String &p_path);
+	void _purge_excess();
+	Set<uint32_t> &_get_variants(const String &p_key);
+
+public:
+	_FORCE_INLINE_ static ShaderCacheGLES3 *get_singleton() { return singleton; }
+
+	// Whether the cache directory is usable at all.
+	_FORCE_INLINE_ bool is_enabled() const { return enabled; }
+	// Whether program binaries can be cached with this driver.
+	_FORCE_INLINE_ bool is_supported() const { return supported; }
+	_FORCE_INLINE_ bool is_prewarm_enabled() const { return enabled && prewarm; }
+
+	String hash_program(const String &p_name, const Vector<const char *> &p_vertex_strings, const Vector<const char *> &p_fragment_strings) const;
+
+	// Loads the binary into the (empty) program, returns false on a miss or if it failed to link.
+	bool retrieve(const String &p_program_hash, GLuint p_program);
+	void store(const String &p_program_hash, GLuint p_program);
+
+	bool retrieve_data(const String &p_name, PoolVector<uint8_t> &r_data);
+	void store_data(const String &p_name, const PoolVector<uint8_t> &p_data);
+
+	void record_variant(const String &p_key, uint32_t p_version);
+	Vector<uint32_t> get_recorded_variants(const String &p_key);
+
+	ShaderCacheGLES3();
+	~ShaderCacheGLES3();
+};
+
+#endif // SHADER_CACHE_GLES3_H
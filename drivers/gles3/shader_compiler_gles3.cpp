@@ -30,8 +30,11 @@
 
 #include "shader_compiler_gles3.h"
 
+#include "core/io/stream_peer.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
+#include "core/version.h"
+#include "shader_cache_gles3.h"
 
 #define SL ShaderLanguage
 
@@ -834,7 +837,7 @@ String ShaderCompilerGLES3::_dump_node_code(SL::Node *p_node, int p_level, Gener
 	return code;
 }
 
-Error ShaderCompilerGLES3::compile(VS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+Error ShaderCompilerGLES3::_compile(VS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
 
 	Error err = parser.compile(p_code, ShaderTypes::get_singleton()->get_functions(p_mode), ShaderTypes::get_singleton()->get_modes(p_mode), ShaderTypes::get_singleton()->get_types());
 
@@ -875,6 +878,326 @@ Error ShaderCompilerGLES3::compile(VS::ShaderMode p_mode, const String &p_code,
 	return OK;
 }
 
+Error ShaderCompilerGLES3::_compile_and_record(VS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, CompileCacheEntry &r_entry) {
+
+	// Compile against local targets, so the effects on the caller's flags can be replayed on cache hits.
+	IdentifierActions recording;
+	Map<int *, int> value_slots;
+	Map<StringName, bool> render_mode_flags;
+	Map<StringName, bool> usage_flags;
+	Map<StringName, bool> write_flags;
+
+	for (Map<StringName, Pair<int *, int> >::Element *E = p_actions->render_mode_values.front(); E; E = E->next()) {
+		Map<int *, int>::Element *slot = value_slots.find(E->get().first);
+		if (!slot) {
+			slot = value_slots.insert(E->get().first, INT32_MIN);
+		}
+		recording.render_mode_values[E->key()] = Pair<int *, int>(&slot->get(), E->get().second);
+	}
+	for (Map<StringName, bool *>::Element *E = p_actions->render_mode_flags.front(); E; E = E->next()) {
+		recording.render_mode_flags[E->key()] = &render_mode_flags.insert(E->key(), false)->get();
+	}
+	for (Map<StringName, bool *>::Element *E = p_actions->usage_flag_pointers.front(); E; E = E->next()) {
+		recording.usage_flag_pointers[E->key()] = &usage_flags.insert(E->key(), false)->get();
+	}
+	for (Map<StringName, bool *>::Element *E = p_actions->write_flag_pointers.front(); E; E = E->next()) {
+		recording.write_flag_pointers[E->key()] = &write_flags.insert(E->key(), false)->get();
+	}
+	recording.uniforms = &r_entry.uniforms;
+
+	Error err = _compile(p_mode, p_code, &recording, p_path, r_entry.gen_code);
+	if (err != OK) {
+		return err;
+	}
+
+	// Several render modes can share a target (e.g. the blend modes), only its final value matters.
+	Set<int *> recorded_slots;
+	for (Map<StringName, Pair<int *, int> >::Element *E = p_actions->render_mode_values.front(); E; E = E->next()) {
+		int value = value_slots[E->get().first];
+		if (value != INT32_MIN && !recorded_slots.has(E->get().first)) {
+			r_entry.render_mode_values.push_back(Pair<StringName, int>(E->key(), value));
+			recorded_slots.insert(E->get().first);
+		}
+	}
+	for (Map<StringName, bool>::Element *E = render_mode_flags.front(); E; E = E->next()) {
+		if (E->get()) {
+			r_entry.render_mode_flags.push_back(E->key());
+		}
+	}
+	for (Map<StringName, bool>::Element *E = usage_flags.front(); E; E = E->next()) {
+		if (E->get()) {
+			r_entry.usage_flags.push_back(E->key());
+		}
+	}
+	for (Map<StringName, bool>::Element *E = write_flags.front(); E; E = E->next()) {
+		if (E->get()) {
+			r_entry.write_flags.push_back(E->key());
+		}
+	}
+
+	return OK;
+}
+
+void ShaderCompilerGLES3::_apply_cache_entry(const CompileCacheEntry &p_entry, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+
+	r_gen_code = p_entry.gen_code;
+
+	if (p_actions->uniforms) {
+		for (const Map<StringName, SL::ShaderNode::Uniform>::Element *E = p_entry.uniforms.front(); E; E = E->next()) {
+			p_actions->uniforms->insert(E->key(), E->get());
+		}
+	}
+
+	for (int i = 0; i < p_entry.render_mode_values.size(); i++) {
+		Map<StringName, Pair<int *, int> >::Element *E = p_actions->render_mode_values.find(p_entry.render_mode_values[i].first);
+		if (E) {
+			*E->get().first = p_entry.render_mode_values[i].second;
+		}
+	}
+	for (int i = 0; i < p_entry.render_mode_flags.size(); i++) {
+		Map<StringName, bool *>::Element *E = p_actions->render_mode_flags.find(p_entry.render_mode_flags[i]);
+		if (E) {
+			*E->get() = true;
+		}
+	}
+	for (int i = 0; i < p_entry.usage_flags.size(); i++) {
+		Map<StringName, bool *>::Element *E = p_actions->usage_flag_pointers.find(p_entry.usage_flags[i]);
+		if (E) {
+			*E->get() = true;
+		}
+	}
+	for (int i = 0; i < p_entry.write_flags.size(); i++) {
+		Map<StringName, bool *>::Element *E = p_actions->write_flag_pointers.find(p_entry.write_flags[i]);
+		if (E) {
+			*E->get() = true;
+		}
+	}
+}
+
+static void _encode_string_names(StreamPeerBuffer *p_buf, const Vector<StringName> &p_names) {
+
+	p_buf->put_u32(p_names.size());
+	for (int i = 0; i < p_names.size(); i++) {
+		p_buf->put_utf8_string(p_names[i]);
+	}
+}
+
+static bool _decode_string_names(StreamPeerBuffer *p_buf, Vector<StringName> &r_names) {
+
+	uint32_t count = p_buf->get_u32();
+	if (count > (uint32_t)p_buf->get_available_bytes()) {
+		return false;
+	}
+
+	r_names.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		r_names.write[i] = p_buf->get_utf8_string();
+	}
+	return true;
+}
+
+PoolVector<uint8_t> ShaderCompilerGLES3::_encode_cache_entry(const CompileCacheEntry &p_entry) {
+
+	Ref<StreamPeerBuffer> buf;
+	buf.instance();
+
+	buf->put_u32(COMPILE_CACHE_FORMAT_VERSION);
+
+	const GeneratedCode &gen_code = p_entry.gen_code;
+
+	buf->put_u32(gen_code.defines.size());
+	for (int i = 0; i < gen_code.defines.size(); i++) {
+		buf->put_utf8_string(String::utf8(gen_code.defines[i].get_data()));
+	}
+
+	_encode_string_names(buf.ptr(), gen_code.texture_uniforms);
+
+	buf->put_u32(gen_code.texture_types.size());
+	for (int i = 0; i < gen_code.texture_types.size(); i++) {
+		buf->put_u32(gen_code.texture_types[i]);
+		buf->put_u32(gen_code.texture_hints[i]);
+	}
+
+	buf->put_u32(gen_code.uniform_offsets.size());
+	for (int i = 0; i < gen_code.uniform_offsets.size(); i++) {
+		buf->put_u32(gen_code.uniform_offsets[i]);
+	}
+	buf->put_u32(gen_code.uniform_total_size);
+
+	buf->put_utf8_string(gen_code.uniforms);
+	buf->put_utf8_string(gen_code.vertex_global);
+	buf->put_utf8_string(gen_code.vertex);
+	buf->put_utf8_string(gen_code.fragment_global);
+	buf->put_utf8_string(gen_code.fragment);
+	buf->put_utf8_string(gen_code.light);
+	buf->put_u8(gen_code.uses_fragment_time);
+	buf->put_u8(gen_code.uses_vertex_time);
+
+	buf->put_u32(p_entry.uniforms.size());
+	for (const Map<StringName, SL::ShaderNode::Uniform>::Element *E = p_entry.uniforms.front(); E; E = E->next()) {
+
+		const SL::ShaderNode::Uniform &u = E->get();
+		buf->put_utf8_string(E->key());
+		buf->put_32(u.order);
+		buf->put_32(u.texture_order);
+		buf->put_u32(u.type);
+		buf->put_u32(u.precision);
+		buf->put_u32(u.default_value.size());
+		for (int i = 0; i < u.default_value.size(); i++) {
+			buf->put_u32(u.default_value[i].uint);
+		}
+		buf->put_u32(u.hint);
+		for (int i = 0; i < 3; i++) {
+			buf->put_float(u.hint_range[i]);
+		}
+	}
+
+	buf->put_u32(p_entry.render_mode_values.size());
+	for (int i = 0; i < p_entry.render_mode_values.size(); i++) {
+		buf->put_utf8_string(p_entry.render_mode_values[i].first);
+		buf->put_32(p_entry.render_mode_values[i].second);
+	}
+
+	_encode_string_names(buf.ptr(), p_entry.render_mode_flags);
+	_encode_string_names(buf.ptr(), p_entry.usage_flags);
+	_encode_string_names(buf.ptr(), p_entry.write_flags);
+
+	return buf->get_data_array();
+}
+
+bool ShaderCompilerGLES3::_decode_cache_entry(const PoolVector<uint8_t> &p_data, CompileCacheEntry &r_entry) {
+
+	Ref<StreamPeerBuffer> buf;
+	buf.instance();
+	buf->set_data_array(p_data);
+
+	if (buf->get_u32() != COMPILE_CACHE_FORMAT_VERSION) {
+		return false;
+	}
+
+	GeneratedCode &gen_code = r_entry.gen_code;
+
+	uint32_t count = buf->get_u32();
+	ERR_FAIL_COND_V(count > (uint32_t)buf->get_available_bytes(), false);
+	gen_code.defines.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		gen_code.defines.write[i] = buf->get_utf8_string().utf8();
+	}
+
+	ERR_FAIL_COND_V(!_decode_string_names(buf.ptr(), gen_code.texture_uniforms), false);
+
+	count = buf->get_u32();
+	ERR_FAIL_COND_V(count != (uint32_t)gen_code.texture_uniforms.size(), false);
+	gen_code.texture_types.resize(count);
+	gen_code.texture_hints.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		gen_code.texture_types.write[i] = SL::DataType(buf->get_u32());
+		gen_code.texture_hints.write[i] = SL::ShaderNode::Uniform::Hint(buf->get_u32());
+	}
+
+	count = buf->get_u32();
+	ERR_FAIL_COND_V(count > (uint32_t)buf->get_available_bytes(), false);
+	gen_code.uniform_offsets.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		gen_code.uniform_offsets.write[i] = buf->get_u32();
+	}
+	gen_code.uniform_total_size = buf->get_u32();
+
+	gen_code.uniforms = buf->get_utf8_string();
+	gen_code.vertex_global = buf->get_utf8_string();
+	gen_code.vertex = buf->get_utf8_string();
+	gen_code.fragment_global = buf->get_utf8_string();
+	gen_code.fragment = buf->get_utf8_string();
+	gen_code.light = buf->get_utf8_string();
+	gen_code.uses_fragment_time = buf->get_u8();
+	gen_code.uses_vertex_time = buf->get_u8();
+
+	count = buf->get_u32();
+	ERR_FAIL_COND_V(count > (uint32_t)buf->get_available_bytes(), false);
+	for (uint32_t i = 0; i < count; i++) {
+
+		StringName name = buf->get_utf8_string();
+		SL::ShaderNode::Uniform u;
+		u.order = buf->get_32();
+		u.texture_order = buf->get_32();
+		u.type = SL::DataType(buf->get_u32());
+		u.precision = SL::DataPrecision(buf->get_u32());
+		uint32_t value_count = buf->get_u32();
+		ERR_FAIL_COND_V(value_count > (uint32_t)buf->get_available_bytes(), false);
+		u.default_value.resize(value_count);
+		for (uint32_t j = 0; j < value_count; j++) {
+			u.default_value.write[j].uint = buf->get_u32();
+		}
+		u.hint = SL::ShaderNode::Uniform::Hint(buf->get_u32());
+		for (int j = 0; j < 3; j++) {
+			u.hint_range[j] = buf->get_float();
+		}
+		r_entry.uniforms[name] = u;
+	}
+
+	count = buf->get_u32();
+	ERR_FAIL_COND_V(count > (uint32_t)buf->get_available_bytes(), false);
+	for (uint32_t i = 0; i < count; i++) {
+		StringName name = buf->get_utf8_string();
+		int value = buf->get_32();
+		r_entry.render_mode_values.push_back(Pair<StringName, int>(name, value));
+	}
+
+	ERR_FAIL_COND_V(!_decode_string_names(buf.ptr(), r_entry.render_mode_flags), false);
+	ERR_FAIL_COND_V(!_decode_string_names(buf.ptr(), r_entry.usage_flags), false);
+	ERR_FAIL_COND_V(!_decode_string_names(buf.ptr(), r_entry.write_flags), false);
+
+	// anything left over means the entry doesn't match this format
+	return buf->get_available_bytes() == 0;
+}
+
+Error ShaderCompilerGLES3::compile(VS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+
+	const CompileCacheEntry *cached = compile_cache[p_mode].getptr(p_code);
+	if (cached) {
+		compile_cache_hits++;
+		_apply_cache_entry(*cached, p_actions, r_gen_code);
+		return OK;
+	}
+
+	if (compile_cache[p_mode].size() >= MAX_CACHED_COMPILES) {
+		// e.g. a shader edited in the editor for a long time, don't keep every revision around
+		compile_cache[p_mode].clear();
+	}
+
+	ShaderCacheGLES3 *shader_cache = ShaderCacheGLES3::get_singleton();
+	String cache_name;
+
+	if (shader_cache && shader_cache->is_enabled()) {
+		cache_name = "compiler_" + (compile_cache_salt + itos(p_mode) + "\n" + p_code).md5_text();
+
+		PoolVector<uint8_t> data;
+		CompileCacheEntry entry;
+		if (shader_cache->retrieve_data(cache_name, data) && _decode_cache_entry(data, entry)) {
+			compile_cache_hits++;
+			compile_cache[p_mode][p_code] = entry;
+			_apply_cache_entry(entry, p_actions, r_gen_code);
+			return OK;
+		}
+	}
+
+	compile_cache_misses++;
+
+	CompileCacheEntry entry;
+	Error err = _compile_and_record(p_mode, p_code, p_actions, p_path, entry);
+	if (err != OK) {
+		return err;
+	}
+
+	compile_cache[p_mode][p_code] = entry;
+	if (cache_name != String()) {
+		shader_cache->store_data(cache_name, _encode_cache_entry(entry));
+	}
+
+	_apply_cache_entry(entry, p_actions, r_gen_code);
+	return OK;
+}
+
 ShaderCompilerGLES3::ShaderCompilerGLES3() {
 
 	/** CANVAS ITEM SHADER **/
@@ -1044,6 +1367,11 @@ ShaderCompilerGLES3::ShaderCompilerGLES3() {
 	actions[VS::SHADER_SPATIAL].render_mode_defines["ambient_light_disabled"] = "#define AMBIENT_LIGHT_DISABLED\n";
 	actions[VS::SHADER_SPATIAL].render_mode_defines["shadow_to_opacity"] = "#define USE_SHADOW_TO_OPACITY\n";
 
+	// anything that changes the generated code besides the shader itself
+	compile_cache_salt = String(VERSION_FULL_BUILD) + "|" + itos(COMPILE_CACHE_FORMAT_VERSION) + "|" + itos(force_lambert) + itos(force_blinn) + "|";
+	compile_cache_hits = 0;
+	compile_cache_misses = 0;
+
 	/* PARTICLES SHADER */
 
 	actions[VS::SHADER_PARTICLES].renames["COLOR"] = "out_color";
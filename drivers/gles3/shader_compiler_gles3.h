@@ -31,6 +31,7 @@
 #ifndef SHADERCOMPILERGLES3_H
 #define SHADERCOMPILERGLES3_H
 
+#include "core/hash_map.h"
 #include "core/pair.h"
 #include "servers/visual/shader_language.h"
 #include "servers/visual/shader_types.h"
@@ -94,9 +95,40 @@ private:
 
 	DefaultIdentifierActions actions[VS::SHADER_MAX];
 
+	// Output of a compile, plus the effects it had on the caller's identifier actions,
+	// so identical code is only parsed and generated once.
+	struct CompileCacheEntry {
+
+		GeneratedCode gen_code;
+		Map<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+		Vector<Pair<StringName, int> > render_mode_values;
+		Vector<StringName> render_mode_flags;
+		Vector<StringName> usage_flags;
+		Vector<StringName> write_flags;
+	};
+
+	enum {
+		COMPILE_CACHE_FORMAT_VERSION = 1,
+		MAX_CACHED_COMPILES = 1024,
+	};
+
+	HashMap<String, CompileCacheEntry> compile_cache[VS::SHADER_MAX];
+	String compile_cache_salt;
+	uint64_t compile_cache_hits;
+	uint64_t compile_cache_misses;
+
+	Error _compile(VS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
+	Error _compile_and_record(VS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, CompileCacheEntry &r_entry);
+	static void _apply_cache_entry(const CompileCacheEntry &p_entry, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+	static PoolVector<uint8_t> _encode_cache_entry(const CompileCacheEntry &p_entry);
+	static bool _decode_cache_entry(const PoolVector<uint8_t> &p_data, CompileCacheEntry &r_entry);
+
 public:
 	Error compile(VS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
+	uint64_t get_cache_hits() const { return compile_cache_hits; }
+	uint64_t get_cache_misses() const { return compile_cache_misses; }
+
 	ShaderCompilerGLES3();
 };
 
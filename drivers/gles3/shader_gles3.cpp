@@ -31,6 +31,7 @@
 #include "shader_gles3.h"
 
 #include "core/print_string.h"
+#include "shader_cache_gles3.h"
 
 //#define DEBUG_OPENGL
 
@@ -50,6 +51,7 @@
 #endif
 
 ShaderGLES3 *ShaderGLES3::active = NULL;
+uint32_t ShaderGLES3::pending_compile_count = 0;
 
 //#define DEBUG_SHADER
 
@@ -63,10 +65,15 @@ ShaderGLES3 *ShaderGLES3::active = NULL;
 
 #endif
 
+// from KHR_parallel_shader_compile / ARB_parallel_shader_compile
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 void ShaderGLES3::bind_uniforms() {
 
-	if (!uniforms_dirty) {
-		return;
+	if (!uniforms_dirty || version->compile_pending) {
+		return; // uploaded once the program is ready
 	};
 
 	// upload default uniforms
@@ -106,13 +113,16 @@ void ShaderGLES3::bind_uniforms() {
 GLint ShaderGLES3::get_uniform_location(int p_index) const {
 
 	ERR_FAIL_COND_V(!version, -1);
+	if (version->compile_pending) {
+		return -1;
+	}
 
 	return version->uniform_location[p_index];
 }
 
 bool ShaderGLES3::bind() {
 
-	if (active != this || !version || new_conditional_version.key != conditional_version.key) {
+	if (active != this || !version || new_conditional_version.key != conditional_version.key || version->compile_pending) {
 		conditional_version = new_conditional_version;
 		version = get_current_version();
 	} else {
@@ -144,16 +154,11 @@ void ShaderGLES3::unbind() {
 	active = NULL;
 }
 
-static void _display_error_with_code(const String &p_error, const Vector<const char *> &p_code) {
+static void _display_error_with_code(const String &p_error, const String &p_code) {
 
 	int line = 1;
-	String total_code;
-
-	for (int i = 0; i < p_code.size(); i++) {
-		total_code += String(p_code[i]);
-	}
 
-	Vector<String> lines = String(total_code).split("\n");
+	Vector<String> lines = p_code.split("\n");
 
 	for (int j = 0; j < lines.size(); j++) {
 
@@ -164,6 +169,58 @@ static void _display_error_with_code(const String &p_error, const Vector<const c
 	ERR_PRINTS(p_error);
 }
 
+static String _get_shader_source(GLuint p_shader) {
+
+	GLint length = 0;
+	glGetShaderiv(p_shader, GL_SHADER_SOURCE_LENGTH, &length);
+	if (length <= 0) {
+		return String();
+	}
+
+	char *source = (char *)memalloc(length + 1);
+	source[length] = 0;
+	glGetShaderSource(p_shader, length, NULL, source);
+	String ret = source;
+	memfree(source);
+	return ret;
+}
+
+bool ShaderGLES3::_check_compile_status(GLuint p_shader, const String &p_stage) {
+
+	GLint status;
+	glGetShaderiv(p_shader, GL_COMPILE_STATUS, &status);
+	if (status == GL_TRUE) {
+		return true;
+	}
+
+	// error compiling
+	GLsizei iloglen;
+	glGetShaderiv(p_shader, GL_INFO_LOG_LENGTH, &iloglen);
+
+	if (iloglen < 0) {
+
+		ERR_PRINTS(p_stage + " shader compilation failed with empty log");
+		return false;
+	}
+
+	if (iloglen == 0) {
+
+		iloglen = 4096; //buggy driver (Adreno 220+....)
+	}
+
+	char *ilogmem = (char *)memalloc(iloglen + 1);
+	ilogmem[iloglen] = 0;
+	glGetShaderInfoLog(p_shader, iloglen, &iloglen, ilogmem);
+
+	String err_string = get_shader_name() + ": " + p_stage + " Program Compilation Failed:\n";
+
+	err_string += ilogmem;
+	_display_error_with_code(err_string, _get_shader_source(p_shader));
+	memfree(ilogmem);
+
+	return false;
+}
+
 ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 
 	Version *_v = version_map.getptr(conditional_version);
@@ -173,8 +230,12 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 		if (conditional_version.code_version != 0) {
 			CustomCode *cc = custom_code_map.getptr(conditional_version.code_version);
 			ERR_FAIL_COND_V(!cc, _v);
-			if (cc->version == _v->code_version)
+			if (cc->version == _v->code_version) {
+				if (_v->compile_pending) {
+					_poll_pending_version(*_v, cc, conditional_version);
+				}
 				return _v;
+			}
 		} else {
 			return _v;
 		}
@@ -188,15 +249,24 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 	if (!_v) {
 
 		v.uniform_location = memnew_arr(GLint, uniform_count);
+		// only filled in once linked, which may take a while with async compile
+		for (int i = 0; i < uniform_count; i++) {
+			v.uniform_location[i] = -1;
+		}
 
 	} else {
-		if (v.ok) {
+		if (v.ok || v.compile_pending) {
 			//bye bye shaders
 			glDeleteShader(v.vert_id);
 			glDeleteShader(v.frag_id);
 			glDeleteProgram(v.id);
 			v.id = 0;
 		}
+
+		if (v.compile_pending) {
+			v.compile_pending = false;
+			pending_compile_count--;
+		}
 	}
 
 	v.ok = false;
@@ -234,6 +304,8 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 	CharString code_string;
 	CharString code_string2;
 	CharString code_globals;
+	CharString vertex_code_string;
+	CharString vertex_code_globals;
 	CharString material_string;
 
 	CustomCode *cc = NULL;
@@ -244,14 +316,10 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 		ERR_FAIL_COND_V(!custom_code_map.has(conditional_version.code_version), NULL);
 		cc = &custom_code_map[conditional_version.code_version];
 		v.code_version = cc->version;
+		// registered right away, so a version that is still compiling is also freed with the code
+		cc->versions.insert(conditional_version.version);
 	}
 
-	/* CREATE PROGRAM */
-
-	v.id = glCreateProgram();
-
-	ERR_FAIL_COND_V(v.id == 0, NULL);
-
 	/* VERTEX SHADER */
 
 	if (cc) {
@@ -283,71 +351,29 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 	strings.push_back(vertex_code1.get_data());
 
 	if (cc) {
-		code_globals = cc->vertex_globals.ascii();
-		strings.push_back(code_globals.get_data());
+		vertex_code_globals = cc->vertex_globals.ascii();
+		strings.push_back(vertex_code_globals.get_data());
 	}
 
 	strings.push_back(vertex_code2.get_data());
 
 	if (cc) {
-		code_string = cc->vertex.ascii();
-		strings.push_back(code_string.get_data());
+		vertex_code_string = cc->vertex.ascii();
+		strings.push_back(vertex_code_string.get_data());
 	}
 
 	strings.push_back(vertex_code3.get_data());
 #ifdef DEBUG_SHADER
 
-	DEBUG_PRINT("\nVertex Code:\n\n" + String(code_string.get_data()));
+	DEBUG_PRINT("\nVertex Code:\n\n" + String(vertex_code_string.get_data()));
 	for (int i = 0; i < strings.size(); i++) {
 
 		//print_line("vert strings "+itos(i)+":"+String(strings[i]));
 	}
 #endif
 
-	v.vert_id = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(v.vert_id, strings.size(), &strings[0], NULL);
-	glCompileShader(v.vert_id);
-
-	GLint status;
-
-	glGetShaderiv(v.vert_id, GL_COMPILE_STATUS, &status);
-	if (status == GL_FALSE) {
-		// error compiling
-		GLsizei iloglen;
-		glGetShaderiv(v.vert_id, GL_INFO_LOG_LENGTH, &iloglen);
-
-		if (iloglen < 0) {
-
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
-
-			ERR_PRINT("Vertex shader compilation failed with empty log");
-		} else {
-
-			if (iloglen == 0) {
-
-				iloglen = 4096; //buggy driver (Adreno 220+....)
-			}
-
-			char *ilogmem = (char *)memalloc(iloglen + 1);
-			ilogmem[iloglen] = 0;
-			glGetShaderInfoLog(v.vert_id, iloglen, &iloglen, ilogmem);
-
-			String err_string = get_shader_name() + ": Vertex Program Compilation Failed:\n";
-
-			err_string += ilogmem;
-			_display_error_with_code(err_string, strings);
-			memfree(ilogmem);
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
-		}
-
-		ERR_FAIL_V(NULL);
-	}
-
-	//_display_error_with_code("pepo", strings);
+	// both stages are assembled before compiling, so the program can be looked up in the cache
+	Vector<const char *> vertex_strings = strings;
 
 	/* FRAGMENT SHADER */
 
@@ -363,7 +389,6 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 
 	strings.push_back(fragment_code0.get_data());
 	if (cc) {
-		material_string = cc->uniforms.ascii();
 		strings.push_back(material_string.get_data());
 	}
 
@@ -399,49 +424,36 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 	}
 #endif
 
-	v.frag_id = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(v.frag_id, strings.size(), &strings[0], NULL);
-	glCompileShader(v.frag_id);
-
-	glGetShaderiv(v.frag_id, GL_COMPILE_STATUS, &status);
-	if (status == GL_FALSE) {
-		// error compiling
-		GLsizei iloglen;
-		glGetShaderiv(v.frag_id, GL_INFO_LOG_LENGTH, &iloglen);
-
-		if (iloglen < 0) {
-
-			glDeleteShader(v.frag_id);
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
-			ERR_PRINT("Fragment shader compilation failed with empty log");
-		} else {
+	/* CREATE PROGRAM */
 
-			if (iloglen == 0) {
+	v.id = glCreateProgram();
 
-				iloglen = 4096; //buggy driver (Adreno 220+....)
-			}
+	ERR_FAIL_COND_V(v.id == 0, NULL);
 
-			char *ilogmem = (char *)memalloc(iloglen + 1);
-			ilogmem[iloglen] = 0;
-			glGetShaderInfoLog(v.frag_id, iloglen, &iloglen, ilogmem);
+	ShaderCacheGLES3 *shader_cache = ShaderCacheGLES3::get_singleton();
+	v.program_hash = String();
 
-			String err_string = get_shader_name() + ": Fragment Program Compilation Failed:\n";
+	if (shader_cache && shader_cache->is_supported()) {
+		String program_hash = shader_cache->hash_program(get_shader_name(), vertex_strings, strings);
 
-			err_string += ilogmem;
-			_display_error_with_code(err_string, strings);
-			ERR_PRINT(err_string.ascii().get_data());
-			memfree(ilogmem);
-			glDeleteShader(v.frag_id);
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
+		if (shader_cache->retrieve(program_hash, v.id)) {
+			// linked straight from the binary, there are no shader objects to keep around
+			v.vert_id = 0;
+			v.frag_id = 0;
+			return _finish_version(v, cc, conditional_version) ? &v : NULL;
 		}
 
-		ERR_FAIL_V(NULL);
+		v.program_hash = program_hash;
 	}
 
+	v.vert_id = glCreateShader(GL_VERTEX_SHADER);
+	glShaderSource(v.vert_id, vertex_strings.size(), &vertex_strings[0], NULL);
+	glCompileShader(v.vert_id);
+
+	v.frag_id = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(v.frag_id, strings.size(), &strings[0], NULL);
+	glCompileShader(v.frag_id);
+
 	glAttachShader(v.id, v.frag_id);
 	glAttachShader(v.id, v.vert_id);
 
@@ -468,8 +480,54 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 		}
 	}
 
+	if (v.program_hash != String()) {
+		glProgramParameteri(v.id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
 	glLinkProgram(v.id);
 
+	if (async_compile && cc) {
+		// querying any status now would block until the driver is done, poll it on later binds instead
+		v.compile_pending = true;
+		pending_compile_count++;
+		return &v;
+	}
+
+	return _finish_version(v, cc, conditional_version) ? &v : NULL;
+}
+
+bool ShaderGLES3::_poll_pending_version(Version &v, CustomCode *cc, const VersionKey &p_key) {
+
+	GLint completed = GL_FALSE;
+	glGetProgramiv(v.id, GL_COMPLETION_STATUS_KHR, &completed);
+	if (completed == GL_FALSE) {
+		return false;
+	}
+
+	v.compile_pending = false;
+	pending_compile_count--;
+
+	_finish_version(v, cc, p_key);
+	return true;
+}
+
+bool ShaderGLES3::_finish_version(Version &v, CustomCode *cc, const VersionKey &p_key) {
+
+	if (v.vert_id) {
+
+		// not loaded from the cache, make sure both stages compiled
+		if (!_check_compile_status(v.vert_id, "Vertex") || !_check_compile_status(v.frag_id, "Fragment")) {
+
+			glDeleteShader(v.frag_id);
+			glDeleteShader(v.vert_id);
+			glDeleteProgram(v.id);
+			v.id = 0;
+
+			ERR_FAIL_V(false);
+		}
+	}
+
+	GLint status;
 	glGetProgramiv(v.id, GL_LINK_STATUS, &status);
 
 	if (status == GL_FALSE) {
@@ -483,7 +541,7 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 			glDeleteShader(v.vert_id);
 			glDeleteProgram(v.id);
 			v.id = 0;
-			ERR_FAIL_COND_V(iloglen < 0, NULL);
+			ERR_FAIL_COND_V(iloglen < 0, false);
 		}
 
 		if (iloglen == 0) {
@@ -498,15 +556,21 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 		String err_string = get_shader_name() + ": Program LINK FAILED:\n";
 
 		err_string += ilogmem;
-		_display_error_with_code(err_string, strings);
-		ERR_PRINT(err_string.ascii().get_data());
+		_display_error_with_code(err_string, v.frag_id ? _get_shader_source(v.frag_id) : String());
 		Memory::free_static(ilogmem);
 		glDeleteShader(v.frag_id);
 		glDeleteShader(v.vert_id);
 		glDeleteProgram(v.id);
 		v.id = 0;
 
-		ERR_FAIL_V(NULL);
+		ERR_FAIL_V(false);
+	}
+
+	ShaderCacheGLES3 *shader_cache = ShaderCacheGLES3::get_singleton();
+
+	if (v.program_hash != String()) {
+		shader_cache->store(v.program_hash, v.id);
+		v.program_hash = String();
 	}
 
 	/* UNIFORMS */
@@ -555,16 +619,42 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 	glUseProgram(0);
 
 	v.ok = true;
-	if (cc) {
-		cc->versions.insert(conditional_version.version);
+	if (cc && shader_cache && cc->cache_key != String()) {
+		shader_cache->record_variant(cc->cache_key, p_key.version);
 	}
 
-	return &v;
+	return true;
+}
+
+void ShaderGLES3::update_pending_compiles() {
+
+	if (!pending_compile_count) {
+		return;
+	}
+
+	bool finished = false;
+
+	const VersionKey *K = NULL;
+	while ((K = version_map.next(K))) {
+
+		Version &v = version_map[*K];
+		if (v.compile_pending) {
+			finished = _poll_pending_version(v, custom_code_map.getptr(K->code_version), *K) || finished;
+		}
+	}
+
+	if (finished) {
+		// finishing leaves no program bound, make sure the next bind() really binds
+		active = NULL;
+	}
 }
 
 GLint ShaderGLES3::get_uniform_location(const String &p_name) const {
 
 	ERR_FAIL_COND_V(!version, -1);
+	if (version->compile_pending) {
+		return -1;
+	}
 	return glGetUniformLocation(version->id, p_name.ascii().get_data());
 }
 
@@ -686,6 +776,9 @@ void ShaderGLES3::finish() {
 		glDeleteShader(v.frag_id);
 		glDeleteProgram(v.id);
 		memdelete_arr(v.uniform_location);
+		if (v.compile_pending) {
+			pending_compile_count--;
+		}
 	}
 }
 
@@ -699,6 +792,9 @@ void ShaderGLES3::clear_caches() {
 		glDeleteShader(v.frag_id);
 		glDeleteProgram(v.id);
 		memdelete_arr(v.uniform_location);
+		if (v.compile_pending) {
+			pending_compile_count--;
+		}
 	}
 
 	version_map.clear();
@@ -730,6 +826,45 @@ void ShaderGLES3::set_custom_shader_code(uint32_t p_code_id, const String &p_ver
 	cc->uniforms = p_uniforms;
 	cc->custom_defines = p_custom_defines;
 	cc->version++;
+
+	ShaderCacheGLES3 *shader_cache = ShaderCacheGLES3::get_singleton();
+	if (shader_cache && shader_cache->is_enabled()) {
+		// stable across runs, used to remember which variants of this code get used
+		String key_source = p_vertex + p_vertex_globals + p_fragment + p_fragment_globals + p_light + p_uniforms;
+		for (int i = 0; i < p_custom_defines.size(); i++) {
+			key_source += String(p_custom_defines[i].get_data());
+		}
+		cc->cache_key = get_shader_name() + "_" + key_source.md5_text();
+	}
+}
+
+void ShaderGLES3::prewarm_custom_shader(uint32_t p_code_id) {
+
+	ShaderCacheGLES3 *shader_cache = ShaderCacheGLES3::get_singleton();
+	if (!shader_cache || !shader_cache->is_prewarm_enabled()) {
+		return;
+	}
+
+	ERR_FAIL_COND(!custom_code_map.has(p_code_id));
+	CustomCode *cc = &custom_code_map[p_code_id];
+
+	Vector<uint32_t> recorded = shader_cache->get_recorded_variants(cc->cache_key);
+	if (recorded.empty()) {
+		return;
+	}
+
+	VersionKey prev_version = conditional_version;
+
+	for (int i = 0; i < recorded.size(); i++) {
+		conditional_version.version = recorded[i];
+		conditional_version.code_version = p_code_id;
+		get_current_version();
+	}
+
+	conditional_version = prev_version;
+
+	// compiling leaves no program bound, make sure the next bind() really binds
+	active = NULL;
 }
 
 void ShaderGLES3::set_custom_shader(uint32_t p_code_id) {
@@ -757,6 +892,9 @@ void ShaderGLES3::free_custom_shader(uint32_t p_code_id) {
 		glDeleteProgram(v.id);
 		memdelete_arr(v.uniform_location);
 		v.id = 0;
+		if (v.compile_pending) {
+			pending_compile_count--;
+		}
 
 		version_map.erase(key);
 	}
@@ -771,6 +909,7 @@ void ShaderGLES3::set_base_material_tex_index(int p_idx) {
 
 ShaderGLES3::ShaderGLES3() {
 	version = NULL;
+	async_compile = false;
 	last_custom_code = 1;
 	uniforms_dirty = true;
 	base_material_tex_index = 0;
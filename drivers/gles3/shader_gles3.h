@@ -114,6 +114,7 @@ private:
 		Vector<StringName> texture_uniforms;
 		Vector<CharString> custom_defines;
 		Set<uint32_t> versions;
+		String cache_key;
 	};
 
 	struct Version {
@@ -125,13 +126,16 @@ private:
 		Vector<GLint> texture_uniform_locations;
 		uint32_t code_version;
 		bool ok;
+		bool compile_pending;
+		String program_hash;
 		Version() :
 				id(0),
 				vert_id(0),
 				frag_id(0),
 				uniform_location(NULL),
 				code_version(0),
-				ok(false) {}
+				ok(false),
+				compile_pending(false) {}
 	};
 
 	Version *version;
@@ -187,9 +191,15 @@ private:
 	int base_material_tex_index;
 
 	Version *get_current_version();
+	bool _check_compile_status(GLuint p_shader, const String &p_stage);
+	bool _finish_version(Version &v, CustomCode *cc, const VersionKey &p_key);
+	bool _poll_pending_version(Version &v, CustomCode *cc, const VersionKey &p_key);
 
 	static ShaderGLES3 *active;
 
+	bool async_compile;
+	static uint32_t pending_compile_count;
+
 	int max_image_units;
 
 	_FORCE_INLINE_ void _set_uniform_variant(GLint p_uniform, const Variant &p_value) {
@@ -323,6 +333,14 @@ public:
 	void set_custom_shader_code(uint32_t p_code_id, const String &p_vertex, const String &p_vertex_globals, const String &p_fragment, const String &p_light, const String &p_fragment_globals, const String &p_uniforms, const Vector<StringName> &p_texture_uniforms, const Vector<CharString> &p_custom_defines);
 	void set_custom_shader(uint32_t p_code_id);
 	void free_custom_shader(uint32_t p_code_id);
+	// Compiles (or loads from the shader cache) the variants of this code recorded in previous runs.
+	void prewarm_custom_shader(uint32_t p_code_id);
+
+	// Custom shader variants are compiled in the background, and the version reports as
+	// invalid until it's done. Only enable when the driver supports parallel shader compile.
+	void set_async_compile(bool p_enable) { async_compile = p_enable; }
+	void update_pending_compiles();
+	static uint32_t get_pending_compile_count() { return pending_compile_count; }
 
 	void set_uniform_default(int p_idx, const Variant &p_value) {
 
@@ -387,6 +405,9 @@ int ShaderGLES3::_get_uniform(int p_which) const {
 
 	ERR_FAIL_INDEX_V(p_which, uniform_count, -1);
 	ERR_FAIL_COND_V(!version, -1);
+	if (version->compile_pending) {
+		return -1;
+	}
 	return version->uniform_location[p_which];
 }
 
@@ -1424,6 +1424,9 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 
 	ResourceLoader::load_path_remaps();
 
+	ResourceCache::set_soft_budget(uint64_t(int(GLOBAL_DEF("memory/limits/resource_cache/soft_budget_kb", 0))) * 1024);
+	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/resource_cache/soft_budget_kb", PropertyInfo(Variant::INT, "memory/limits/resource_cache/soft_budget_kb", PROPERTY_HINT_RANGE, "0,4194304,1,or_greater"));
+
 	MAIN_PRINT("Main: Load Scene Types");
 
 	register_scene_types();
@@ -2240,6 +2243,8 @@ void Main::cleanup(bool p_force) {
 
 	OS::get_singleton()->delete_main_loop();
 
+	ResourceCache::clear_soft_cache();
+
 	OS::get_singleton()->_cmdline.clear();
 	OS::get_singleton()->_execpath = "";
 	OS::get_singleton()->_local_clipboard = "";
@@ -34,6 +34,7 @@
 #include "core/os/os.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
+#include "scene/resources/packed_scene.h"
 #include "servers/audio_server.h"
 #include "servers/physics_2d_server.h"
 #include "servers/physics_server.h"
@@ -76,6 +77,13 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
 	BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+	BIND_ENUM_CONSTANT(OBJECT_POOLED_SCENE_COUNT);
+	BIND_ENUM_CONSTANT(OBJECT_POOLED_SCENE_REUSES);
+	BIND_ENUM_CONSTANT(OBJECT_RESOURCE_SOFT_CACHE_COUNT);
+	BIND_ENUM_CONSTANT(MEMORY_RESOURCE_SOFT_CACHE);
+	BIND_ENUM_CONSTANT(RENDER_SHADER_COMPILES_IN_PROGRESS);
+	BIND_ENUM_CONSTANT(RENDER_SHADER_COMPILER_CACHE_HITS);
+	BIND_ENUM_CONSTANT(RENDER_SHADER_COMPILER_CACHE_MISSES);
 
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -124,6 +132,13 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
 		"audio/output_latency",
+		"object/pooled_scenes",
+		"object/pooled_scene_reuses",
+		"object/soft_cached_resources",
+		"memory/resource_soft_cache",
+		"raster/shader_compiles_in_progress",
+		"raster/shader_compiler_cache_hits",
+		"raster/shader_compiler_cache_misses",
 
 	};
 
@@ -164,6 +179,13 @@ float Performance::get_monitor(Monitor p_monitor) const {
 		case PHYSICS_3D_COLLISION_PAIRS: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_COLLISION_PAIRS);
 		case PHYSICS_3D_ISLAND_COUNT: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_ISLAND_COUNT);
 		case AUDIO_OUTPUT_LATENCY: return AudioServer::get_singleton()->get_output_latency();
+		case OBJECT_POOLED_SCENE_COUNT: return PackedScene::get_pooled_instance_count();
+		case OBJECT_POOLED_SCENE_REUSES: return PackedScene::get_pool_reuse_count();
+		case OBJECT_RESOURCE_SOFT_CACHE_COUNT: return ResourceCache::get_soft_cached_count();
+		case MEMORY_RESOURCE_SOFT_CACHE: return ResourceCache::get_soft_cached_bytes();
+		case RENDER_SHADER_COMPILES_IN_PROGRESS: return VS::get_singleton()->get_render_info(VS::INFO_SHADER_COMPILES_IN_PROGRESS);
+		case RENDER_SHADER_COMPILER_CACHE_HITS: return VS::get_singleton()->get_render_info(VS::INFO_SHADER_COMPILER_CACHE_HITS);
+		case RENDER_SHADER_COMPILER_CACHE_MISSES: return VS::get_singleton()->get_render_info(VS::INFO_SHADER_COMPILER_CACHE_MISSES);
 
 		default: {
 		}
@@ -208,6 +230,13 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
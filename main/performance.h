@@ -83,6 +83,13 @@ public:
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
 		AUDIO_OUTPUT_LATENCY,
+		OBJECT_POOLED_SCENE_COUNT,
+		OBJECT_POOLED_SCENE_REUSES,
+		OBJECT_RESOURCE_SOFT_CACHE_COUNT,
+		MEMORY_RESOURCE_SOFT_CACHE,
+		RENDER_SHADER_COMPILES_IN_PROGRESS,
+		RENDER_SHADER_COMPILER_CACHE_HITS,
+		RENDER_SHADER_COMPILER_CACHE_MISSES,
 		MONITOR_MAX
 	};
 
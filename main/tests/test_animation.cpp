@@ -0,0 +1,323 @@
+/*************************************************************************/
+/*  test_animation.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_animation.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "scene/resources/animation.h"
+
+namespace TestAnimation {
+
+// Sizes like a mocap clip: a minute at 30 FPS for a full skeleton.
+static const int BONES = 60;
+static const int KEYS = 1800;
+static const float FPS = 30.0;
+
+static const float LOCATION_TOLERANCE = 0.001;
+static const float ROTATION_TOLERANCE = 0.001;
+static const float SCALE_TOLERANCE = 0.001;
+
+static Ref<Animation> _make_animation() {
+
+	Ref<Animation> animation;
+	animation.instance();
+	animation->set_length(KEYS / FPS);
+	animation->set_loop(true);
+
+	for (int b = 0; b < BONES; b++) {
+
+		int track = animation->add_track(Animation::TYPE_TRANSFORM);
+		animation->track_set_path(track, NodePath("Skeleton:bone_" + itos(b)));
+
+		// smooth motion with a bit of noise, only the root moves, scale never changes
+		float phase = Math::random(0.0, Math_TAU);
+		float speed = Math::random(0.5, 3.0);
+		Vector3 axis = Vector3(Math::random(-1.0, 1.0), Math::random(-1.0, 1.0), Math::random(-1.0, 1.0)).normalized();
+		Vector3 offset = Vector3(0, 0.1 * b, 0);
+
+		for (int k = 0; k < KEYS; k++) {
+			float t = k / FPS;
+			Vector3 loc = offset;
+			if (b == 0) {
+				loc += Vector3(Math::sin(t * 0.3) * 4.0, Math::abs(Math::sin(t * speed)) * 0.2, t * 1.5);
+			}
+			Quat rot(axis, Math::sin(t * speed + phase) * 1.2 + Math::random(-0.01, 0.01));
+			animation->transform_track_insert_key(track, t, loc, rot, Vector3(1, 1, 1));
+		}
+	}
+
+	return animation;
+}
+
+static float _sample_all(const Ref<Animation> &p_animation, int p_samples, uint64_t *r_usec) {
+
+	// checksum keeps the sampling from being optimized out
+	float sum = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_samples; i++) {
+		float time = p_animation->get_length() * i / p_samples;
+		for (int t = 0; t < p_animation->get_track_count(); t++) {
+			Vector3 loc;
+			Quat rot;
+			Vector3 scale;
+			p_animation->transform_track_interpolate(t, time, &loc, &rot, &scale);
+			sum += loc.x + rot.w + scale.z;
+		}
+	}
+	*r_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	return sum;
+}
+
+static bool _test_compression() {
+
+	Math::seed(0);
+	Ref<Animation> original = _make_animation();
+	Math::seed(0);
+	Ref<Animation> compressed = _make_animation();
+	compressed->compress(LOCATION_TOLERANCE, ROTATION_TOLERANCE, SCALE_TOLERANCE);
+
+	bool ok = true;
+	for (int t = 0; t < compressed->get_track_count(); t++) {
+		if (!compressed->track_is_compressed(t) || compressed->track_get_key_count(t) != KEYS) {
+			OS::get_singleton()->print("Track %d not compressed.\n", t);
+			ok = false;
+		}
+	}
+
+	// samples between keys too, the interpolated error must stay close to the key tolerances
+	float max_loc_error = 0;
+	float max_rot_error = 0;
+	float max_scale_error = 0;
+	for (int i = 0; i < KEYS * 3; i++) {
+		float time = i / (FPS * 3.0);
+		for (int t = 0; t < BONES; t++) {
+			Vector3 loc_a, loc_b, scale_a, scale_b;
+			Quat rot_a, rot_b;
+			original->transform_track_interpolate(t, time, &loc_a, &rot_a, &scale_a);
+			compressed->transform_track_interpolate(t, time, &loc_b, &rot_b, &scale_b);
+			max_loc_error = MAX(max_loc_error, loc_a.distance_to(loc_b));
+			max_rot_error = MAX(max_rot_error, 2.0f * Math::acos(MIN(Math::abs(rot_a.dot(rot_b)), 1.0f)));
+			max_scale_error = MAX(max_scale_error, scale_a.distance_to(scale_b));
+		}
+	}
+
+	// acos() loses precision near 1, hence the extra margin for rotations
+	bool errors_ok = max_loc_error <= LOCATION_TOLERANCE * 1.01 && max_rot_error <= ROTATION_TOLERANCE * 2.0 && max_scale_error <= SCALE_TOLERANCE * 1.01;
+	OS::get_singleton()->print("Max error: location %f, rotation %f, scale %f: %s\n", max_loc_error, max_rot_error, max_scale_error, errors_ok ? "OK" : "FAIL");
+	ok = ok && errors_ok;
+
+	uint64_t original_size = original->get_memory_usage();
+	uint64_t compressed_size = compressed->get_memory_usage();
+	bool size_ok = compressed_size * 2 < original_size;
+	OS::get_singleton()->print("Size: %d bytes, compressed %d bytes (%.1f%%): %s\n", int(original_size), int(compressed_size), 100.0 * compressed_size / original_size, size_ok ? "OK" : "FAIL");
+	ok = ok && size_ok;
+
+	uint64_t original_usec = 0;
+	uint64_t compressed_usec = 0;
+	_sample_all(original, 2000, &original_usec);
+	_sample_all(compressed, 2000, &compressed_usec);
+	OS::get_singleton()->print("Sampling %d tracks 2000 times: %d usec, compressed %d usec\n", BONES, int(original_usec), int(compressed_usec));
+
+	return ok;
+}
+
+static bool _keys_equal(const Ref<Animation> &p_a, int p_track_a, const Ref<Animation> &p_b, int p_track_b, int p_key) {
+
+	Vector3 loc_a, loc_b, scale_a, scale_b;
+	Quat rot_a, rot_b;
+	p_a->transform_track_get_key(p_track_a, p_key, &loc_a, &rot_a, &scale_a);
+	p_b->transform_track_get_key(p_track_b, p_key, &loc_b, &rot_b, &scale_b);
+	return loc_a == loc_b && rot_a == rot_b && scale_a == scale_b && p_a->track_get_key_time(p_track_a, p_key) == p_b->track_get_key_time(p_track_b, p_key);
+}
+
+static bool _test_round_trip() {
+
+	Math::seed(1);
+	Ref<Animation> animation = _make_animation();
+	animation->compress();
+
+	// what a saved resource would hold
+	Ref<Animation> loaded;
+	loaded.instance();
+	List<PropertyInfo> properties;
+	animation->get_property_list(&properties);
+	for (List<PropertyInfo>::Element *E = properties.front(); E; E = E->next()) {
+		if (E->get().usage & PROPERTY_USAGE_STORAGE) {
+			loaded->set(E->get().name, animation->get(E->get().name));
+		}
+	}
+
+	bool ok = true;
+	for (int t = 0; t < animation->get_track_count() && ok; t++) {
+		ok = loaded->track_is_compressed(t);
+		for (int k = 0; k < KEYS && ok; k += 7) {
+			ok = _keys_equal(loaded, t, animation, t, k);
+		}
+	}
+	OS::get_singleton()->print("Compressed tracks saved and loaded: %s\n", ok ? "OK" : "FAIL");
+
+	// editing falls back to regular keys with the decoded values
+	animation->track_set_key_transition(3, 10, 0.5);
+	bool edit_ok = !animation->track_is_compressed(3) && loaded->track_is_compressed(3) && _keys_equal(animation, 3, loaded, 3, 10) && animation->track_get_key_transition(3, 10) == 0.5 && animation->track_get_key_count(3) == KEYS;
+	OS::get_singleton()->print("Editing a compressed track: %s\n", edit_ok ? "OK" : "FAIL");
+
+	return ok && edit_ok;
+}
+
+static bool _test_cursors() {
+
+	Math::seed(2);
+	Ref<Animation> animation = _make_animation();
+	Math::seed(2);
+	Ref<Animation> compressed = _make_animation();
+	compressed->compress();
+
+	// play forward at 60 FPS past the loop point, with a seek back every few seconds
+	Vector<float> times;
+	float time = 0;
+	for (int i = 0; i < KEYS * 4; i++) {
+		time = i % 200 == 199 ? Math::random(0.0f, animation->get_length()) : Math::fposmod(time + 1.0f / 60.0f, animation->get_length());
+		times.push_back(time);
+	}
+
+	bool ok = true;
+	Vector<int> cursors;
+	cursors.resize(BONES * 2);
+	for (int i = 0; i < cursors.size(); i++) {
+		cursors.write[i] = -1;
+	}
+
+	for (int i = 0; i < times.size() && ok; i++) {
+		for (int t = 0; t < BONES && ok; t++) {
+			Vector3 loc_a, loc_b, scale_a, scale_b;
+			Quat rot_a, rot_b;
+			animation->transform_track_interpolate(t, times[i], &loc_a, &rot_a, &scale_a);
+			animation->transform_track_interpolate(t, times[i], &loc_b, &rot_b, &scale_b, &cursors.write[t]);
+			ok = loc_a == loc_b && rot_a == rot_b && scale_a == scale_b;
+
+			compressed->transform_track_interpolate(t, times[i], &loc_a, &rot_a, &scale_a);
+			compressed->transform_track_interpolate(t, times[i], &loc_b, &rot_b, &scale_b, &cursors.write[BONES + t]);
+			ok = ok && loc_a == loc_b && rot_a == rot_b && scale_a == scale_b;
+		}
+	}
+	OS::get_singleton()->print("Sampling with key cursors: %s\n", ok ? "OK" : "FAIL");
+
+	float sum = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < times.size(); i++) {
+		for (int t = 0; t < BONES; t++) {
+			Vector3 loc;
+			animation->transform_track_interpolate(t, times[i], &loc, NULL, NULL);
+			sum += loc.y;
+		}
+	}
+	uint64_t search_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < times.size(); i++) {
+		for (int t = 0; t < BONES; t++) {
+			Vector3 loc;
+			animation->transform_track_interpolate(t, times[i], &loc, NULL, NULL, &cursors.write[t]);
+			sum += loc.y;
+		}
+	}
+	uint64_t cursor_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	OS::get_singleton()->print("Sequential playback: %d usec, with key cursors %d usec (checksum %f)\n", int(search_usec), int(cursor_usec), sum);
+
+	return ok;
+}
+
+static bool _test_pose() {
+
+	Math::seed(3);
+	Ref<Animation> animation = _make_animation();
+
+	// bones listed in reverse, with one the animation doesn't have
+	Vector<StringName> bones;
+	for (int b = BONES - 1; b >= 0; b--) {
+		bones.push_back("bone_" + itos(b));
+	}
+	bones.push_back("unanimated");
+
+	Vector<int> map = animation->get_pose_track_map(NodePath("Skeleton"), bones);
+	bool ok = map.size() == BONES;
+	for (int t = 0; t < BONES && ok; t++) {
+		ok = map[t] == BONES - 1 - t;
+	}
+	ok = ok && animation->get_pose_track_map(NodePath("Other"), bones)[0] == -1;
+	ok = ok && animation->get_pose_track_map(NodePath(), bones)[0] == BONES - 1;
+
+	Vector<Animation::PoseBone> pose;
+	pose.resize(bones.size());
+
+	for (int i = 0; i < 100 && ok; i++) {
+		float time = Math::random(0.0f, animation->get_length());
+		for (int b = 0; b < pose.size(); b++) {
+			pose.write[b] = Animation::PoseBone();
+		}
+		animation->sample_pose(time, map, pose.ptrw(), pose.size());
+
+		for (int t = 0; t < BONES && ok; t++) {
+			Vector3 loc, scale;
+			Quat rot;
+			animation->transform_track_interpolate(t, time, &loc, &rot, &scale);
+			const Animation::PoseBone &pb = pose[BONES - 1 - t];
+			ok = pb.loc == loc && pb.rot == rot && pb.scale == scale && pb.weight == 1.0;
+		}
+		ok = ok && pose[BONES].weight == 0 && pose[BONES].get_transform() == Transform();
+
+		// the same animation blended in again at any weight leaves the pose as is
+		animation->sample_pose(time, map, pose.ptrw(), pose.size(), 0.5);
+		for (int t = 0; t < BONES && ok; t++) {
+			Vector3 loc, scale;
+			Quat rot;
+			animation->transform_track_interpolate(t, time, &loc, &rot, &scale);
+			const Animation::PoseBone &pb = pose[BONES - 1 - t];
+			ok = pb.loc.is_equal_approx(loc) && pb.rot.is_equal_approx(rot.normalized()) && pb.weight == 1.5;
+		}
+	}
+	OS::get_singleton()->print("Pose sampling: %s\n", ok ? "OK" : "FAIL");
+
+	return ok;
+}
+
+MainLoop *test() {
+
+	bool ok = _test_compression();
+	ok = _test_round_trip() && ok;
+	ok = _test_cursors() && ok;
+	ok = _test_pose() && ok;
+
+	OS::get_singleton()->print(ok ? "All animation tests passed.\n" : "Some animation tests failed!\n");
+
+	return NULL;
+}
+} // namespace TestAnimation
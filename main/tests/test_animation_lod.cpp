@@ -0,0 +1,183 @@
+/*************************************************************************/
+/*  test_animation_lod.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef _3D_DISABLED
+
+#include "test_animation_lod.h"
+
+#include "core/os/os.h"
+#include "scene/3d/skeleton.h"
+#include "scene/animation/animation_player.h"
+
+namespace TestAnimationLOD {
+
+static const float DELTA = 1.0 / 60.0;
+
+static void _check(const char *p_what, bool p_ok, bool &r_ok) {
+
+	OS::get_singleton()->print("%s: %s\n", p_what, p_ok ? "OK" : "FAIL");
+	r_ok = r_ok && p_ok;
+}
+
+// Runs p_frames frames at p_camera_distance, returns how many of them updated.
+static int _run(AnimationUpdateLOD &lod, float p_camera_distance, int p_frames, float &r_advanced) {
+
+	int updates = 0;
+	for (int i = 0; i < p_frames; i++) {
+		float delta = DELTA;
+		if (lod.process_at_distance(p_camera_distance, 0, i, delta)) {
+			r_advanced += delta;
+			updates++;
+		}
+	}
+	return updates;
+}
+
+static bool _test_update_rate() {
+
+	bool ok = true;
+
+	AnimationUpdateLOD lod;
+	lod.distance = 10;
+
+	float advanced = 0;
+	_check("Near nodes update every frame", _run(lod, 5, 40, advanced) == 40, ok);
+
+	advanced = 0;
+	_check("Third band updates every fourth frame", _run(lod, 25, 40, advanced) == 10, ok);
+	// the last update is on frame 36, so frames 37-39 are still pending
+	_check("Skipped frames are kept", Math::is_equal_approx(lod.skipped_delta, DELTA * 3), ok);
+
+	float delta = DELTA;
+	_check("Losing the camera updates right away", lod.process_at_distance(-1, 0, 40, delta), ok);
+	advanced += delta;
+	_check("Advanced time matches wall time", Math::is_equal_approx(advanced, DELTA * 41), ok);
+	_check("Skipped time is flushed", lod.skipped_delta == 0, ok);
+
+	advanced = 0;
+	_check("Far nodes are capped at max_interval", _run(lod, 1000, 40, advanced) == 5, ok);
+
+	lod.max_interval = 2;
+	advanced = 0;
+	_check("Lower max_interval updates more often", _run(lod, 1000, 40, advanced) == 20, ok);
+
+	lod.distance = 0;
+	lod.skipped_delta = 0;
+	advanced = 0;
+	_check("Distance 0 disables the LOD", _run(lod, 1000, 40, advanced) == 40, ok);
+	_check("Disabled LOD advances by wall time", Math::is_equal_approx(advanced, DELTA * 40), ok);
+
+	return ok;
+}
+
+static bool _test_stagger() {
+
+	bool ok = true;
+
+	const int count = 8;
+	AnimationUpdateLOD lods[count];
+	int updated_on[count];
+	int updates[count];
+	for (int i = 0; i < count; i++) {
+		lods[i].distance = 1;
+		updated_on[i] = -1;
+		updates[i] = 0;
+	}
+
+	for (int frame = 0; frame < count; frame++) {
+		for (int i = 0; i < count; i++) {
+			float delta = DELTA;
+			if (lods[i].process_at_distance(100, i, frame, delta)) {
+				updated_on[i] = frame;
+				updates[i]++;
+			}
+		}
+	}
+
+	bool once = true;
+	bool distinct = true;
+	for (int i = 0; i < count; i++) {
+		once = once && updates[i] == 1;
+		for (int j = 0; j < i; j++) {
+			distinct = distinct && updated_on[i] != updated_on[j];
+		}
+	}
+	_check("Each node updates once per interval", once, ok);
+	_check("Nodes in the same band update on different frames", distinct, ok);
+
+	return ok;
+}
+
+static bool _test_bone_lod() {
+
+	bool ok = true;
+
+	// a chain of five bones, depths 0 to 4
+	Skeleton *skeleton = memnew(Skeleton);
+	for (int i = 0; i < 5; i++) {
+		skeleton->add_bone("bone" + itos(i));
+		skeleton->set_bone_parent(i, i - 1);
+	}
+	skeleton->set_bone_lod_distance(10);
+	skeleton->set_bone_lod_max_depth(2);
+
+	skeleton->update_bone_lod_at_distance(5);
+	_check("Near skeleton animates all bones", !skeleton->is_bone_reduced(4), ok);
+
+	skeleton->update_bone_lod_at_distance(20);
+	_check("Far skeleton animates bones up to max depth", !skeleton->is_bone_reduced(0) && !skeleton->is_bone_reduced(2), ok);
+	_check("Far skeleton skips deeper bones", skeleton->is_bone_reduced(3) && skeleton->is_bone_reduced(4), ok);
+	_check("Invalid bones are not reduced", !skeleton->is_bone_reduced(-1) && !skeleton->is_bone_reduced(5), ok);
+
+	skeleton->update_bone_lod_at_distance(-1);
+	_check("No camera animates all bones", !skeleton->is_bone_reduced(4), ok);
+
+	skeleton->set_bone_lod_distance(0);
+	skeleton->update_bone_lod_at_distance(20);
+	_check("Distance 0 disables bone LOD", !skeleton->is_bone_reduced(4), ok);
+
+	memdelete(skeleton);
+
+	return ok;
+}
+
+MainLoop *test() {
+
+	bool ok = _test_update_rate();
+	ok = _test_stagger() && ok;
+	ok = _test_bone_lod() && ok;
+
+	OS::get_singleton()->print(ok ? "All animation LOD tests passed.\n" : "Some animation LOD tests failed!\n");
+
+	return NULL;
+}
+} // namespace TestAnimationLOD
+
+#endif // _3D_DISABLED
@@ -0,0 +1,191 @@
+/*************************************************************************/
+/*  test_auto_instancing.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifdef GLES_ENABLED
+
+#include "test_auto_instancing.h"
+
+#include "core/os/os.h"
+#include "drivers/gles3/rasterizer_scene_gles3.h"
+
+namespace TestAutoInstancing {
+
+typedef RasterizerSceneGLES3::RenderList RenderList;
+
+struct TestRID : public RID_Data {
+};
+
+struct TestInstance : public RasterizerScene::InstanceBase {
+	virtual void base_removed() {}
+	virtual void base_changed(bool p_aabb, bool p_materials) {}
+};
+
+// A sorted render list of plain mesh elements that all share one surface and
+// material, so each check below changes a single thing to break the run.
+struct List {
+
+	enum {
+		COUNT = RenderList::MAX_AUTO_INSTANCES + 100,
+	};
+
+	RasterizerStorageGLES3::Surface surface;
+	RasterizerStorageGLES3::Material material;
+	RasterizerStorageGLES3::Material other_material;
+	TestInstance *instances;
+	RenderList::Element *elements;
+	RenderList::Element **ptrs;
+
+	RID_Owner<TestRID> rid_owner;
+	TestRID skeleton_data;
+	TestRID light_data[2];
+	RID skeleton;
+	RID lights[2];
+
+	void reset() {
+		for (int i = 0; i < COUNT; i++) {
+			TestInstance &instance = instances[i];
+			instance.base_type = VS::INSTANCE_MESH;
+			instance.skeleton = RID();
+			instance.layer_mask = 1;
+			instance.baked_light = false;
+			instance.lod_error = 0.2;
+			// equal, but not shared, so the contents get compared
+			instance.light_instances.clear();
+			instance.light_instances.push_back(lights[0]);
+			instance.reflection_probe_instances.clear();
+
+			RenderList::Element &e = elements[i];
+			e.instance = &instance;
+			e.geometry = &surface;
+			e.material = &material;
+			e.owner = NULL;
+			e.sort_key = 0;
+			ptrs[i] = &e;
+		}
+	}
+
+	List() {
+		RasterizerStorageGLES3::Surface::LOD lod;
+		lod.index_id = 0;
+		lod.array_id = 0;
+		lod.instancing_array_id = 0;
+		lod.index_array_len = 0;
+		lod.error = 0.1;
+		surface.lods.push_back(lod);
+		lod.error = 0.5;
+		surface.lods.push_back(lod);
+
+		skeleton = rid_owner.make_rid(&skeleton_data);
+		lights[0] = rid_owner.make_rid(&light_data[0]);
+		lights[1] = rid_owner.make_rid(&light_data[1]);
+
+		instances = memnew_arr(TestInstance, COUNT);
+		elements = memnew_arr(RenderList::Element, COUNT);
+		ptrs = memnew_arr(RenderList::Element *, COUNT);
+		reset();
+	}
+
+	~List() {
+		memdelete_arr(ptrs);
+		memdelete_arr(elements);
+		memdelete_arr(instances);
+		rid_owner.free(skeleton);
+		rid_owner.free(lights[0]);
+		rid_owner.free(lights[1]);
+	}
+};
+
+static bool _check(const char *p_name, List &p_list, int p_count, bool p_match_lights, int p_expected) {
+
+	int run = RenderList::get_auto_instancing_run(p_list.ptrs, p_count, p_match_lights);
+	bool ok = run == p_expected;
+	OS::get_singleton()->print("%s: run of %d, expected %d: %s\n", p_name, run, p_expected, ok ? "OK" : "FAIL");
+	p_list.reset();
+	return ok;
+}
+
+MainLoop *test() {
+
+	List list;
+	bool ok = true;
+	const int count = 8;
+	const int breaking = 3;
+
+	ok = _check("Identical elements", list, count, true, count) && ok;
+	ok = _check("Single element", list, 1, true, 1) && ok;
+	ok = _check("Capped at MAX_AUTO_INSTANCES", list, List::COUNT, true, RenderList::MAX_AUTO_INSTANCES) && ok;
+
+	list.elements[breaking].material = &list.other_material;
+	ok = _check("Material change", list, count, true, breaking) && ok;
+
+	list.elements[breaking].sort_key = RenderList::SORT_KEY_CULL_DISABLED_FLAG;
+	ok = _check("Sort key change", list, count, true, breaking) && ok;
+
+	list.instances[breaking].skeleton = list.skeleton;
+	ok = _check("Skeleton", list, count, true, breaking) && ok;
+
+	list.instances[0].skeleton = list.skeleton;
+	ok = _check("Skeleton on the first element", list, count, true, 1) && ok;
+
+	list.instances[breaking].lod_error = 0.6;
+	ok = _check("LOD change", list, count, true, breaking) && ok;
+
+	list.instances[breaking].lod_error = 0.3;
+	ok = _check("Different error, same LOD", list, count, true, count) && ok;
+
+	list.instances[breaking].lod_error = 0.0;
+	ok = _check("Full detail among LODs", list, count, true, breaking) && ok;
+
+	list.instances[breaking].light_instances.write[0] = list.lights[1];
+	ok = _check("Light change", list, count, true, breaking) && ok;
+
+	list.instances[breaking].light_instances.write[0] = list.lights[1];
+	ok = _check("Light change, lights not matched", list, count, false, count) && ok;
+
+	list.instances[breaking].light_instances.push_back(list.lights[1]);
+	ok = _check("Extra light", list, count, true, breaking) && ok;
+
+	list.instances[breaking].reflection_probe_instances.push_back(list.lights[1]);
+	ok = _check("Reflection probe change", list, count, true, breaking) && ok;
+
+	list.instances[breaking].layer_mask = 2;
+	ok = _check("Layer mask change", list, count, true, breaking) && ok;
+
+	list.elements[breaking].sort_key = SORT_KEY_GI_PROBES_FLAG;
+	list.elements[0].sort_key = SORT_KEY_GI_PROBES_FLAG;
+	ok = _check("GI probes", list, count, true, 1) && ok;
+
+	OS::get_singleton()->print(ok ? "All auto instancing tests passed.\n" : "Some auto instancing tests failed!\n");
+
+	return NULL;
+}
+} // namespace TestAutoInstancing
+
+#endif
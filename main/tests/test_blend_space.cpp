@@ -0,0 +1,210 @@
+/*************************************************************************/
+/*  test_blend_space.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_blend_space.h"
+
+#include "core/math/geometry.h"
+#include "core/os/os.h"
+#include "scene/animation/animation_blend_space_2d.h"
+#include "scene/animation/animation_blend_tree.h"
+
+namespace TestBlendSpace {
+
+// Exposes the triangle lookup, which blend spaces otherwise only use while processing.
+class LookupBlendSpace2D : public AnimationNodeBlendSpace2D {
+public:
+	int find_triangle(const Vector2 &p_pos, int p_hint) { return _find_triangle(p_pos, p_hint, NULL); }
+	void update_triangles() { _update_triangles(); }
+};
+
+static bool _triangle_has_point(LookupBlendSpace2D *p_space, int p_triangle, const Vector2 &p_pos) {
+
+	Vector2 points[3];
+	for (int j = 0; j < 3; j++) {
+		points[j] = p_space->get_blend_point_position(p_space->get_triangle_point(p_triangle, j));
+	}
+	return Geometry::is_point_in_triangle(p_pos, points[0], points[1], points[2]);
+}
+
+// What the lookup used to do: the first triangle, in index order, that has the point.
+static int _find_triangle_brute_force(LookupBlendSpace2D *p_space, const Vector2 &p_pos) {
+
+	for (int i = 0; i < p_space->get_triangle_count(); i++) {
+		if (_triangle_has_point(p_space, i, p_pos)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+static Vector2 _random_point(const Rect2 &p_rect) {
+
+	return p_rect.position + Vector2(Math::randf(), Math::randf()) * p_rect.size;
+}
+
+// Looks up random points around the blend points, the blend points themselves
+// and the edge midpoints, without a hint and with a random (possibly stale or
+// out of range) one. Without a hint the grid must find the same triangle as
+// the brute force scan. A hint that has the point wins, so with one the result
+// only has to have the point, and miss exactly when the scan misses.
+static bool _check_lookups(LookupBlendSpace2D *p_space, const char *p_name) {
+
+	Rect2 rect(p_space->get_blend_point_position(0), Vector2());
+	for (int i = 1; i < p_space->get_blend_point_count(); i++) {
+		rect.expand_to(p_space->get_blend_point_position(i));
+	}
+	rect = rect.grow(0.5);
+
+	Vector<Vector2> queries;
+	for (int i = 0; i < 2000; i++) {
+		queries.push_back(_random_point(rect));
+	}
+	for (int i = 0; i < p_space->get_blend_point_count(); i++) {
+		queries.push_back(p_space->get_blend_point_position(i));
+	}
+	for (int i = 0; i < p_space->get_triangle_count(); i++) {
+		for (int j = 0; j < 3; j++) {
+			Vector2 a = p_space->get_blend_point_position(p_space->get_triangle_point(i, j));
+			Vector2 b = p_space->get_blend_point_position(p_space->get_triangle_point(i, (j + 1) % 3));
+			queries.push_back((a + b) * 0.5);
+		}
+	}
+
+	int triangle_count = p_space->get_triangle_count();
+	int inside = 0;
+	int grid_errors = 0;
+	int hint_errors = 0;
+
+	for (int i = 0; i < queries.size(); i++) {
+		Vector2 p = queries[i];
+		int expected = _find_triangle_brute_force(p_space, p);
+		if (expected != -1) {
+			inside++;
+		}
+
+		int found = p_space->find_triangle(p, -1);
+		if (found != expected) {
+			if (grid_errors == 0) {
+				OS::get_singleton()->print("%s: (%f, %f) found in triangle %i instead of %i\n", p_name, p.x, p.y, found, expected);
+			}
+			grid_errors++;
+		}
+
+		int hint = int(Math::rand() % (triangle_count + 3)) - 1;
+		int hinted = p_space->find_triangle(p, hint);
+		bool hint_ok = (hinted == -1) == (expected == -1) && (hinted == -1 || _triangle_has_point(p_space, hinted, p));
+		if (hint >= 0 && hint < triangle_count && _triangle_has_point(p_space, hint, p)) {
+			hint_ok = hint_ok && hinted == hint;
+		}
+		if (!hint_ok) {
+			if (hint_errors == 0) {
+				OS::get_singleton()->print("%s: (%f, %f) with hint %i found in triangle %i, scan found %i\n", p_name, p.x, p.y, hint, hinted, expected);
+			}
+			hint_errors++;
+		}
+	}
+
+	bool ok = grid_errors == 0 && hint_errors == 0;
+	OS::get_singleton()->print("%s, %i triangles, %i of %i points inside, %i grid and %i hinted mismatches: %s\n", p_name, triangle_count, inside, queries.size(), grid_errors, hint_errors, ok ? "OK" : "FAIL");
+	return ok;
+}
+
+static bool _test_lookups() {
+
+	Ref<LookupBlendSpace2D> space;
+	space.instance();
+	space->set_min_space(Vector2(-2, -2));
+	space->set_max_space(Vector2(2, 2));
+
+	for (int i = 0; i < 40; i++) {
+		Ref<AnimationNodeAnimation> node;
+		node.instance();
+		space->add_blend_point(node, _random_point(Rect2(-1, -1, 2, 2)));
+	}
+	space->update_triangles();
+	space->set_auto_triangles(false);
+
+	bool ok = _check_lookups(space.ptr(), "Triangulated blend points");
+
+	// With the triangulation kept, moved points make triangles overlap, so the
+	// index order of the triangles in each cell decides the result.
+	for (int i = 0; i < 10; i++) {
+		int point = Math::rand() % space->get_blend_point_count();
+		space->set_blend_point_position(point, _random_point(Rect2(-1.5, -1.5, 3, 3)));
+	}
+	ok = _check_lookups(space.ptr(), "After set_blend_point_position()") && ok;
+
+	for (int i = 0; i < 15; i++) {
+		space->remove_triangle(Math::rand() % space->get_triangle_count());
+	}
+	ok = _check_lookups(space.ptr(), "After remove_triangle()") && ok;
+
+	return ok;
+}
+
+// All blend points on one line, so the grid is one epsilon high (or wide) and
+// every triangle is flat.
+static bool _test_flat_layout(const Vector2 &p_axis, const char *p_name) {
+
+	Ref<LookupBlendSpace2D> space;
+	space.instance();
+	space->set_auto_triangles(false);
+
+	for (int i = 0; i < 12; i++) {
+		Ref<AnimationNodeAnimation> node;
+		node.instance();
+		space->add_blend_point(node, p_axis * (i / 6.0 - 1.0));
+	}
+	for (int i = 0; i < 10; i++) {
+		space->add_triangle(i, i + 1, i + 2);
+	}
+
+	bool ok = _check_lookups(space.ptr(), p_name);
+
+	space->set_blend_point_position(5, p_axis * 0.1 + p_axis.tangent() * 0.5);
+	space->remove_triangle(0);
+	ok = _check_lookups(space.ptr(), "Flat layout after moving a point off the line") && ok;
+
+	return ok;
+}
+
+MainLoop *test() {
+
+	Math::seed(0x5eed);
+
+	bool ok = _test_lookups();
+	ok = _test_flat_layout(Vector2(1, 0), "Horizontal flat layout") && ok;
+	ok = _test_flat_layout(Vector2(0, 1), "Vertical flat layout") && ok;
+
+	OS::get_singleton()->print(ok ? "All blend space tests passed.\n" : "Some blend space tests failed!\n");
+
+	return NULL;
+}
+} // namespace TestBlendSpace
@@ -0,0 +1,175 @@
+/*************************************************************************/
+/*  test_canvas_damage.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_canvas_damage.h"
+
+#include "core/os/os.h"
+#include "servers/visual/visual_server_globals.h"
+#include "servers/visual/visual_server_viewport.h"
+#include "servers/visual_server.h"
+
+namespace TestCanvasDamage {
+
+typedef VisualServerViewport::Viewport::Damage Damage;
+
+static const int SIZE = 256;
+
+static const Damage &_update(VisualServerViewport::Viewport *p_viewport) {
+
+	VSG::viewport->update_damage(p_viewport, Rect2(0, 0, SIZE, SIZE), false);
+	return p_viewport->damage;
+}
+
+static bool _is_clean(const Damage &p_damage) {
+
+	return !p_damage.full && !p_damage.has_rect;
+}
+
+// the damage grows by two pixels for filtering, and is clipped to the viewport
+static bool _is_damaged(const Damage &p_damage, const Rect2 &p_rect) {
+
+	return !p_damage.full && p_damage.has_rect && p_damage.rect == p_rect;
+}
+
+static void _check(const char *p_what, bool p_ok, bool &r_ok) {
+
+	OS::get_singleton()->print("%s: %s\n", p_what, p_ok ? "OK" : "FAIL");
+	r_ok = r_ok && p_ok;
+}
+
+MainLoop *test() {
+
+	VisualServer *vs = VisualServer::get_singleton();
+
+	RID viewport = vs->viewport_create();
+	vs->viewport_set_size(viewport, SIZE, SIZE);
+	vs->viewport_set_update_mode(viewport, VS::VIEWPORT_UPDATE_WHEN_DIRTY);
+	RID canvas = vs->canvas_create();
+	vs->viewport_attach_canvas(viewport, canvas);
+
+	VisualServerViewport::Viewport *vp = VSG::viewport->viewport_owner.getornull(viewport);
+	ERR_FAIL_COND_V(!vp, NULL);
+
+	RID item = vs->canvas_item_create();
+	vs->canvas_item_set_parent(item, canvas);
+	vs->canvas_item_add_rect(item, Rect2(10, 10, 20, 20), Color(1, 1, 1));
+
+	bool ok = true;
+
+	_check("First update redraws everything", _update(vp).full, ok);
+	_check("Nothing changed", _is_clean(_update(vp)), ok);
+
+	vs->canvas_item_set_transform(item, Transform2D(0, Vector2(90, 90)));
+	_check("Moved item damages its old and new rect", _is_damaged(_update(vp), Rect2(8, 8, 114, 114)), ok);
+	_check("Moved item is clean after its update", _is_clean(_update(vp)), ok);
+
+	RID added = vs->canvas_item_create();
+	vs->canvas_item_set_parent(added, canvas);
+	vs->canvas_item_add_rect(added, Rect2(200, 200, 10, 10), Color(1, 1, 1));
+	_check("Added item", _is_damaged(_update(vp), Rect2(198, 198, 14, 14)), ok);
+	vs->free(added);
+	_check("Removed item", _is_damaged(_update(vp), Rect2(198, 198, 14, 14)), ok);
+
+	vs->canvas_set_modulate(canvas, Color(0.5, 0.5, 0.5));
+	_check("Canvas modulate redraws everything", _update(vp).full, ok);
+	_check("Canvas modulate is clean after its update", _is_clean(_update(vp)), ok);
+
+	// shader parameters and TIME change what an item draws without telling the canvas
+	RID material = vs->material_create();
+	vs->canvas_item_set_material(item, material);
+	_update(vp);
+	_check("Item with a material is always damaged", _is_damaged(_update(vp), Rect2(98, 98, 24, 24)), ok);
+	vs->canvas_item_set_material(item, RID());
+	_update(vp);
+	_check("Item without a material is clean again", _is_clean(_update(vp)), ok);
+
+	Ref<Image> image;
+	image.instance();
+	image->create(4, 4, false, Image::FORMAT_RGBA8);
+
+	RID texture = vs->texture_create();
+	vs->texture_allocate(texture, 4, 4, 0, Image::FORMAT_RGBA8, VS::TEXTURE_TYPE_2D, 0);
+	vs->texture_set_data(texture, image);
+	RID proxy = vs->texture_create();
+	vs->texture_set_proxy(proxy, texture);
+
+	RID textured = vs->canvas_item_create();
+	vs->canvas_item_set_parent(textured, canvas);
+	vs->canvas_item_add_texture_rect(textured, Rect2(50, 150, 16, 16), texture);
+	RID proxied = vs->canvas_item_create();
+	vs->canvas_item_set_parent(proxied, canvas);
+	vs->canvas_item_add_texture_rect(proxied, Rect2(150, 50, 16, 16), proxy);
+	_update(vp);
+	_check("Textured items are clean", _is_clean(_update(vp)), ok);
+
+	vs->texture_set_data(texture, image);
+	_check("New texture data damages its items and proxies", _is_damaged(_update(vp), Rect2(48, 48, 120, 120)), ok);
+	_check("Texture data is clean after its update", _is_clean(_update(vp)), ok);
+
+	// AnimatedTexture sets its proxy every frame, only a new frame counts
+	vs->texture_set_proxy(proxy, texture);
+	_check("Same proxy base", _is_clean(_update(vp)), ok);
+
+	RID texture2 = vs->texture_create();
+	vs->texture_allocate(texture2, 4, 4, 0, Image::FORMAT_RGBA8, VS::TEXTURE_TYPE_2D, 0);
+	vs->texture_set_proxy(proxy, texture2);
+	_check("New proxy base", _is_damaged(_update(vp), Rect2(148, 48, 20, 20)), ok);
+
+	RID source = vs->viewport_create();
+	vs->viewport_set_size(source, 16, 16);
+	RID source_texture = vs->viewport_get_texture(source);
+
+	RID shown = vs->canvas_item_create();
+	vs->canvas_item_set_parent(shown, canvas);
+	vs->canvas_item_add_texture_rect(shown, Rect2(0, 200, 16, 16), source_texture);
+	_update(vp);
+	_check("Viewport texture is clean", _is_clean(_update(vp)), ok);
+
+	// what drawing the source viewport reports
+	VSG::viewport->texture_changed(source_texture);
+	_check("Redrawn viewport texture", _is_damaged(_update(vp), Rect2(0, 198, 18, 20)), ok);
+
+	vs->free(shown);
+	vs->free(source);
+	vs->free(proxied);
+	vs->free(textured);
+	vs->free(proxy);
+	vs->free(texture2);
+	vs->free(texture);
+	vs->free(material);
+	vs->free(item);
+	vs->free(canvas);
+	vs->free(viewport);
+
+	OS::get_singleton()->print(ok ? "All canvas damage tests passed.\n" : "Some canvas damage tests failed!\n");
+
+	return NULL;
+}
+} // namespace TestCanvasDamage
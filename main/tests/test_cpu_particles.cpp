@@ -0,0 +1,185 @@
+/*************************************************************************/
+/*  test_cpu_particles.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef _3D_DISABLED
+
+#include "test_cpu_particles.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "scene/3d/cpu_particles.h"
+
+namespace TestCPUParticles {
+
+typedef CPUParticles::Particle Particle;
+
+static const int EMITTER_COUNT = 2;
+static const int FRAME_COUNT = 90;
+
+static void _check(const char *p_what, bool p_ok, bool &r_ok) {
+
+	OS::get_singleton()->print("%s: %s\n", p_what, p_ok ? "OK" : "FAIL");
+	r_ok = r_ok && p_ok;
+}
+
+static CPUParticles *_create_emitter() {
+
+	CPUParticles *emitter = memnew(CPUParticles);
+	emitter->set_amount(64);
+	emitter->set_lifetime(0.5);
+	emitter->set_randomness_ratio(0.5);
+	emitter->set_lifetime_randomness(0.25);
+	emitter->set_draw_order(CPUParticles::DRAW_ORDER_LIFETIME);
+	emitter->set_emission_shape(CPUParticles::EMISSION_SHAPE_BOX);
+	emitter->set_emission_box_extents(Vector3(1, 2, 3));
+	emitter->set_spread(60);
+	emitter->set_param(CPUParticles::PARAM_INITIAL_LINEAR_VELOCITY, 4);
+	emitter->set_param_randomness(CPUParticles::PARAM_INITIAL_LINEAR_VELOCITY, 0.5);
+	emitter->set_param(CPUParticles::PARAM_ANGULAR_VELOCITY, 90);
+	emitter->set_param(CPUParticles::PARAM_DAMPING, 1);
+	emitter->set_param(CPUParticles::PARAM_HUE_VARIATION, 0.5);
+	emitter->set_param_randomness(CPUParticles::PARAM_HUE_VARIATION, 1);
+	emitter->set_emitting(true);
+	return emitter;
+}
+
+static bool _same_particle(const Particle &p_a, const Particle &p_b) {
+
+	if (p_a.active != p_b.active || p_a.seed != p_b.seed) {
+		return false;
+	}
+	for (int i = 0; i < 4; i++) {
+		if (p_a.custom[i] != p_b.custom[i]) {
+			return false;
+		}
+	}
+	return p_a.transform == p_b.transform && p_a.velocity == p_b.velocity && p_a.color == p_b.color && p_a.base_color == p_b.base_color && p_a.time == p_b.time && p_a.lifetime == p_b.lifetime;
+}
+
+static bool _same_particles(CPUParticles *p_a, CPUParticles *p_b) {
+
+	PoolVector<Particle> a = p_a->get_particles();
+	PoolVector<Particle> b = p_b->get_particles();
+	if (a.size() != b.size()) {
+		return false;
+	}
+
+	PoolVector<Particle>::Read ra = a.read();
+	PoolVector<Particle>::Read rb = b.read();
+	for (int i = 0; i < a.size(); i++) {
+		if (!_same_particle(ra[i], rb[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool _same_data(CPUParticles *p_a, CPUParticles *p_b) {
+
+	PoolVector<float> a = p_a->get_particle_data();
+	PoolVector<float> b = p_b->get_particle_data();
+	// compares the packed colors bit for bit too
+	return a.size() == b.size() && memcmp(a.read().ptr(), b.read().ptr(), a.size() * sizeof(float)) == 0;
+}
+
+static int _active_count(CPUParticles *p_emitter) {
+
+	PoolVector<Particle> particles = p_emitter->get_particles();
+	PoolVector<Particle>::Read r = particles.read();
+	int count = 0;
+	for (int i = 0; i < particles.size(); i++) {
+		count += r[i].active ? 1 : 0;
+	}
+	return count;
+}
+
+static bool _test_batching() {
+
+	bool ok = true;
+
+	CPUParticles *serial[EMITTER_COUNT];
+	CPUParticles *batched[EMITTER_COUNT];
+	for (int i = 0; i < EMITTER_COUNT; i++) {
+		serial[i] = _create_emitter();
+		batched[i] = _create_emitter();
+	}
+
+	// Emission draws from the global random generator, so both runs start from the same seed.
+	// Like in the tree, the serial path steps each emitter in full, while the batched path
+	// emits for all of them before any simulation runs.
+	Math::seed(1234);
+	for (int frame = 0; frame < FRAME_COUNT; frame++) {
+		for (int i = 0; i < EMITTER_COUNT; i++) {
+			serial[i]->simulate_step(1.0 / 60.0, false);
+		}
+	}
+
+	Math::seed(1234);
+	for (int frame = 0; frame < FRAME_COUNT; frame++) {
+		for (int i = 0; i < EMITTER_COUNT; i++) {
+			batched[i]->simulate_step(1.0 / 60.0, true);
+		}
+		for (int i = 0; i < EMITTER_COUNT; i++) {
+			batched[i]->finish_batched_step();
+		}
+	}
+
+	bool emitted = true;
+	bool same_particles = true;
+	bool same_data = true;
+	for (int i = 0; i < EMITTER_COUNT; i++) {
+		emitted = emitted && _active_count(serial[i]) > 0;
+		same_particles = same_particles && _same_particles(serial[i], batched[i]);
+		same_data = same_data && _same_data(serial[i], batched[i]);
+	}
+	_check("Emitters have active particles", emitted, ok);
+	_check("Emitters don't share a random sequence", !_same_particles(serial[0], serial[1]), ok);
+	_check("Batched particles match the serial update", same_particles, ok);
+	_check("Batched draw buffers match the serial update", same_data, ok);
+
+	for (int i = 0; i < EMITTER_COUNT; i++) {
+		memdelete(serial[i]);
+		memdelete(batched[i]);
+	}
+
+	return ok;
+}
+
+MainLoop *test() {
+
+	bool ok = _test_batching();
+
+	OS::get_singleton()->print(ok ? "All CPU particles tests passed.\n" : "Some CPU particles tests failed!\n");
+
+	return NULL;
+}
+} // namespace TestCPUParticles
+
+#endif // _3D_DISABLED
@@ -34,18 +34,33 @@
 
 #ifdef DEBUG_ENABLED
 
+#include "test_animation.h"
+#include "test_animation_lod.h"
 #include "test_astar.h"
+#include "test_auto_instancing.h"
 #include "test_basis.h"
+#include "test_blend_space.h"
+#include "test_canvas_damage.h"
+#include "test_cpu_particles.h"
 #include "test_gdscript.h"
 #include "test_gui.h"
 #include "test_math.h"
+#include "test_mesh_lod.h"
+#include "test_mesh_simplifier.h"
 #include "test_oa_hash_map.h"
 #include "test_ordered_hash_map.h"
+#include "test_packed_scene.h"
 #include "test_physics.h"
 #include "test_physics_2d.h"
+#include "test_radix_sort.h"
 #include "test_render.h"
+#include "test_render_bench.h"
+#include "test_resource_cache.h"
 #include "test_shader_lang.h"
+#include "test_skinning.h"
 #include "test_string.h"
+#include "test_texture.h"
+#include "test_tween.h"
 
 const char **tests_get_names() {
 
@@ -65,6 +80,27 @@ const char **tests_get_names() {
 		"gd_bytecode",
 		"ordered_hash_map",
 		"astar",
+		"radix_sort",
+		"mesh_simplifier",
+		"render_bench",
+		"animation",
+		"packed_scene",
+		"texture",
+#ifndef _3D_DISABLED
+		"skinning",
+#endif
+#ifdef GLES_ENABLED
+		"auto_instancing",
+#endif
+		"blend_space",
+		"canvas_damage",
+#ifndef _3D_DISABLED
+		"mesh_lod",
+		"animation_lod",
+		"cpu_particles",
+#endif
+		"resource_cache",
+		"tween",
 		NULL
 	};
 
@@ -150,6 +186,87 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestAStar::test();
 	}
 
+	if (p_test == "radix_sort") {
+
+		return TestRadixSort::test();
+	}
+
+	if (p_test == "mesh_simplifier") {
+
+		return TestMeshSimplifier::test();
+	}
+
+	if (p_test == "render_bench") {
+
+		return TestRenderBench::test(p_args);
+	}
+
+	if (p_test == "animation") {
+
+		return TestAnimation::test();
+	}
+
+	if (p_test == "packed_scene") {
+
+		return TestPackedScene::test();
+	}
+
+	if (p_test == "texture") {
+
+		return TestTexture::test();
+	}
+
+#ifndef _3D_DISABLED
+	if (p_test == "skinning") {
+
+		return TestSkinning::test();
+	}
+#endif
+
+#ifdef GLES_ENABLED
+	if (p_test == "auto_instancing") {
+
+		return TestAutoInstancing::test();
+	}
+#endif
+
+	if (p_test == "blend_space") {
+
+		return TestBlendSpace::test();
+	}
+
+	if (p_test == "canvas_damage") {
+
+		return TestCanvasDamage::test();
+	}
+
+#ifndef _3D_DISABLED
+	if (p_test == "mesh_lod") {
+
+		return TestMeshLOD::test();
+	}
+
+	if (p_test == "animation_lod") {
+
+		return TestAnimationLOD::test();
+	}
+
+	if (p_test == "cpu_particles") {
+
+		return TestCPUParticles::test();
+	}
+#endif
+
+	if (p_test == "resource_cache") {
+
+		return TestResourceCache::test();
+	}
+
+	if (p_test == "tween") {
+
+		return TestTween::test();
+	}
+
 	print_line("Unknown test: " + p_test);
 	return NULL;
 }
@@ -0,0 +1,145 @@
+/*************************************************************************/
+/*  test_mesh_lod.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef _3D_DISABLED
+
+#include "test_mesh_lod.h"
+
+#include "core/os/os.h"
+#include "servers/visual/visual_server_scene.h"
+
+#ifdef GLES_ENABLED
+#include "drivers/gles3/rasterizer_storage_gles3.h"
+#endif
+
+namespace TestMeshLOD {
+
+typedef VisualServerScene::Instance Instance;
+
+static const float THRESHOLD = 1.0 / 720.0; // one pixel of a 720 pixel high viewport
+
+// A 2x2x2 mesh at the origin, seen from a camera on the +Z axis looking at it.
+struct Scene {
+
+	Instance instance;
+	CameraMatrix projection;
+
+	Scene() {
+		instance.base_type = VS::INSTANCE_MESH;
+		set_scale(1);
+		projection.set_perspective(70, 1, 0.05, 1000);
+	}
+
+	void set_scale(float p_scale) {
+		instance.transform = Transform(Basis().scaled(Vector3(p_scale, p_scale, p_scale)), Vector3());
+		instance.transformed_aabb = instance.transform.xform(AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)));
+	}
+
+	// p_distance is measured from the closest point of the bounds
+	float get_error(float p_distance, bool p_orthogonal = false, float p_threshold = THRESHOLD) {
+		Transform camera(Basis(), Vector3(0, 0, instance.transformed_aabb.position.z + instance.transformed_aabb.size.z + p_distance));
+		VisualServerScene::_instance_update_lod_error(&instance, camera, projection, p_orthogonal, p_threshold);
+		return instance.lod_error;
+	}
+};
+
+static void _check(const char *p_what, bool p_ok, bool &r_ok) {
+
+	OS::get_singleton()->print("%s: %s\n", p_what, p_ok ? "OK" : "FAIL");
+	r_ok = r_ok && p_ok;
+}
+
+static bool _test_error() {
+
+	Scene scene;
+	bool ok = true;
+
+	float expected = THRESHOLD * 2.0 * 10 / scene.projection.matrix[1][1];
+	_check("Error at distance 10", Math::is_equal_approx(scene.get_error(10), expected), ok);
+	_check("Error grows with the distance", Math::is_equal_approx(scene.get_error(20), expected * 2), ok);
+	_check("Camera inside the bounds uses full detail", scene.get_error(-1) == 0, ok);
+	_check("Orthogonal camera ignores the distance", Math::is_equal_approx(scene.get_error(10, true), scene.get_error(1000, true)), ok);
+	_check("Mesh LODs disabled", scene.get_error(10, false, 0) == 0, ok);
+
+	scene.set_scale(2);
+	_check("Error is in the local space of the mesh", Math::is_equal_approx(scene.get_error(20), expected), ok);
+
+	scene.set_scale(1);
+	scene.instance.base_type = VS::INSTANCE_MULTIMESH;
+	_check("Only meshes use LODs", scene.get_error(10) == 0, ok);
+
+	return ok;
+}
+
+#ifdef GLES_ENABLED
+static bool _test_selection() {
+
+	RasterizerStorageGLES3::Surface surface;
+	RasterizerStorageGLES3::Surface::LOD lod;
+	lod.index_id = 0;
+	lod.array_id = 0;
+	lod.instancing_array_id = 0;
+	lod.index_array_len = 0;
+
+	float errors[3] = { 0.005, 0.02, 0.08 };
+	for (int i = 0; i < 3; i++) {
+		lod.error = errors[i];
+		surface.lods.push_back(lod);
+	}
+
+	Scene scene;
+	bool ok = true;
+
+	_check("Close mesh draws full detail", surface.get_lod(scene.get_error(1)) == NULL, ok);
+	_check("Mesh at 5 draws the first LOD", surface.get_lod(scene.get_error(5)) == &surface.lods[0], ok);
+	_check("Mesh at 20 draws the second LOD", surface.get_lod(scene.get_error(20)) == &surface.lods[1], ok);
+	_check("Mesh at 100 draws the last LOD", surface.get_lod(scene.get_error(100)) == &surface.lods[2], ok);
+
+	scene.set_scale(2);
+	_check("Scaled mesh at 20 draws the first LOD", surface.get_lod(scene.get_error(20)) == &surface.lods[0], ok);
+
+	return ok;
+}
+#endif
+
+MainLoop *test() {
+
+	bool ok = _test_error();
+#ifdef GLES_ENABLED
+	ok = _test_selection() && ok;
+#endif
+
+	OS::get_singleton()->print(ok ? "All mesh LOD tests passed.\n" : "Some mesh LOD tests failed!\n");
+
+	return NULL;
+}
+} // namespace TestMeshLOD
+
+#endif // _3D_DISABLED
@@ -0,0 +1,251 @@
+/*************************************************************************/
+/*  test_mesh_simplifier.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_mesh_simplifier.h"
+
+#include "core/math/mesh_simplifier.h"
+#include "core/os/os.h"
+
+namespace TestMeshSimplifier {
+
+// Closed sphere without duplicated vertices, so nothing is locked.
+static void _make_sphere(int p_rings, int p_segments, Vector<Vector3> &r_vertices, Vector<int> &r_indices) {
+
+	r_vertices.push_back(Vector3(0, 1, 0));
+	for (int i = 1; i < p_rings; i++) {
+		float lat = Math_PI * i / p_rings;
+		for (int j = 0; j < p_segments; j++) {
+			float lon = Math_PI * 2.0 * j / p_segments;
+			r_vertices.push_back(Vector3(Math::sin(lat) * Math::cos(lon), Math::cos(lat), Math::sin(lat) * Math::sin(lon)));
+		}
+	}
+	r_vertices.push_back(Vector3(0, -1, 0));
+
+	int bottom = r_vertices.size() - 1;
+
+	for (int j = 0; j < p_segments; j++) {
+		int j2 = (j + 1) % p_segments;
+
+		r_indices.push_back(0);
+		r_indices.push_back(1 + j2);
+		r_indices.push_back(1 + j);
+
+		for (int i = 0; i < p_rings - 2; i++) {
+			int a = 1 + i * p_segments + j;
+			int b = 1 + i * p_segments + j2;
+			int c = 1 + (i + 1) * p_segments + j;
+			int d = 1 + (i + 1) * p_segments + j2;
+
+			r_indices.push_back(a);
+			r_indices.push_back(b);
+			r_indices.push_back(c);
+
+			r_indices.push_back(b);
+			r_indices.push_back(d);
+			r_indices.push_back(c);
+		}
+
+		r_indices.push_back(bottom);
+		r_indices.push_back(1 + (p_rings - 2) * p_segments + j);
+		r_indices.push_back(1 + (p_rings - 2) * p_segments + j2);
+	}
+}
+
+// Flat grid in XZ, facing +Y, with its middle column of vertices duplicated
+// like a uv seam.
+static void _make_grid(int p_size, Vector<Vector3> &r_vertices, Vector<int> &r_indices, int &r_seam_begin) {
+
+	int row = p_size + 1;
+	int seam = p_size / 2;
+
+	for (int i = 0; i <= p_size; i++) {
+		for (int j = 0; j <= p_size; j++) {
+			r_vertices.push_back(Vector3(j, 0, i));
+		}
+	}
+
+	r_seam_begin = r_vertices.size();
+	for (int i = 0; i <= p_size; i++) {
+		r_vertices.push_back(Vector3(seam, 0, i));
+	}
+
+	for (int i = 0; i < p_size; i++) {
+		for (int j = 0; j < p_size; j++) {
+			int a = i * row + j;
+			int b = a + 1;
+			int c = a + row;
+			int d = c + 1;
+
+			// right of the seam uses the duplicates
+			if (j == seam) {
+				a = r_seam_begin + i;
+				c = r_seam_begin + i + 1;
+			}
+
+			r_indices.push_back(a);
+			r_indices.push_back(c);
+			r_indices.push_back(b);
+
+			r_indices.push_back(b);
+			r_indices.push_back(c);
+			r_indices.push_back(d);
+		}
+	}
+}
+
+static bool _check_valid(const char *p_name, const Vector<Vector3> &p_vertices, const Vector<int> &p_indices) {
+
+	if (p_indices.size() % 3 != 0) {
+		OS::get_singleton()->print("%s: index count is not a multiple of 3: FAIL\n", p_name);
+		return false;
+	}
+
+	for (int i = 0; i < p_indices.size(); i++) {
+		if (p_indices[i] < 0 || p_indices[i] >= p_vertices.size()) {
+			OS::get_singleton()->print("%s: index out of range: FAIL\n", p_name);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool _test_sphere() {
+
+	Vector<Vector3> vertices;
+	Vector<int> indices;
+	_make_sphere(32, 64, vertices, indices);
+
+	int target = indices.size() / 4;
+	float error = 0;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Vector<int> result = MeshSimplifier::simplify(vertices, indices, target, 1.0, &error);
+	uint64_t time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	bool ok = _check_valid("sphere", vertices, result);
+
+	// every triangle must still face outwards
+	for (int i = 0; ok && i < result.size(); i += 3) {
+		const Vector3 &a = vertices[result[i + 0]];
+		const Vector3 &b = vertices[result[i + 1]];
+		const Vector3 &c = vertices[result[i + 2]];
+		Vector3 normal = (b - a).cross(c - a);
+		if (normal.dot(a + b + c) <= 0) {
+			OS::get_singleton()->print("sphere: flipped triangle: FAIL\n");
+			ok = false;
+		}
+	}
+
+	if (ok && (result.size() > target || error <= 0 || error > 0.2)) {
+		OS::get_singleton()->print("sphere: unexpected result, %d indices, error %f: FAIL\n", result.size(), error);
+		ok = false;
+	}
+
+	OS::get_singleton()->print("sphere, %d -> %d indices, error %f, %d usec: %s\n", indices.size(), result.size(), error, int(time), ok ? "OK" : "FAIL");
+
+	// without a target, the error limit alone has to stop the simplification
+	float coarse_error = 0;
+	Vector<int> coarse = MeshSimplifier::simplify(vertices, indices, 0, 0.01, &coarse_error);
+	float fine_error = 0;
+	Vector<int> fine = MeshSimplifier::simplify(vertices, indices, 0, 0.001, &fine_error);
+
+	bool limit_ok = _check_valid("sphere, error limit", vertices, coarse) && _check_valid("sphere, error limit", vertices, fine);
+	limit_ok = limit_ok && coarse_error <= 0.01 && fine_error <= 0.001 && coarse.size() < fine.size() && fine.size() < indices.size();
+
+	OS::get_singleton()->print("sphere, error limits 0.01 and 0.001, %d -> %d and %d indices: %s\n", indices.size(), coarse.size(), fine.size(), limit_ok ? "OK" : "FAIL");
+
+	return ok && limit_ok;
+}
+
+static bool _test_grid() {
+
+	Vector<Vector3> vertices;
+	Vector<int> indices;
+	int seam_begin = 0;
+	_make_grid(16, vertices, indices, seam_begin);
+
+	float error = 0;
+	Vector<int> result = MeshSimplifier::simplify(vertices, indices, 0, 0.001, &error);
+
+	bool ok = _check_valid("grid", vertices, result);
+
+	// flat, so collapsing costs nothing, but borders and the seam must stay
+	if (ok && (result.size() >= indices.size() || error > 0.001)) {
+		OS::get_singleton()->print("grid: nothing simplified: FAIL\n");
+		ok = false;
+	}
+
+	Vector<bool> used;
+	used.resize(vertices.size());
+	for (int i = 0; i < used.size(); i++) {
+		used.write[i] = false;
+	}
+	for (int i = 0; i < result.size(); i++) {
+		used.write[result[i]] = true;
+	}
+
+	for (int i = 0; ok && i < vertices.size(); i++) {
+		const Vector3 &v = vertices[i];
+		bool border = v.x == 0 || v.z == 0 || v.x == 16 || v.z == 16;
+		bool seam = v.x == 8;
+		if ((border || seam) && !used[i]) {
+			OS::get_singleton()->print("grid: border or seam vertex %d removed: FAIL\n", i);
+			ok = false;
+		}
+	}
+
+	for (int i = 0; ok && i < result.size(); i += 3) {
+		const Vector3 &a = vertices[result[i + 0]];
+		const Vector3 &b = vertices[result[i + 1]];
+		const Vector3 &c = vertices[result[i + 2]];
+		if ((b - a).cross(c - a).y <= 0) {
+			OS::get_singleton()->print("grid: flipped triangle: FAIL\n");
+			ok = false;
+		}
+	}
+
+	OS::get_singleton()->print("grid, %d -> %d indices, error %f: %s\n", indices.size(), result.size(), error, ok ? "OK" : "FAIL");
+
+	return ok;
+}
+
+MainLoop *test() {
+
+	bool ok = true;
+
+	ok = _test_sphere() && ok;
+	ok = _test_grid() && ok;
+
+	OS::get_singleton()->print(ok ? "All mesh simplifier tests passed.\n" : "Some mesh simplifier tests failed!\n");
+
+	return NULL;
+}
+} // namespace TestMeshSimplifier
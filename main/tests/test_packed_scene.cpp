@@ -0,0 +1,147 @@
+/*************************************************************************/
+/*  test_packed_scene.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_packed_scene.h"
+
+#include "core/os/os.h"
+#include "scene/2d/sprite.h"
+#include "scene/resources/packed_scene.h"
+
+namespace TestPackedScene {
+
+static Ref<PackedScene> _make_scene() {
+
+	Node2D *root = memnew(Node2D);
+	root->set_name("Root");
+
+	Sprite *child = memnew(Sprite);
+	child->set_name("Child");
+	child->set_position(Vector2(10, 20));
+	child->add_to_group("enemies", true);
+	root->add_child(child);
+	child->set_owner(root);
+
+	child->connect("visibility_changed", root, "update", Vector<Variant>(), Object::CONNECT_PERSIST);
+
+	Ref<PackedScene> scene;
+	scene.instance();
+	scene->pack(root);
+	memdelete(root);
+
+	return scene;
+}
+
+static bool _test_restore() {
+
+	Ref<PackedScene> scene = _make_scene();
+	scene->set_pool_capacity(4);
+
+	Node *node = scene->instance_pooled();
+	Sprite *child = Object::cast_to<Sprite>(node->get_node(NodePath("Child")));
+
+	// change everything the pool puts back
+	child->set_position(Vector2(-5, 3));
+	child->set_modulate(Color(1, 0, 0));
+	child->set_flip_h(true);
+	child->remove_from_group("enemies");
+	child->add_to_group("extra", true);
+	child->add_to_group("runtime");
+	child->disconnect("visibility_changed", node, "update");
+
+	Node *added = memnew(Node);
+	child->add_child(added);
+
+	scene->release_to_pool(node);
+	Node *reused = scene->instance_pooled();
+
+	bool ok = reused == node;
+	ok = ok && child->get_position() == Vector2(10, 20);
+	ok = ok && child->get_modulate() == Color(1, 1, 1) && !child->is_flipped_h();
+	ok = ok && child->is_in_group("enemies") && !child->is_in_group("extra");
+	ok = ok && child->is_connected("visibility_changed", node, "update");
+	// documented to be kept
+	ok = ok && child->is_in_group("runtime") && added->get_parent() == child;
+	OS::get_singleton()->print("Restoring a pooled instance: %s\n", ok ? "OK" : "FAIL");
+
+	memdelete(reused);
+	return ok;
+}
+
+static bool _test_double_release() {
+
+	Ref<PackedScene> scene = _make_scene();
+	scene->set_pool_capacity(1);
+
+	Node *a = scene->instance_pooled();
+	scene->release_to_pool(a);
+	OS::get_singleton()->print("Releasing twice, an error is expected:\n");
+	scene->release_to_pool(a); // pool is full, must neither free nor add it again
+
+	bool ok = scene->get_pooled_count() == 1 && ObjectDB::get_instance(a->get_instance_id()) == a;
+
+	Node *b = scene->instance_pooled();
+	Node *c = scene->instance_pooled();
+	ok = ok && b == a && c != a;
+	OS::get_singleton()->print("Releasing a pooled instance twice: %s\n", ok ? "OK" : "FAIL");
+
+	memdelete(b);
+	memdelete(c);
+	return ok;
+}
+
+static bool _test_lost_node() {
+
+	Ref<PackedScene> scene = _make_scene();
+	scene->set_pool_capacity(1);
+
+	Node *node = scene->instance_pooled();
+	memdelete(node->get_node(NodePath("Child")));
+	scene->release_to_pool(node);
+
+	// can't be restored, so a new instance is made
+	Node *reused = scene->instance_pooled();
+	bool ok = reused && reused->has_node(NodePath("Child")) && scene->get_pooled_count() == 0;
+	OS::get_singleton()->print("Reusing an instance that lost a node: %s\n", ok ? "OK" : "FAIL");
+
+	memdelete(reused);
+	return ok;
+}
+
+MainLoop *test() {
+
+	bool ok = _test_restore();
+	ok = _test_double_release() && ok;
+	ok = _test_lost_node() && ok;
+
+	OS::get_singleton()->print(ok ? "All packed scene tests passed.\n" : "Some packed scene tests failed!\n");
+
+	return NULL;
+}
+} // namespace TestPackedScene
@@ -0,0 +1,151 @@
+/*************************************************************************/
+/*  test_radix_sort.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_radix_sort.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/radix_sort.h"
+#include "core/sort_array.h"
+
+namespace TestRadixSort {
+
+// Same layout as the render list elements, sorted through pointers.
+struct Element {
+	uint64_t sort_key;
+	float depth;
+};
+
+struct KeyGetter {
+	_FORCE_INLINE_ uint64_t operator()(const Element *A) const {
+		return A->sort_key;
+	}
+};
+
+struct KeyComparator {
+	_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
+		return A->sort_key < B->sort_key;
+	}
+};
+
+struct DepthGetter {
+	_FORCE_INLINE_ uint64_t operator()(const Element *A) const {
+		return RadixSort<Element *>::float_to_key(A->depth);
+	}
+};
+
+struct DepthComparator {
+	_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
+		return A->depth < B->depth;
+	}
+};
+
+static void _fill(Element *p_elements, Element **r_ptrs, int p_count, int p_key_bits) {
+	// Shuffle the storage order so the pointers are scattered like in a real list.
+	for (int i = 0; i < p_count; i++) {
+		Element &e = p_elements[i];
+		e.sort_key = ((uint64_t(Math::rand()) << 32) | Math::rand());
+		if (p_key_bits < 64) {
+			e.sort_key &= (uint64_t(1) << p_key_bits) - 1;
+		}
+		e.depth = Math::random(-1000.0, 1000.0);
+		r_ptrs[i] = &e;
+	}
+	for (int i = p_count - 1; i > 0; i--) {
+		SWAP(r_ptrs[i], r_ptrs[Math::rand() % (i + 1)]);
+	}
+}
+
+template <class Getter, class Comparator>
+static bool _test_sort(const char *p_name, int p_count, int p_key_bits) {
+
+	Element *elements = memnew_arr(Element, p_count);
+	Element **radix = memnew_arr(Element *, p_count);
+	Element **intro = memnew_arr(Element *, p_count);
+
+	_fill(elements, radix, p_count, p_key_bits);
+	for (int i = 0; i < p_count; i++) {
+		intro[i] = radix[i];
+	}
+
+	RadixSort<Element *> radix_sorter;
+	// Warm up the scratch buffers, they are kept between sorts in the render lists.
+	radix_sorter.sort(radix, p_count, Getter());
+	_fill(elements, radix, p_count, p_key_bits);
+	for (int i = 0; i < p_count; i++) {
+		intro[i] = radix[i];
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	radix_sorter.sort(radix, p_count, Getter());
+	uint64_t radix_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	SortArray<Element *, Comparator> intro_sorter;
+	begin = OS::get_singleton()->get_ticks_usec();
+	intro_sorter.sort(intro, p_count);
+	uint64_t intro_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	Getter get_key;
+	bool ok = true;
+	for (int i = 0; i < p_count; i++) {
+		// Ties may be ordered differently, as only the radix sort is stable.
+		if (get_key(radix[i]) != get_key(intro[i]) || (i > 0 && get_key(radix[i - 1]) > get_key(radix[i]))) {
+			ok = false;
+			break;
+		}
+	}
+
+	OS::get_singleton()->print("%s, %d elements: radix %d usec, introsort %d usec: %s\n", p_name, p_count, int(radix_time), int(intro_time), ok ? "OK" : "FAIL");
+
+	memdelete_arr(intro);
+	memdelete_arr(radix);
+	memdelete_arr(elements);
+
+	return ok;
+}
+
+MainLoop *test() {
+
+	Math::seed(0);
+
+	bool ok = true;
+
+	const int counts[] = { 1, 2, 17, 32, 33, 1000, 10000, 65536 };
+	for (int i = 0; i < int(sizeof(counts) / sizeof(counts[0])); i++) {
+		ok = _test_sort<KeyGetter, KeyComparator>("64-bit keys", counts[i], 64) && ok;
+		ok = _test_sort<KeyGetter, KeyComparator>("16-bit keys", counts[i], 16) && ok;
+		ok = _test_sort<DepthGetter, DepthComparator>("depth", counts[i], 64) && ok;
+	}
+
+	OS::get_singleton()->print(ok ? "All radix sort tests passed.\n" : "Some radix sort tests failed!\n");
+
+	return NULL;
+}
+} // namespace TestRadixSort
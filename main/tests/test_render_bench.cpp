@@ -0,0 +1,302 @@
+/*************************************************************************/
+/*  test_render_bench.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_render_bench.h"
+
+#include "core/io/json.h"
+#include "core/math/math_funcs.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "servers/visual/visual_server_canvas.h"
+#include "servers/visual/visual_server_globals.h"
+#include "servers/visual/visual_server_scene.h"
+
+// Measures the CPU side of rendering (instance updates, culling, canvas
+// traversal) on synthetic scenes. Meant to run on the headless server
+// platform, where the dummy rasterizer makes draw submission free, so only
+// the visual server's own work is timed:
+//
+//   godot_server --test render_bench [--frames N] [--json path]
+//
+// Results are printed, and written to the given path, as JSON.
+
+namespace TestRenderBench {
+
+static const Size2 viewport_size = Size2(1024, 600);
+
+struct Phase {
+	uint64_t total;
+	uint64_t min;
+	uint64_t max;
+
+	void add(uint64_t p_usec) {
+		total += p_usec;
+		min = MIN(min, p_usec);
+		max = MAX(max, p_usec);
+	}
+
+	Dictionary to_dict(int p_frames) const {
+		Dictionary d;
+		d["total_usec"] = total;
+		d["mean_usec"] = p_frames ? double(total) / p_frames : 0.0;
+		d["min_usec"] = p_frames ? min : 0;
+		d["max_usec"] = max;
+		return d;
+	}
+
+	Phase() {
+		total = 0;
+		min = UINT64_MAX;
+		max = 0;
+	}
+};
+
+struct BenchScene {
+	const char *name;
+	int instances;
+	int lights;
+	int canvas_items;
+	float moving; // fraction of instances, lights and items moved every frame
+};
+
+static RID _make_box_mesh() {
+
+	PoolVector<Vector3> vertices;
+	for (int i = 0; i < 8; i++) {
+		vertices.push_back(Vector3(i & 1 ? 0.5 : -0.5, i & 2 ? 0.5 : -0.5, i & 4 ? 0.5 : -0.5));
+	}
+	static const int faces[36] = {
+		0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5,
+		0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3,
+		0, 4, 5, 0, 5, 1, 2, 3, 7, 2, 7, 6
+	};
+	PoolVector<int> indices;
+	for (int i = 0; i < 36; i++) {
+		indices.push_back(faces[i]);
+	}
+
+	Array arrays;
+	arrays.resize(VS::ARRAY_MAX);
+	arrays[VS::ARRAY_VERTEX] = vertices;
+	arrays[VS::ARRAY_INDEX] = indices;
+
+	RID mesh = VS::get_singleton()->mesh_create();
+	VS::get_singleton()->mesh_add_surface_from_arrays(mesh, VS::PRIMITIVE_TRIANGLES, arrays);
+	return mesh;
+}
+
+static Vector3 _random_position() {
+	// a slab in front of the camera, wider than the view so part of it is culled
+	return Vector3(Math::random(-100.0, 100.0), Math::random(-20.0, 20.0), Math::random(-150.0, -1.0));
+}
+
+static Vector2 _random_position_2d() {
+	return Vector2(Math::random(-256.0, viewport_size.width + 256.0), Math::random(-256.0, viewport_size.height + 256.0));
+}
+
+static Dictionary _run_scene(const BenchScene &p_scene, int p_frames) {
+
+	VisualServer *vs = VS::get_singleton();
+
+	RID scenario = vs->scenario_create();
+	RID camera = vs->camera_create();
+	vs->camera_set_perspective(camera, 70, 0.05, 200);
+
+	RID mesh = _make_box_mesh();
+	Vector<RID> instances;
+	for (int i = 0; i < p_scene.instances; i++) {
+		RID instance = vs->instance_create2(mesh, scenario);
+		vs->instance_set_transform(instance, Transform(Basis(), _random_position()));
+		instances.push_back(instance);
+	}
+
+	Vector<RID> lights;
+	Vector<RID> light_instances;
+	for (int i = 0; i < p_scene.lights; i++) {
+		RID light = vs->omni_light_create();
+		vs->light_set_param(light, VS::LIGHT_PARAM_RANGE, 8.0);
+		RID instance = vs->instance_create2(light, scenario);
+		vs->instance_set_transform(instance, Transform(Basis(), _random_position()));
+		lights.push_back(light);
+		light_instances.push_back(instance);
+	}
+
+	RID canvas = vs->canvas_create();
+	Vector<RID> items;
+	for (int i = 0; i < p_scene.canvas_items; i++) {
+		RID item = vs->canvas_item_create();
+		vs->canvas_item_set_parent(item, canvas);
+		vs->canvas_item_add_rect(item, Rect2(0, 0, 16, 16), Color(1, 1, 1));
+		vs->canvas_item_set_transform(item, Transform2D(0, _random_position_2d()));
+		items.push_back(item);
+	}
+	VisualServerCanvas::Canvas *canvas_ptr = VSG::canvas->canvas_owner.getornull(canvas);
+
+	// what render_camera() sets up, so culling and drawing can be timed apart
+	VisualServerScene::Camera *camera_ptr = VSG::scene->camera_owner.getornull(camera);
+	CameraMatrix camera_matrix;
+	camera_matrix.set_perspective(camera_ptr->fov, viewport_size.width / viewport_size.height, camera_ptr->znear, camera_ptr->zfar, camera_ptr->vaspect);
+	float lod_threshold = VSG::scene->_get_screen_lod_threshold(viewport_size);
+
+	// first frame pays for the initial instance updates, keep it out of the stats
+	VSG::scene->update_dirty_instances();
+
+	Phase update_phase;
+	Phase prepare_phase;
+	Phase render_phase;
+	Phase canvas_phase;
+
+	for (int f = 0; f < p_frames; f++) {
+
+		for (int i = 0; i < int(instances.size() * p_scene.moving); i++) {
+			vs->instance_set_transform(instances[Math::rand() % instances.size()], Transform(Basis(), _random_position()));
+		}
+		for (int i = 0; i < int(light_instances.size() * p_scene.moving); i++) {
+			vs->instance_set_transform(light_instances[Math::rand() % light_instances.size()], Transform(Basis(), _random_position()));
+		}
+		for (int i = 0; i < int(items.size() * p_scene.moving); i++) {
+			vs->canvas_item_set_transform(items[Math::rand() % items.size()], Transform2D(0, _random_position_2d()));
+		}
+
+		VSG::rasterizer->begin_frame(0.0);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		VSG::scene->update_dirty_instances();
+		uint64_t end = OS::get_singleton()->get_ticks_usec();
+		update_phase.add(end - begin);
+
+		begin = end;
+		VSG::scene->_prepare_scene(camera_ptr->transform, camera_matrix, false, camera_ptr->env, camera_ptr->visible_layers, scenario, RID(), RID(), lod_threshold);
+		end = OS::get_singleton()->get_ticks_usec();
+		prepare_phase.add(end - begin);
+
+		begin = end;
+		VSG::scene->_render_scene(camera_ptr->transform, camera_matrix, false, camera_ptr->env, scenario, RID(), RID(), -1);
+		end = OS::get_singleton()->get_ticks_usec();
+		render_phase.add(end - begin);
+
+		begin = end;
+		VSG::canvas->render_canvas(canvas_ptr, Transform2D(), NULL, NULL, Rect2(Point2(), viewport_size), 0);
+		end = OS::get_singleton()->get_ticks_usec();
+		canvas_phase.add(end - begin);
+
+		VSG::rasterizer->end_frame(false);
+	}
+
+	// render info is reported for the previous frame
+	VSG::rasterizer->begin_frame(0.0);
+	Dictionary render_info;
+	render_info["objects"] = VSG::storage->get_render_info(VS::INFO_OBJECTS_IN_FRAME);
+	render_info["draw_calls"] = VSG::storage->get_render_info(VS::INFO_DRAW_CALLS_IN_FRAME);
+	render_info["2d_items"] = VSG::storage->get_render_info(VS::INFO_2D_ITEMS_IN_FRAME);
+	render_info["2d_draw_calls"] = VSG::storage->get_render_info(VS::INFO_2D_DRAW_CALLS_IN_FRAME);
+	VSG::rasterizer->end_frame(false);
+
+	for (int i = 0; i < items.size(); i++) {
+		vs->free(items[i]);
+	}
+	vs->free(canvas);
+	for (int i = 0; i < light_instances.size(); i++) {
+		vs->free(light_instances[i]);
+		vs->free(lights[i]);
+	}
+	for (int i = 0; i < instances.size(); i++) {
+		vs->free(instances[i]);
+	}
+	vs->free(mesh);
+	vs->free(camera);
+	vs->free(scenario);
+
+	Dictionary phases;
+	phases["update_dirty_instances"] = update_phase.to_dict(p_frames);
+	phases["prepare_scene"] = prepare_phase.to_dict(p_frames); // culling, lights and shadows
+	phases["render_scene"] = render_phase.to_dict(p_frames); // submission to the rasterizer
+	phases["render_canvas"] = canvas_phase.to_dict(p_frames);
+
+	Dictionary result;
+	result["instances"] = p_scene.instances;
+	result["lights"] = p_scene.lights;
+	result["canvas_items"] = p_scene.canvas_items;
+	result["phases"] = phases;
+	result["render_info"] = render_info;
+	return result;
+}
+
+MainLoop *test(const List<String> &p_args) {
+
+	int frames = 100;
+	String json_path;
+	for (const List<String>::Element *E = p_args.front(); E; E = E->next()) {
+		if (E->get() == "--frames" && E->next()) {
+			frames = MAX(E->next()->get().to_int(), 1);
+		} else if (E->get() == "--json" && E->next()) {
+			json_path = E->next()->get();
+		}
+	}
+
+	ERR_FAIL_COND_V_MSG(OS::get_singleton()->get_render_thread_mode() == OS::RENDER_SEPARATE_THREAD, NULL, "The render benchmark calls the visual server directly and can't run with a separate render thread.");
+	if (OS::get_singleton()->get_name() != "Server") {
+		WARN_PRINT("Not running on the headless server platform, timings include draw submission to the GPU driver.");
+	}
+
+	static const BenchScene scenes[] = {
+		{ "instances", 20000, 0, 0, 0.05 },
+		{ "lights", 4000, 256, 0, 0.05 },
+		{ "canvas", 0, 0, 10000, 0.05 },
+		{ "mixed", 10000, 64, 5000, 0.05 },
+	};
+
+	Math::seed(0);
+
+	Dictionary results;
+	for (int i = 0; i < int(sizeof(scenes) / sizeof(scenes[0])); i++) {
+		results[scenes[i].name] = _run_scene(scenes[i], frames);
+	}
+
+	Dictionary report;
+	report["frames"] = frames;
+	report["video_driver"] = OS::get_singleton()->get_video_driver_name(OS::get_singleton()->get_current_video_driver());
+	report["scenes"] = results;
+
+	String json = JSON::print(report, "\t");
+	OS::get_singleton()->print("%s\n", json.utf8().get_data());
+
+	if (json_path != String()) {
+		Error err;
+		FileAccess *f = FileAccess::open(json_path, FileAccess::WRITE, &err);
+		ERR_FAIL_COND_V_MSG(!f, NULL, "Can't write the render benchmark results to '" + json_path + "'.");
+		f->store_string(json);
+		f->close();
+		memdelete(f);
+	}
+
+	return NULL;
+}
+} // namespace TestRenderBench
@@ -0,0 +1,123 @@
+/*************************************************************************/
+/*  test_resource_cache.cpp                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_resource_cache.h"
+
+#include "core/os/os.h"
+#include "core/resource.h"
+
+namespace TestResourceCache {
+
+class SizedResource : public Resource {
+public:
+	uint64_t size;
+
+	virtual uint64_t get_memory_usage() const { return size; }
+
+	SizedResource(uint64_t p_size) { size = p_size; }
+};
+
+// What a load does: the loaded resource is retained while the caller still
+// holds it, then the caller lets go.
+static ObjectID _load(uint64_t p_size) {
+
+	Ref<Resource> res = memnew(SizedResource(p_size));
+	ResourceCache::soft_retain(res);
+	return res->get_instance_id();
+}
+
+static void _load_again(ObjectID p_id) {
+
+	Ref<Resource> res = Object::cast_to<Resource>(ObjectDB::get_instance(p_id));
+	ResourceCache::soft_retain(res);
+}
+
+static bool _alive(ObjectID p_id) {
+
+	return ObjectDB::get_instance(p_id) != NULL;
+}
+
+static void _check(const char *p_what, bool p_ok, bool &r_ok) {
+
+	OS::get_singleton()->print("%s: %s\n", p_what, p_ok ? "OK" : "FAIL");
+	r_ok = r_ok && p_ok;
+}
+
+MainLoop *test() {
+
+	uint64_t old_budget = ResourceCache::get_soft_budget();
+	ResourceCache::clear_soft_cache();
+	ResourceCache::set_soft_budget(100);
+
+	bool ok = true;
+
+	ObjectID empty = _load(0);
+	_check("Resources without a size are not retained", !_alive(empty) && ResourceCache::get_soft_cached_count() == 0, ok);
+
+	// The resource being loaded is still referenced, so it doesn't count yet.
+	ObjectID a = _load(40);
+	ObjectID b = _load(40);
+	ObjectID c = _load(40);
+	_check("Retained below the budget", _alive(a) && _alive(b) && _alive(c) && ResourceCache::get_soft_cached_count() == 3, ok);
+	_check("Unreferenced bytes", ResourceCache::get_soft_cached_bytes() == 120, ok);
+
+	ObjectID d = _load(40);
+	_check("Least recently loaded evicted first", !_alive(a) && _alive(b) && _alive(c) && _alive(d), ok);
+
+	_load_again(b);
+	ObjectID e = _load(40);
+	_check("Loading again makes a resource recent", !_alive(c) && _alive(b) && _alive(d) && _alive(e), ok);
+
+	Ref<Resource> held = memnew(SizedResource(1000));
+	ResourceCache::soft_retain(held);
+	ObjectID f = _load(40);
+	_check("Referenced resources cost nothing", _alive(held->get_instance_id()) && !_alive(d) && _alive(b) && _alive(e) && _alive(f), ok);
+	_check("Referenced resources are not counted", ResourceCache::get_soft_cached_bytes() == 120, ok);
+
+	ResourceCache::set_soft_budget(50);
+	_check("Lowering the budget evicts", !_alive(b) && !_alive(e) && _alive(f) && ResourceCache::get_soft_cached_count() == 2, ok);
+	_check("Unreferenced bytes within the budget", ResourceCache::get_soft_cached_bytes() == 40, ok);
+
+	ObjectID held_id = held->get_instance_id();
+	held.unref();
+	_check("Released resources are kept until the next trim", _alive(held_id) && ResourceCache::get_soft_cached_bytes() == 1040, ok);
+	ResourceCache::set_soft_budget(50);
+	_check("Released resources count against the budget", !_alive(held_id) && _alive(f) && ResourceCache::get_soft_cached_bytes() == 40, ok);
+
+	ResourceCache::set_soft_budget(0);
+	_check("Disabling the cache frees everything", !_alive(f) && ResourceCache::get_soft_cached_count() == 0 && ResourceCache::get_soft_cached_bytes() == 0, ok);
+
+	ResourceCache::set_soft_budget(old_budget);
+
+	OS::get_singleton()->print(ok ? "All resource cache tests passed.\n" : "Some resource cache tests failed!\n");
+
+	return NULL;
+}
+} // namespace TestResourceCache
@@ -0,0 +1,193 @@
+/*************************************************************************/
+/*  test_skinning.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef _3D_DISABLED
+
+#include "test_skinning.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/os/thread_work_pool.h"
+#include "scene/3d/mesh_instance.h"
+
+namespace TestSkinning {
+
+static const int BONES = 64;
+static const int VERTICES = 100000;
+
+// Interleaved like a software skinning source buffer: vertex, normal, tangent, bones, weights.
+enum {
+	OFFSET_VERTEX = 0,
+	OFFSET_NORMAL = 12,
+	OFFSET_TANGENT = 24,
+	OFFSET_BONES = 40,
+	OFFSET_WEIGHTS = 44,
+	STRIDE = 60,
+	STRIDE_WRITE = 40,
+};
+
+static void _fill(uint8_t *r_source, Transform *r_bones) {
+
+	for (int i = 0; i < BONES; i++) {
+		Vector3 axis = Vector3(Math::random(-1.0, 1.0), Math::random(-1.0, 1.0), Math::random(-1.0, 1.0)).normalized();
+		r_bones[i].basis = Basis(axis, Math::random(-Math_PI, Math_PI)).scaled(Vector3(Math::random(0.5, 2.0), Math::random(0.5, 2.0), Math::random(0.5, 2.0)));
+		r_bones[i].origin = Vector3(Math::random(-2.0, 2.0), Math::random(-2.0, 2.0), Math::random(-2.0, 2.0));
+	}
+
+	for (int i = 0; i < VERTICES; i++) {
+		uint8_t *v = r_source + i * STRIDE;
+		*(Vector3 *)(v + OFFSET_VERTEX) = Vector3(Math::random(-1.0, 1.0), Math::random(-1.0, 1.0), Math::random(-1.0, 1.0));
+		*(Vector3 *)(v + OFFSET_NORMAL) = Vector3(Math::random(-1.0, 1.0), Math::random(-1.0, 1.0), Math::random(-1.0, 1.0)).normalized();
+		*(Vector3 *)(v + OFFSET_TANGENT) = Vector3(Math::random(-1.0, 1.0), Math::random(-1.0, 1.0), Math::random(-1.0, 1.0)).normalized();
+
+		float *weights = (float *)(v + OFFSET_WEIGHTS);
+		float total = 0;
+		for (int j = 0; j < 4; j++) {
+			v[OFFSET_BONES + j] = Math::rand() % BONES;
+			weights[j] = Math::random(0.0, 1.0);
+			total += weights[j];
+		}
+		for (int j = 0; j < 4; j++) {
+			weights[j] /= total;
+		}
+	}
+}
+
+// The per vertex Transform blending used before the flat kernel, as reference.
+static void _skin_reference(const uint8_t *p_source, uint8_t *r_dest, const Transform *p_bones, bool p_ensure_correct_normals) {
+
+	for (int i = 0; i < VERTICES; i++) {
+		const uint8_t *v = p_source + i * STRIDE;
+		uint8_t *w = r_dest + i * STRIDE_WRITE;
+		const uint8_t *b = v + OFFSET_BONES;
+		const float *weights = (const float *)(v + OFFSET_WEIGHTS);
+
+		Transform transform;
+		transform.origin = weights[0] * p_bones[b[0]].origin + weights[1] * p_bones[b[1]].origin + weights[2] * p_bones[b[2]].origin + weights[3] * p_bones[b[3]].origin;
+		transform.basis = p_bones[b[0]].basis * weights[0] + p_bones[b[1]].basis * weights[1] + p_bones[b[2]].basis * weights[2] + p_bones[b[3]].basis * weights[3];
+
+		*(Vector3 *)(w + OFFSET_VERTEX) = transform.xform(*(const Vector3 *)(v + OFFSET_VERTEX));
+
+		if (p_ensure_correct_normals) {
+			transform.basis.invert();
+			transform.basis.transpose();
+		}
+
+		*(Vector3 *)(w + OFFSET_NORMAL) = transform.basis.xform(*(const Vector3 *)(v + OFFSET_NORMAL));
+		*(Vector3 *)(w + OFFSET_TANGENT) = transform.basis.xform(*(const Vector3 *)(v + OFFSET_TANGENT));
+	}
+}
+
+static bool _compare(const uint8_t *p_a, const uint8_t *p_b) {
+
+	for (int i = 0; i < VERTICES; i++) {
+		for (int j = 0; j < 3; j++) {
+			const Vector3 &a = *(const Vector3 *)(p_a + i * STRIDE_WRITE + j * 12);
+			const Vector3 &b = *(const Vector3 *)(p_b + i * STRIDE_WRITE + j * 12);
+			if ((a - b).length() > 1e-4 * MAX(1.0, a.length())) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static bool _test_skinning(ThreadWorkPool &p_pool, bool p_ensure_correct_normals) {
+
+	uint8_t *source = memnew_arr(uint8_t, VERTICES * STRIDE);
+	uint8_t *reference = memnew_arr(uint8_t, VERTICES * STRIDE_WRITE);
+	uint8_t *dest = memnew_arr(uint8_t, VERTICES * STRIDE_WRITE);
+	Transform bones[BONES];
+
+	_fill(source, bones);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	_skin_reference(source, reference, bones, p_ensure_correct_normals);
+	uint64_t reference_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	SoftwareSkinningJob job;
+	job.read = source;
+	job.write = dest;
+	job.bone_transforms = bones;
+	job.vertex_count = VERTICES;
+	job.stride = STRIDE;
+	job.offset_vertices = OFFSET_VERTEX;
+	job.offset_normals = OFFSET_NORMAL;
+	job.offset_tangents = OFFSET_TANGENT;
+	job.offset_bones = OFFSET_BONES;
+	job.offset_weights = OFFSET_WEIGHTS;
+	job.stride_write = STRIDE_WRITE;
+	job.offset_vertices_write = OFFSET_VERTEX;
+	job.offset_normals_write = OFFSET_NORMAL;
+	job.offset_tangents_write = OFFSET_TANGENT;
+	job.transform_normals = true;
+	job.transform_tangents = true;
+	job.ensure_correct_normals = p_ensure_correct_normals;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	job.skin_range(0, VERTICES);
+	uint64_t kernel_time = OS::get_singleton()->get_ticks_usec() - begin;
+	bool ok = _compare(reference, dest);
+
+	zeromem(dest, VERTICES * STRIDE_WRITE);
+	const uint32_t chunk_count = (VERTICES + SoftwareSkinningJob::CHUNK_SIZE - 1) / SoftwareSkinningJob::CHUNK_SIZE;
+	begin = OS::get_singleton()->get_ticks_usec();
+	p_pool.do_work(chunk_count, &job, &SoftwareSkinningJob::skin_chunk, (void *)nullptr);
+	uint64_t pool_time = OS::get_singleton()->get_ticks_usec() - begin;
+	ok = _compare(reference, dest) && ok;
+
+	OS::get_singleton()->print("%d vertices%s: reference %d usec, kernel %d usec, kernel on %d threads %d usec: %s\n", VERTICES, p_ensure_correct_normals ? ", correct normals" : "", int(reference_time), int(kernel_time), int(p_pool.get_thread_count() + 1), int(pool_time), ok ? "OK" : "FAIL");
+
+	memdelete_arr(dest);
+	memdelete_arr(reference);
+	memdelete_arr(source);
+
+	return ok;
+}
+
+MainLoop *test() {
+
+	Math::seed(0);
+
+	ThreadWorkPool pool;
+	pool.init();
+
+	bool ok = _test_skinning(pool, false);
+	ok = _test_skinning(pool, true) && ok;
+
+	pool.finish();
+
+	OS::get_singleton()->print(ok ? "All software skinning tests passed.\n" : "Some software skinning tests failed!\n");
+
+	return NULL;
+}
+} // namespace TestSkinning
+
+#endif
@@ -0,0 +1,135 @@
+/*************************************************************************/
+/*  test_texture.cpp                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_texture.h"
+
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "scene/resources/texture.h"
+
+namespace TestTexture {
+
+static const int SIZE = 64;
+
+// Writes a streamable lossless .stex the way the texture importer does:
+// the mipmap count, then the size and PNG data of each mipmap.
+static bool _write_stex(const String &p_path) {
+
+	Ref<Image> image;
+	image.instance();
+	image->create(SIZE, SIZE, false, Image::FORMAT_RGBA8);
+	image->lock();
+	for (int y = 0; y < SIZE; y++) {
+		for (int x = 0; x < SIZE; x++) {
+			image->set_pixel(x, y, Color(x / float(SIZE), y / float(SIZE), (x ^ y) & 1, 1));
+		}
+	}
+	image->unlock();
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V(!f, false);
+
+	f->store_8('G');
+	f->store_8('D');
+	f->store_8('S');
+	f->store_8('T');
+	f->store_16(SIZE);
+	f->store_16(0);
+	f->store_16(SIZE);
+	f->store_16(0);
+	f->store_32(Texture::FLAG_MIPMAPS);
+	f->store_32(StreamTexture::FORMAT_BIT_LOSSLESS | StreamTexture::FORMAT_BIT_STREAM | StreamTexture::FORMAT_BIT_HAS_MIPMAPS);
+
+	image->generate_mipmaps();
+	int mipmaps = image->get_mipmap_count() + 1;
+	f->store_32(mipmaps);
+
+	for (int i = 0; i < mipmaps; i++) {
+		if (i > 0) {
+			image->shrink_x2();
+		}
+		PoolVector<uint8_t> data = Image::lossless_packer(image);
+		f->store_32(data.size());
+		PoolVector<uint8_t>::Read r = data.read();
+		f->store_buffer(r.ptr(), data.size());
+	}
+
+	memdelete(f);
+	return true;
+}
+
+static bool _test_stream_size_limit() {
+
+	String path = OS::get_singleton()->get_user_data_dir().plus_file("test_texture_stream.stex");
+	if (!_write_stex(path)) {
+		OS::get_singleton()->print("Could not write %s\n", path.utf8().get_data());
+		return false;
+	}
+
+	bool ok = true;
+	int limits[] = { 0, SIZE, SIZE / 2, 16, 1 };
+
+	for (int i = 0; i < 5; i++) {
+
+		Ref<StreamTexture> texture;
+		texture.instance();
+		texture->set_stream_size_limit(limits[i]);
+		Error err = texture->load(path);
+
+		// the largest mipmap within the limit comes first, the chain below it follows
+		int level = 0;
+		int size = SIZE;
+		while (limits[i] > 0 && size > limits[i] && size > 1) {
+			size >>= 1;
+			level++;
+		}
+		int expected = Image::get_image_data_size(size, size, Image::FORMAT_RGBA8, true);
+
+		bool limit_ok = err == OK && texture->is_streamable() && int(texture->get_memory_usage()) == expected;
+		limit_ok = limit_ok && texture->get_width() == SIZE && texture->get_height() == SIZE;
+
+		OS::get_singleton()->print("Stream size limit %d: mipmap %d (%dx%d) resident: %s\n", limits[i], level, size, size, limit_ok ? "OK" : "FAIL");
+		ok = ok && limit_ok;
+	}
+
+	DirAccess::remove_file_or_error(path);
+	return ok;
+}
+
+MainLoop *test() {
+
+	bool ok = _test_stream_size_limit();
+
+	OS::get_singleton()->print(ok ? "All texture tests passed.\n" : "Some texture tests failed!\n");
+
+	return NULL;
+}
+} // namespace TestTexture
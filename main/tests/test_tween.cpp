@@ -0,0 +1,248 @@
+/*************************************************************************/
+/*  test_tween.cpp                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_tween.h"
+
+#include "core/os/os.h"
+#include "core/script_language.h"
+#include "scene/2d/node_2d.h"
+#include "scene/animation/tween.h"
+#include "scene/gui/control.h"
+
+namespace TestTween {
+
+static const char *trans_names[Tween::TRANS_COUNT] = { "linear", "sine", "quint", "quart", "quad", "expo", "elastic", "cubic", "circ", "bounce", "back" };
+static const char *ease_names[Tween::EASE_COUNT] = { "in", "out", "in_out", "out_in" };
+
+// Tweens used to run the equation once per component with that component's
+// start and change values. They now run it once for a 0..1 ratio and scale
+// it, which only holds because every equation is linear in both.
+static bool _test_equations() {
+
+	static const real_t durations[] = { 1.0, 2.5 };
+	static const real_t starts[] = { 0.0, 3.0, -250.0, 10000.0 };
+	static const real_t changes[] = { 1.0, -7.0, 1000.0, 0.5 };
+	static const int STEPS = 40;
+
+	bool ok = true;
+
+	for (int trans = 0; trans < Tween::TRANS_COUNT; trans++) {
+
+		real_t max_error = 0;
+		bool trans_ok = true;
+
+		for (int ease = 0; ease < Tween::EASE_COUNT; ease++) {
+			for (int i = 0; i < 2; i++) {
+				real_t d = durations[i];
+				for (int step = 0; step <= STEPS; step++) {
+					real_t t = d * step / STEPS;
+					real_t ratio = Tween::run_equation(Tween::TransitionType(trans), Tween::EaseType(ease), t, 0, 1, d);
+
+					for (int j = 0; j < 4; j++) {
+						real_t b = starts[j];
+						real_t c = changes[j];
+						real_t old_value = Tween::run_equation(Tween::TransitionType(trans), Tween::EaseType(ease), t, b, c, d);
+						real_t new_value = b + c * ratio;
+
+						real_t error = Math::abs(old_value - new_value);
+						max_error = MAX(max_error, error / (Math::abs(b) + Math::abs(c)));
+						if (error > 1e-5 * (Math::abs(b) + Math::abs(c))) {
+							OS::get_singleton()->print("%s %s, t %f of %f, start %f, change %f: %f instead of %f\n", trans_names[trans], ease_names[ease], t, d, b, c, new_value, old_value);
+							trans_ok = false;
+						}
+					}
+				}
+			}
+		}
+
+		OS::get_singleton()->print("Ratio matches the per-component equation for %s, relative error %g: %s\n", trans_names[trans], max_error, trans_ok ? "OK" : "FAIL");
+		ok = ok && trans_ok;
+	}
+
+	return ok;
+}
+
+static bool _is_equal(real_t p_a, real_t p_b) {
+
+	return Math::abs(p_a - p_b) <= 1e-4 * MAX(1.0, Math::abs(p_b));
+}
+
+// The whole step, from the stored start and final values to the property.
+static bool _test_values() {
+
+	Tween *tween = memnew(Tween);
+	Node2D *node = memnew(Node2D);
+
+	Vector2 from_position(1, 2);
+	Vector2 to_position(-30, 50);
+	Color from_color(1, 0.5, 0, 1);
+	Color to_color(0, 0.25, 1, 0.5);
+	real_t duration = 2.0;
+	real_t time = 0.7;
+
+	bool ok = true;
+
+	for (int trans = 0; trans < Tween::TRANS_COUNT; trans++) {
+		for (int ease = 0; ease < Tween::EASE_COUNT; ease++) {
+
+			Tween::TransitionType tt = Tween::TransitionType(trans);
+			Tween::EaseType et = Tween::EaseType(ease);
+
+			tween->remove_all();
+			tween->interpolate_property(node, NodePath("position"), from_position, to_position, duration, tt, et);
+			tween->interpolate_property(node, NodePath("modulate"), from_color, to_color, duration, tt, et);
+			tween->interpolate_property(node, NodePath("rotation"), 0.5, -2.0, duration, tt, et);
+			tween->seek(time);
+
+#define CHECK_COMPONENT(m_value, m_from, m_to, m_element) \
+	_is_equal(m_value.m_element, Tween::run_equation(tt, et, time, m_from.m_element, m_to.m_element - m_from.m_element, duration))
+
+			Vector2 position = node->get_position();
+			Color color = node->get_modulate();
+			bool step_ok = CHECK_COMPONENT(position, from_position, to_position, x) && CHECK_COMPONENT(position, from_position, to_position, y);
+			step_ok = step_ok && CHECK_COMPONENT(color, from_color, to_color, r) && CHECK_COMPONENT(color, from_color, to_color, g);
+			step_ok = step_ok && CHECK_COMPONENT(color, from_color, to_color, b) && CHECK_COMPONENT(color, from_color, to_color, a);
+			step_ok = step_ok && _is_equal(node->get_rotation(), Tween::run_equation(tt, et, time, 0.5, -2.5, duration));
+
+#undef CHECK_COMPONENT
+
+			if (!step_ok) {
+				OS::get_singleton()->print("Tweened values for %s %s: FAIL\n", trans_names[trans], ease_names[ease]);
+				ok = false;
+			}
+		}
+	}
+
+	OS::get_singleton()->print("Tweened Vector2, Color and real values for every transition and ease: %s\n", ok ? "OK" : "FAIL");
+
+	memdelete(node);
+	memdelete(tween);
+	return ok;
+}
+
+// Takes over the position of its owner, the way a script with its own
+// position property or a _set() override would.
+class PositionScriptInstance : public ScriptInstance {
+public:
+	Variant position;
+	int sets;
+
+	virtual bool set(const StringName &p_name, const Variant &p_value) {
+		if (p_name != StringName("position")) {
+			return false;
+		}
+		position = p_value;
+		sets++;
+		return true;
+	}
+	virtual bool get(const StringName &p_name, Variant &r_ret) const { return false; }
+	virtual void get_property_list(List<PropertyInfo> *p_properties) const {}
+	virtual Variant::Type get_property_type(const StringName &p_name, bool *r_is_valid = NULL) const {
+		if (r_is_valid) {
+			*r_is_valid = false;
+		}
+		return Variant::NIL;
+	}
+	virtual void get_method_list(List<MethodInfo> *p_list) const {}
+	virtual bool has_method(const StringName &p_method) const { return false; }
+	virtual Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error) {
+		r_error.error = Variant::CallError::CALL_ERROR_INVALID_METHOD;
+		return Variant();
+	}
+	virtual void notification(int p_notification) {}
+	virtual Ref<Script> get_script() const { return Ref<Script>(); }
+	virtual MultiplayerAPI::RPCMode get_rpc_mode(const StringName &p_method) const { return MultiplayerAPI::RPC_MODE_DISABLED; }
+	virtual MultiplayerAPI::RPCMode get_rset_mode(const StringName &p_variable) const { return MultiplayerAPI::RPC_MODE_DISABLED; }
+	virtual ScriptLanguage *get_language() { return NULL; }
+
+	PositionScriptInstance() {
+		sets = 0;
+	}
+};
+
+// Plain properties are set through their cached setter, anything else has to
+// keep going through Object::set().
+static bool _test_setters() {
+
+	Tween *tween = memnew(Tween);
+	bool ok = true;
+
+	Node2D *node = memnew(Node2D);
+	tween->interpolate_property(node, NodePath("position"), Vector2(), Vector2(10, 20), 1.0);
+	tween->seek(0.5);
+	bool plain_ok = node->get_position().is_equal_approx(Vector2(5, 10));
+	OS::get_singleton()->print("Plain property through its setter: %s\n", plain_ok ? "OK" : "FAIL");
+	ok = ok && plain_ok;
+
+	// margin_left is set_margin(MARGIN_LEFT, value)
+	Control *control = memnew(Control);
+	tween->remove_all();
+	tween->interpolate_property(control, NodePath("margin_left"), 0.0, 100.0, 1.0);
+	tween->seek(0.25);
+	bool indexed_ok = Math::is_equal_approx(control->get_margin(MARGIN_LEFT), 25.0f) && control->get_margin(MARGIN_RIGHT) == 0;
+	OS::get_singleton()->print("Property with an indexed setter: %s\n", indexed_ok ? "OK" : "FAIL");
+	ok = ok && indexed_ok;
+	memdelete(control);
+
+	tween->remove_all();
+	node->set_position(Vector2(1, 2));
+	tween->interpolate_property(node, NodePath("position:x"), 0.0, 10.0, 1.0);
+	tween->seek(0.5);
+	bool sub_ok = node->get_position().is_equal_approx(Vector2(5, 2));
+	OS::get_singleton()->print("Property with a subname through Object::set_indexed(): %s\n", sub_ok ? "OK" : "FAIL");
+	ok = ok && sub_ok;
+
+	tween->remove_all();
+	node->set_position(Vector2(1, 2));
+	PositionScriptInstance *script_instance = memnew(PositionScriptInstance);
+	node->set_script_instance(script_instance);
+	tween->interpolate_property(node, NodePath("position"), Vector2(), Vector2(10, 20), 1.0);
+	tween->seek(0.5);
+	tween->seek(0.75);
+	bool script_ok = script_instance->sets == 2 && Vector2(script_instance->position).is_equal_approx(Vector2(7.5, 15)) && node->get_position() == Vector2(1, 2);
+	OS::get_singleton()->print("Scripted object through Object::set(): %s\n", script_ok ? "OK" : "FAIL");
+	ok = ok && script_ok;
+
+	memdelete(node);
+	memdelete(tween);
+	return ok;
+}
+
+MainLoop *test() {
+
+	bool ok = _test_equations();
+	ok = _test_values() && ok;
+	ok = _test_setters() && ok;
+
+	OS::get_singleton()->print(ok ? "All tween tests passed.\n" : "Some tween tests failed!\n");
+
+	return NULL;
+}
+} // namespace TestTween
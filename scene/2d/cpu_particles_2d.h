@@ -31,6 +31,7 @@
 #ifndef CPU_PARTICLES_2D_H
 #define CPU_PARTICLES_2D_H
 
+#include "core/local_vector.h"
 #include "core/rid.h"
 #include "scene/2d/node_2d.h"
 #include "scene/resources/texture.h"
@@ -114,6 +115,40 @@ private:
 	PoolVector<float> particle_data;
 	PoolVector<int> particle_order;
 
+	// What the serial emission pass decided for each particle, the rest of
+	// the update only touches the particle itself and can run in parallel.
+	enum {
+		STEP_SKIP,
+		STEP_SPAWNED,
+		STEP_UPDATE,
+		STEP_EXPIRED,
+	};
+
+	struct ParticleStep {
+		float delta;
+		uint8_t mode;
+	};
+
+	LocalVector<ParticleStep> particle_steps;
+
+	enum {
+		PROCESS_CHUNK_SIZE = 256,
+	};
+
+	struct ProcessJob {
+		Particle *particles;
+		const ParticleStep *steps;
+		uint32_t count;
+		Transform2D emission_xform;
+	};
+
+	struct DataJob {
+		const Particle *particles;
+		const int *order;
+		float *data;
+		uint32_t count;
+	};
+
 	struct SortLifetime {
 		const Particle *particles;
 
@@ -176,9 +211,23 @@ private:
 
 	Vector2 gravity;
 
-	void _update_internal();
-	void _particles_process(float p_delta);
-	void _update_particle_data_buffer();
+	// Small emitters leave the update pass to the SceneTree, which runs it
+	// for all of them at once on the worker pool.
+	bool batch_pending;
+	Transform2D batch_emission_xform;
+
+	void _batch_update();
+	static void _batch_process(Node *p_node);
+	static void _batch_finish(Node *p_node);
+
+	void _update_internal(bool p_on_process = false);
+	void _particles_process(float p_delta, bool p_batch = false);
+	void _particles_process_range(const ProcessJob &p_job, uint32_t p_from, uint32_t p_to);
+	void _particles_process_chunk(uint32_t p_chunk, ProcessJob *p_job);
+	void _update_particle_data_buffer(bool p_use_pool = true);
+	void _update_particle_data_range(const DataJob &p_job, uint32_t p_from, uint32_t p_to);
+	void _update_particle_data_chunk(uint32_t p_chunk, DataJob *p_job);
+	ThreadWorkPool *_get_work_pool(uint32_t p_count) const;
 
 	Mutex update_mutex;
 
@@ -64,6 +64,7 @@ void CPUParticles::set_amount(int p_amount) {
 	ERR_FAIL_COND_MSG(p_amount < 1, "Amount of particles must be greater than 0.");
 
 	particles.resize(p_amount);
+	batch_pending = false;
 	{
 		PoolVector<Particle>::Write w = particles.write();
 
@@ -242,6 +243,7 @@ void CPUParticles::restart() {
 	frame_remainder = 0;
 	cycle = 0;
 	emitting = false;
+	batch_pending = false;
 
 	{
 		int pc = particles.size();
@@ -255,6 +257,20 @@ void CPUParticles::restart() {
 	set_emitting(true);
 }
 
+void CPUParticles::simulate_step(float p_delta, bool p_batched) {
+
+	_particles_process(p_delta, p_batched);
+	if (!p_batched) {
+		_update_particle_data_buffer();
+	}
+}
+
+void CPUParticles::finish_batched_step() {
+
+	_batch_process(this);
+	_batch_finish(this);
+}
+
 void CPUParticles::set_direction(Vector3 p_direction) {
 
 	direction = p_direction;
@@ -518,7 +534,45 @@ static float rand_from_seed(uint32_t &seed) {
 	return float(seed % uint32_t(65536)) / 65535.0;
 }
 
-void CPUParticles::_update_internal() {
+void CPUParticles::_batch_update() {
+
+	if (!batch_pending)
+		return;
+
+	batch_pending = false;
+
+	PoolVector<Particle>::Write w = particles.write();
+
+	ProcessJob job;
+	job.particles = w.ptr();
+	job.steps = particle_steps.ptr();
+	job.count = particle_steps.size();
+	job.emission_xform = batch_emission_xform;
+
+	_particles_process_range(job, 0, job.count);
+}
+
+void CPUParticles::_batch_process(Node *p_node) {
+
+	CPUParticles *cpu_particles = static_cast<CPUParticles *>(p_node);
+	cpu_particles->_batch_update();
+
+	// sorting by view depth reads the camera transform, which isn't safe from several threads
+	if (cpu_particles->draw_order != DRAW_ORDER_VIEW_DEPTH) {
+		// already running on the work pool, which can't take more work from its own threads
+		cpu_particles->_update_particle_data_buffer(false);
+	}
+}
+
+void CPUParticles::_batch_finish(Node *p_node) {
+
+	CPUParticles *cpu_particles = static_cast<CPUParticles *>(p_node);
+	if (cpu_particles->draw_order == DRAW_ORDER_VIEW_DEPTH && cpu_particles->is_inside_tree()) {
+		cpu_particles->_update_particle_data_buffer();
+	}
+}
+
+void CPUParticles::_update_internal(bool p_on_process) {
 
 	if (particles.size() == 0 || !is_visible_in_tree()) {
 		_set_redraw(false);
@@ -583,6 +637,10 @@ void CPUParticles::_update_internal() {
 
 		frame_remainder = todo;
 
+	} else if (p_on_process && particles.size() <= PROCESS_CHUNK_SIZE && get_tree()->is_parallel_particles_enabled()) {
+		_particles_process(delta, true);
+		get_tree()->queue_parallel_process(this, &CPUParticles::_batch_process, &CPUParticles::_batch_finish);
+		return;
 	} else {
 		_particles_process(delta);
 		processed = true;
@@ -593,7 +651,9 @@ void CPUParticles::_update_internal() {
 	}
 }
 
-void CPUParticles::_particles_process(float p_delta) {
+void CPUParticles::_particles_process(float p_delta, bool p_batch) {
+
+	_batch_update(); // the previous step must be complete
 
 	p_delta *= speed_scale;
 
@@ -622,9 +682,15 @@ void CPUParticles::_particles_process(float p_delta) {
 
 	float system_phase = time / lifetime;
 
+	particle_steps.resize(pcount);
+	ParticleStep *steps = particle_steps.ptr();
+
+	// Emission uses the global random generator, so it stays serial to keep the same sequence.
 	for (int i = 0; i < pcount; i++) {
 
 		Particle &p = parray[i];
+		ParticleStep &step = steps[i];
+		step.mode = STEP_SKIP;
 
 		if (!emitting && !p.active)
 			continue;
@@ -680,7 +746,7 @@ void CPUParticles::_particles_process(float p_delta) {
 			restart = true;
 		}
 
-		float tv = 0.0;
+		step.delta = local_delta;
 
 		if (restart) {
 
@@ -697,12 +763,12 @@ void CPUParticles::_particles_process(float p_delta) {
 
 			float tex_angle = 0.0;
 			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->interpolate(tv);
+				tex_angle = curve_parameters[PARAM_ANGLE]->interpolate(0.0);
 			}
 
 			float tex_anim_offset = 0.0;
 			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANGLE]->interpolate(tv);
+				tex_anim_offset = curve_parameters[PARAM_ANGLE]->interpolate(0.0);
 			}
 
 			p.seed = Math::rand();
@@ -804,12 +870,61 @@ void CPUParticles::_particles_process(float p_delta) {
 				p.transform.origin.z = 0.0;
 			}
 
+			step.mode = STEP_SPAWNED;
 		} else if (!p.active) {
 			continue;
 		} else if (p.time > p.lifetime) {
 			p.active = false;
-			tv = 1.0;
+			step.mode = STEP_EXPIRED;
 		} else {
+			step.mode = STEP_UPDATE;
+		}
+	}
+
+	if (color_ramp.is_valid()) {
+		color_ramp->get_color_at_offset(0); // sorts the points now, the workers only read them
+	}
+
+	if (p_batch) {
+		batch_emission_xform = emission_xform;
+		batch_pending = true;
+		return;
+	}
+
+	ProcessJob job;
+	job.particles = parray;
+	job.steps = steps;
+	job.count = pcount;
+	job.emission_xform = emission_xform;
+
+	ThreadWorkPool *work_pool = _get_work_pool(pcount);
+	if (work_pool) {
+		uint32_t chunk_count = (job.count + PROCESS_CHUNK_SIZE - 1) / PROCESS_CHUNK_SIZE;
+		work_pool->do_work(chunk_count, this, &CPUParticles::_particles_process_chunk, &job);
+	} else {
+		_particles_process_range(job, 0, job.count);
+	}
+}
+
+void CPUParticles::_particles_process_chunk(uint32_t p_chunk, ProcessJob *p_job) {
+
+	uint32_t from = p_chunk * PROCESS_CHUNK_SIZE;
+	_particles_process_range(*p_job, from, MIN(from + PROCESS_CHUNK_SIZE, p_job->count));
+}
+
+void CPUParticles::_particles_process_range(const ProcessJob &p_job, uint32_t p_from, uint32_t p_to) {
+
+	for (uint32_t i = p_from; i < p_to; i++) {
+
+		const ParticleStep &step = p_job.steps[i];
+		if (step.mode == STEP_SKIP)
+			continue;
+
+		Particle &p = p_job.particles[i];
+		float local_delta = step.delta;
+		float tv = step.mode == STEP_EXPIRED ? 1.0 : 0.0;
+
+		if (step.mode == STEP_UPDATE) {
 
 			uint32_t alt_seed = p.seed;
 
@@ -876,7 +991,7 @@ void CPUParticles::_particles_process(float p_delta) {
 			//apply linear acceleration
 			force += p.velocity.length() > 0.0 ? p.velocity.normalized() * (parameters[PARAM_LINEAR_ACCEL] + tex_linear_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_LINEAR_ACCEL]) : Vector3();
 			//apply radial acceleration
-			Vector3 org = emission_xform.origin;
+			Vector3 org = p_job.emission_xform.origin;
 			Vector3 diff = position - org;
 			force += diff.length() > 0.0 ? diff.normalized() * (parameters[PARAM_RADIAL_ACCEL] + tex_radial_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_RADIAL_ACCEL]) : Vector3();
 			//apply tangential acceleration;
@@ -1023,7 +1138,7 @@ void CPUParticles::_particles_process(float p_delta) {
 	}
 }
 
-void CPUParticles::_update_particle_data_buffer() {
+void CPUParticles::_update_particle_data_buffer(bool p_use_pool) {
 	update_mutex.lock();
 
 	{
@@ -1071,52 +1186,85 @@ void CPUParticles::_update_particle_data_buffer() {
 			}
 		}
 
-		for (int i = 0; i < pc; i++) {
+		DataJob job;
+		job.particles = r.ptr();
+		job.order = order;
+		job.data = ptr;
+		job.count = pc;
 
-			int idx = order ? order[i] : i;
+		ThreadWorkPool *work_pool = p_use_pool ? _get_work_pool(pc) : NULL;
+		if (work_pool) {
+			uint32_t chunk_count = (job.count + PROCESS_CHUNK_SIZE - 1) / PROCESS_CHUNK_SIZE;
+			work_pool->do_work(chunk_count, this, &CPUParticles::_update_particle_data_chunk, &job);
+		} else {
+			_update_particle_data_range(job, 0, job.count);
+		}
 
-			Transform t = r[idx].transform;
+		can_update.set();
+	}
 
-			if (!local_coords) {
-				t = inv_emission_transform * t;
-			}
+	update_mutex.unlock();
+}
 
-			if (r[idx].active) {
-				ptr[0] = t.basis.elements[0][0];
-				ptr[1] = t.basis.elements[0][1];
-				ptr[2] = t.basis.elements[0][2];
-				ptr[3] = t.origin.x;
-				ptr[4] = t.basis.elements[1][0];
-				ptr[5] = t.basis.elements[1][1];
-				ptr[6] = t.basis.elements[1][2];
-				ptr[7] = t.origin.y;
-				ptr[8] = t.basis.elements[2][0];
-				ptr[9] = t.basis.elements[2][1];
-				ptr[10] = t.basis.elements[2][2];
-				ptr[11] = t.origin.z;
-			} else {
-				zeromem(ptr, sizeof(float) * 12);
-			}
+void CPUParticles::_update_particle_data_chunk(uint32_t p_chunk, DataJob *p_job) {
 
-			Color c = r[idx].color;
-			uint8_t *data8 = (uint8_t *)&ptr[12];
-			data8[0] = CLAMP(c.r * 255.0, 0, 255);
-			data8[1] = CLAMP(c.g * 255.0, 0, 255);
-			data8[2] = CLAMP(c.b * 255.0, 0, 255);
-			data8[3] = CLAMP(c.a * 255.0, 0, 255);
+	uint32_t from = p_chunk * PROCESS_CHUNK_SIZE;
+	_update_particle_data_range(*p_job, from, MIN(from + PROCESS_CHUNK_SIZE, p_job->count));
+}
+
+void CPUParticles::_update_particle_data_range(const DataJob &p_job, uint32_t p_from, uint32_t p_to) {
+
+	for (uint32_t i = p_from; i < p_to; i++) {
 
-			ptr[13] = r[idx].custom[0];
-			ptr[14] = r[idx].custom[1];
-			ptr[15] = r[idx].custom[2];
-			ptr[16] = r[idx].custom[3];
+		int idx = p_job.order ? p_job.order[i] : i;
+		const Particle &p = p_job.particles[idx];
+		float *ptr = p_job.data + i * 17;
 
-			ptr += 17;
+		Transform t = p.transform;
+
+		if (!local_coords) {
+			t = inv_emission_transform * t;
 		}
 
-		can_update.set();
+		if (p.active) {
+			ptr[0] = t.basis.elements[0][0];
+			ptr[1] = t.basis.elements[0][1];
+			ptr[2] = t.basis.elements[0][2];
+			ptr[3] = t.origin.x;
+			ptr[4] = t.basis.elements[1][0];
+			ptr[5] = t.basis.elements[1][1];
+			ptr[6] = t.basis.elements[1][2];
+			ptr[7] = t.origin.y;
+			ptr[8] = t.basis.elements[2][0];
+			ptr[9] = t.basis.elements[2][1];
+			ptr[10] = t.basis.elements[2][2];
+			ptr[11] = t.origin.z;
+		} else {
+			zeromem(ptr, sizeof(float) * 12);
+		}
+
+		Color c = p.color;
+		uint8_t *data8 = (uint8_t *)&ptr[12];
+		data8[0] = CLAMP(c.r * 255.0, 0, 255);
+		data8[1] = CLAMP(c.g * 255.0, 0, 255);
+		data8[2] = CLAMP(c.b * 255.0, 0, 255);
+		data8[3] = CLAMP(c.a * 255.0, 0, 255);
+
+		ptr[13] = p.custom[0];
+		ptr[14] = p.custom[1];
+		ptr[15] = p.custom[2];
+		ptr[16] = p.custom[3];
 	}
+}
 
-	update_mutex.unlock();
+ThreadWorkPool *CPUParticles::_get_work_pool(uint32_t p_count) const {
+
+	if (p_count <= PROCESS_CHUNK_SIZE || !is_inside_tree()) {
+		return NULL;
+	}
+
+	ThreadWorkPool *work_pool = &get_tree()->get_work_pool();
+	return work_pool->get_thread_count() > 0 ? work_pool : NULL;
 }
 
 void CPUParticles::_set_redraw(bool p_redraw) {
@@ -1171,7 +1319,7 @@ void CPUParticles::_notification(int p_what) {
 	}
 
 	if (p_what == NOTIFICATION_INTERNAL_PROCESS) {
-		_update_internal();
+		_update_internal(true);
 	}
 
 	if (p_what == NOTIFICATION_TRANSFORM_CHANGED) {
@@ -1499,6 +1647,7 @@ CPUParticles::CPUParticles() {
 	cycle = 0;
 	redraw = false;
 	emitting = false;
+	batch_pending = false;
 
 	set_notify_transform(true);
 
@@ -34,6 +34,7 @@
 #include "core/core_string_names.h"
 #include "core/project_settings.h"
 #include "physics_body.h"
+#include "scene/main/scene_tree.h"
 #include "scene/resources/material.h"
 #include "scene/scene_string_names.h"
 #include "servers/visual/visual_server_globals.h"
@@ -249,6 +250,8 @@ void MeshInstance::_initialize_skinning(bool p_force_reset) {
 					ERR_CONTINUE(Mesh::PRIMITIVE_TRIANGLES != mesh->surface_get_primitive_type(surface_index));
 
 					SoftwareSkinning::SurfaceData &surface_data = software_skinning->surface_data[surface_index];
+					surface_data.valid = false;
+					surface_data.current_buffer = 0;
 					surface_data.transform_tangents = false;
 					surface_data.ensure_correct_normals = false;
 
@@ -308,6 +311,30 @@ void MeshInstance::_initialize_skinning(bool p_force_reset) {
 					surface_data.source_buffer.append_array(buffer_read);
 					surface_data.source_format = software_mesh->surface_get_format(surface_index);
 
+					const int vertex_count = software_mesh->surface_get_array_len(surface_index);
+					const int index_count = software_mesh->surface_get_array_index_len(surface_index);
+
+					uint32_t array_offsets[Mesh::ARRAY_MAX];
+					surface_data.stride = visual_server->mesh_surface_make_offsets_from_format(surface_data.source_format, vertex_count, index_count, array_offsets);
+					surface_data.offset_vertices = array_offsets[Mesh::ARRAY_VERTEX];
+					surface_data.offset_normals = array_offsets[Mesh::ARRAY_NORMAL];
+					surface_data.offset_tangents = array_offsets[Mesh::ARRAY_TANGENT];
+					surface_data.offset_bones = array_offsets[Mesh::ARRAY_BONES];
+					surface_data.offset_weights = array_offsets[Mesh::ARRAY_WEIGHTS];
+					surface_data.vertex_count = vertex_count;
+
+					// Bone indices never change, so they are range checked once here instead of per update.
+					surface_data.max_bone_index = 0;
+					{
+						PoolByteArray::Read source_read = surface_data.source_buffer.read();
+						for (int vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
+							const uint8_t *bones_ptr = source_read.ptr() + vertex_index * surface_data.stride + surface_data.offset_bones;
+							for (int i = 0; i < 4; ++i) {
+								surface_data.max_bone_index = MAX(surface_data.max_bone_index, (uint32_t)bones_ptr[i]);
+							}
+						}
+					}
+
 					software_mesh->surface_remove(surface_index);
 
 					// 2. Create the surface again without the bone data for the write buffer.
@@ -316,8 +343,21 @@ void MeshInstance::_initialize_skinning(bool p_force_reset) {
 					Ref<Material> material = mesh->surface_get_material(surface_index);
 					software_mesh->surface_set_material(surface_index, material);
 
-					surface_data.buffer = visual_server->mesh_surface_get_array(mesh_rid, surface_index);
-					surface_data.buffer_write = surface_data.buffer.write();
+					const uint32_t format_write = software_mesh->surface_get_format(surface_index);
+					const int vertex_count_write = software_mesh->surface_get_array_len(surface_index);
+					const int index_count_write = software_mesh->surface_get_array_index_len(surface_index);
+					ERR_CONTINUE(vertex_count != vertex_count_write);
+
+					surface_data.stride_write = visual_server->mesh_surface_make_offsets_from_format(format_write, vertex_count_write, index_count_write, array_offsets);
+					surface_data.offset_vertices_write = array_offsets[Mesh::ARRAY_VERTEX];
+					surface_data.offset_normals_write = array_offsets[Mesh::ARRAY_NORMAL];
+					surface_data.offset_tangents_write = array_offsets[Mesh::ARRAY_TANGENT];
+
+					surface_data.buffer[0] = visual_server->mesh_surface_get_array(mesh_rid, surface_index);
+					surface_data.buffer[1].append_array(surface_data.buffer[0]);
+					surface_data.buffer_write[0] = surface_data.buffer[0].write();
+					surface_data.buffer_write[1] = surface_data.buffer[1].write();
+					surface_data.valid = true;
 				}
 
 				software_skinning->mesh_instance = software_mesh;
@@ -367,6 +407,82 @@ void MeshInstance::_initialize_skinning(bool p_force_reset) {
 	}
 }
 
+void SoftwareSkinningJob::skin_range(uint32_t p_from, uint32_t p_to) const {
+	for (uint32_t vertex_index = p_from; vertex_index < p_to; ++vertex_index) {
+		const uint8_t *vertex_read = read + vertex_index * stride;
+		uint8_t *vertex_write = write + vertex_index * stride_write;
+
+		const float *weights = (const float *)(vertex_read + offset_weights);
+		const uint8_t *bones = vertex_read + offset_bones;
+
+		// Transform is 12 contiguous reals (basis rows, then origin), so the
+		// four bones are blended in a single flat loop the compiler can vectorize.
+		const real_t *b0 = &bone_transforms[bones[0]].basis.elements[0][0];
+		const real_t *b1 = &bone_transforms[bones[1]].basis.elements[0][0];
+		const real_t *b2 = &bone_transforms[bones[2]].basis.elements[0][0];
+		const real_t *b3 = &bone_transforms[bones[3]].basis.elements[0][0];
+		const real_t w0 = weights[0];
+		const real_t w1 = weights[1];
+		const real_t w2 = weights[2];
+		const real_t w3 = weights[3];
+
+		real_t m[12];
+		for (int i = 0; i < 12; ++i) {
+			m[i] = b0[i] * w0 + b1[i] * w1 + b2[i] * w2 + b3[i] * w3;
+		}
+
+		const Vector3 &vertex_src = *(const Vector3 *)(vertex_read + offset_vertices);
+		Vector3 &vertex = *(Vector3 *)(vertex_write + offset_vertices_write);
+		vertex.x = m[0] * vertex_src.x + m[1] * vertex_src.y + m[2] * vertex_src.z + m[9];
+		vertex.y = m[3] * vertex_src.x + m[4] * vertex_src.y + m[5] * vertex_src.z + m[10];
+		vertex.z = m[6] * vertex_src.x + m[7] * vertex_src.y + m[8] * vertex_src.z + m[11];
+
+		if (!transform_normals) {
+			continue;
+		}
+
+		if (ensure_correct_normals) {
+			// Inverse transpose is the cofactor matrix divided by the determinant.
+			real_t c[9];
+			c[0] = m[4] * m[8] - m[5] * m[7];
+			c[1] = m[5] * m[6] - m[3] * m[8];
+			c[2] = m[3] * m[7] - m[4] * m[6];
+			c[3] = m[2] * m[7] - m[1] * m[8];
+			c[4] = m[0] * m[8] - m[2] * m[6];
+			c[5] = m[1] * m[6] - m[0] * m[7];
+			c[6] = m[1] * m[5] - m[2] * m[4];
+			c[7] = m[2] * m[3] - m[0] * m[5];
+			c[8] = m[0] * m[4] - m[1] * m[3];
+			const real_t det = m[0] * c[0] + m[1] * c[1] + m[2] * c[2];
+			if (det != 0) {
+				const real_t inv_det = 1.0 / det;
+				for (int i = 0; i < 9; ++i) {
+					m[i] = c[i] * inv_det;
+				}
+			}
+		}
+
+		const Vector3 &normal_src = *(const Vector3 *)(vertex_read + offset_normals);
+		Vector3 &normal = *(Vector3 *)(vertex_write + offset_normals_write);
+		normal.x = m[0] * normal_src.x + m[1] * normal_src.y + m[2] * normal_src.z;
+		normal.y = m[3] * normal_src.x + m[4] * normal_src.y + m[5] * normal_src.z;
+		normal.z = m[6] * normal_src.x + m[7] * normal_src.y + m[8] * normal_src.z;
+
+		if (transform_tangents) {
+			const Vector3 &tangent_src = *(const Vector3 *)(vertex_read + offset_tangents);
+			Vector3 &tangent = *(Vector3 *)(vertex_write + offset_tangents_write);
+			tangent.x = m[0] * tangent_src.x + m[1] * tangent_src.y + m[2] * tangent_src.z;
+			tangent.y = m[3] * tangent_src.x + m[4] * tangent_src.y + m[5] * tangent_src.z;
+			tangent.z = m[6] * tangent_src.x + m[7] * tangent_src.y + m[8] * tangent_src.z;
+		}
+	}
+}
+
+void SoftwareSkinningJob::skin_chunk(uint32_t p_chunk, void *p_userdata) {
+	const uint32_t from = p_chunk * CHUNK_SIZE;
+	skin_range(from, MIN(from + CHUNK_SIZE, vertex_count));
+}
+
 void MeshInstance::_update_skinning() {
 	ERR_FAIL_COND(!_is_software_skinning_enabled());
 #if defined(TOOLS_ENABLED) && defined(DEBUG_ENABLED)
@@ -382,116 +498,61 @@ void MeshInstance::_update_skinning() {
 	ERR_FAIL_COND(!mesh_rid.is_valid());
 
 	ERR_FAIL_COND(!mesh.is_valid());
-	RID source_mesh_rid = mesh->get_rid();
-	ERR_FAIL_COND(!source_mesh_rid.is_valid());
 
 	ERR_FAIL_COND(skin_ref.is_null());
-	RID skeleton = skin_ref->get_skeleton();
-	ERR_FAIL_COND(!skeleton.is_valid());
 
 	VisualServer *visual_server = VisualServer::get_singleton();
 
-	// Prepare bone transforms.
-	const int num_bones = visual_server->skeleton_get_bone_count(skeleton);
-	ERR_FAIL_COND(num_bones <= 0);
-	Transform *bone_transforms = (Transform *)alloca(sizeof(Transform) * num_bones);
-	for (int bone_index = 0; bone_index < num_bones; ++bone_index) {
-		bone_transforms[bone_index] = visual_server->skeleton_bone_get_transform(skeleton, bone_index);
+	// Bone transforms are read from the CPU copy kept by the skin reference, reading
+	// them back from the VisualServer would sync with the render thread.
+	const Vector<Transform> &bone_transforms = skin_ref->get_bone_transforms();
+	const uint32_t num_bones = bone_transforms.size();
+	ERR_FAIL_COND(num_bones == 0);
+
+	ThreadWorkPool *work_pool = nullptr;
+	if (is_inside_tree() && get_tree()->get_work_pool().get_thread_count() > 0) {
+		work_pool = &get_tree()->get_work_pool();
 	}
 
 	// Apply skinning.
 	int surface_count = software_skinning_mesh->get_surface_count();
 	for (int surface_index = 0; surface_index < surface_count; ++surface_index) {
 		ERR_CONTINUE((uint32_t)surface_index >= software_skinning->surface_data.size());
-		const SoftwareSkinning::SurfaceData &surface_data = software_skinning->surface_data[surface_index];
-		const bool transform_tangents = surface_data.transform_tangents;
-		const bool ensure_correct_normals = surface_data.ensure_correct_normals;
-
-		const uint32_t format_write = software_skinning_mesh->surface_get_format(surface_index);
-
-		const int vertex_count_write = software_skinning_mesh->surface_get_array_len(surface_index);
-		const int index_count_write = software_skinning_mesh->surface_get_array_index_len(surface_index);
-
-		uint32_t array_offsets_write[Mesh::ARRAY_MAX];
-		const uint32_t stride_write = visual_server->mesh_surface_make_offsets_from_format(format_write, vertex_count_write, index_count_write, array_offsets_write);
-		const uint32_t offset_vertices_write = array_offsets_write[Mesh::ARRAY_VERTEX];
-		const uint32_t offset_normals_write = array_offsets_write[Mesh::ARRAY_NORMAL];
-		const uint32_t offset_tangents_write = array_offsets_write[Mesh::ARRAY_TANGENT];
-
-		PoolByteArray buffer_source = surface_data.source_buffer;
-		PoolByteArray::Read buffer_read = buffer_source.read();
-
-		const uint32_t format_read = surface_data.source_format;
-
-		ERR_CONTINUE(0 == (format_read & Mesh::ARRAY_FORMAT_BONES));
-		ERR_CONTINUE(0 == (format_read & Mesh::ARRAY_FORMAT_WEIGHTS));
-
-		const int vertex_count = mesh->surface_get_array_len(surface_index);
-		const int index_count = mesh->surface_get_array_index_len(surface_index);
-
-		ERR_CONTINUE(vertex_count != vertex_count_write);
-
-		uint32_t array_offsets[Mesh::ARRAY_MAX];
-		const uint32_t stride = visual_server->mesh_surface_make_offsets_from_format(format_read, vertex_count, index_count, array_offsets);
-		const uint32_t offset_vertices = array_offsets[Mesh::ARRAY_VERTEX];
-		const uint32_t offset_normals = array_offsets[Mesh::ARRAY_NORMAL];
-		const uint32_t offset_tangents = array_offsets[Mesh::ARRAY_TANGENT];
-		const uint32_t offset_bones = array_offsets[Mesh::ARRAY_BONES];
-		const uint32_t offset_weights = array_offsets[Mesh::ARRAY_WEIGHTS];
-
-		PoolByteArray buffer = surface_data.buffer;
-		PoolByteArray::Write buffer_write = surface_data.buffer_write;
-
-		for (int vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-			const uint32_t vertex_offset = vertex_index * stride;
-			const uint32_t vertex_offset_write = vertex_index * stride_write;
-
-			float bone_weights[4];
-			const float *weight_ptr = (const float *)(buffer_read.ptr() + offset_weights + vertex_offset);
-			bone_weights[0] = weight_ptr[0];
-			bone_weights[1] = weight_ptr[1];
-			bone_weights[2] = weight_ptr[2];
-			bone_weights[3] = weight_ptr[3];
-
-			const uint8_t *bones_ptr = buffer_read.ptr() + offset_bones + vertex_offset;
-			const int b0 = bones_ptr[0];
-			const int b1 = bones_ptr[1];
-			const int b2 = bones_ptr[2];
-			const int b3 = bones_ptr[3];
-
-			Transform transform;
-			transform.origin =
-					bone_weights[0] * bone_transforms[b0].origin +
-					bone_weights[1] * bone_transforms[b1].origin +
-					bone_weights[2] * bone_transforms[b2].origin +
-					bone_weights[3] * bone_transforms[b3].origin;
-
-			transform.basis =
-					bone_transforms[b0].basis * bone_weights[0] +
-					bone_transforms[b1].basis * bone_weights[1] +
-					bone_transforms[b2].basis * bone_weights[2] +
-					bone_transforms[b3].basis * bone_weights[3];
-
-			const Vector3 &vertex_read = (const Vector3 &)buffer_read[vertex_offset + offset_vertices];
-			Vector3 &vertex = (Vector3 &)buffer_write[vertex_offset_write + offset_vertices_write];
-			vertex = transform.xform(vertex_read);
-
-			if (software_skinning_flags & SoftwareSkinning::FLAG_TRANSFORM_NORMALS) {
-				if (ensure_correct_normals) {
-					transform.basis.invert();
-					transform.basis.transpose();
-				}
-
-				const Vector3 &normal_read = (const Vector3 &)buffer_read[vertex_offset + offset_normals];
-				Vector3 &normal = (Vector3 &)buffer_write[vertex_offset_write + offset_normals_write];
-				normal = transform.basis.xform(normal_read);
-
-				if (transform_tangents) {
-					const Vector3 &tangent_read = (const Vector3 &)buffer_read[vertex_offset + offset_tangents];
-					Vector3 &tangent = (Vector3 &)buffer_write[vertex_offset_write + offset_tangents_write];
-					tangent = transform.basis.xform(tangent_read);
-				}
-			}
+		SoftwareSkinning::SurfaceData &surface_data = software_skinning->surface_data[surface_index];
+		if (!surface_data.valid) {
+			continue;
+		}
+		ERR_CONTINUE(surface_data.max_bone_index >= num_bones);
+
+		PoolByteArray::Read buffer_read = surface_data.source_buffer.read();
+
+		surface_data.current_buffer = 1 - surface_data.current_buffer;
+		PoolByteArray &buffer = surface_data.buffer[surface_data.current_buffer];
+
+		SoftwareSkinningJob job;
+		job.read = buffer_read.ptr();
+		job.write = surface_data.buffer_write[surface_data.current_buffer].ptr();
+		job.bone_transforms = bone_transforms.ptr();
+		job.vertex_count = surface_data.vertex_count;
+		job.stride = surface_data.stride;
+		job.offset_vertices = surface_data.offset_vertices;
+		job.offset_normals = surface_data.offset_normals;
+		job.offset_tangents = surface_data.offset_tangents;
+		job.offset_bones = surface_data.offset_bones;
+		job.offset_weights = surface_data.offset_weights;
+		job.stride_write = surface_data.stride_write;
+		job.offset_vertices_write = surface_data.offset_vertices_write;
+		job.offset_normals_write = surface_data.offset_normals_write;
+		job.offset_tangents_write = surface_data.offset_tangents_write;
+		job.transform_normals = software_skinning_flags & SoftwareSkinning::FLAG_TRANSFORM_NORMALS;
+		job.transform_tangents = surface_data.transform_tangents;
+		job.ensure_correct_normals = surface_data.ensure_correct_normals;
+
+		const uint32_t chunk_count = (job.vertex_count + SoftwareSkinningJob::CHUNK_SIZE - 1) / SoftwareSkinningJob::CHUNK_SIZE;
+		if (work_pool && chunk_count > 1) {
+			work_pool->do_work(chunk_count, &job, &SoftwareSkinningJob::skin_chunk, (void *)nullptr);
+		} else {
+			job.skin_range(0, job.vertex_count);
 		}
 
 		visual_server->mesh_surface_update_region(mesh_rid, surface_index, 0, buffer);
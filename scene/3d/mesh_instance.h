@@ -38,6 +38,35 @@
 
 #include "core/local_vector.h"
 
+// Skins a range of vertices of one surface. Large surfaces are split in chunks
+// across the SceneTree work pool, every chunk writes to its own vertices only.
+struct SoftwareSkinningJob {
+	enum {
+		CHUNK_SIZE = 1024,
+	};
+
+	const uint8_t *read;
+	uint8_t *write;
+	const Transform *bone_transforms;
+	uint32_t vertex_count;
+	uint32_t stride;
+	uint32_t offset_vertices;
+	uint32_t offset_normals;
+	uint32_t offset_tangents;
+	uint32_t offset_bones;
+	uint32_t offset_weights;
+	uint32_t stride_write;
+	uint32_t offset_vertices_write;
+	uint32_t offset_normals_write;
+	uint32_t offset_tangents_write;
+	bool transform_normals;
+	bool transform_tangents;
+	bool ensure_correct_normals;
+
+	void skin_range(uint32_t p_from, uint32_t p_to) const;
+	void skin_chunk(uint32_t p_chunk, void *p_userdata);
+};
+
 class MeshInstance : public GeometryInstance {
 
 	GDCLASS(MeshInstance, GeometryInstance);
@@ -61,10 +90,28 @@ protected:
 		struct SurfaceData {
 			PoolByteArray source_buffer;
 			uint32_t source_format;
-			PoolByteArray buffer;
-			PoolByteArray::Write buffer_write;
+			// Double-buffered, so the region sent last frame isn't written again
+			// while the VisualServer may still be consuming it.
+			PoolByteArray buffer[2];
+			PoolByteArray::Write buffer_write[2];
+			uint32_t current_buffer;
 			bool transform_tangents;
 			bool ensure_correct_normals;
+
+			// Layout of both buffers, cached to avoid querying the server every update.
+			bool valid;
+			uint32_t vertex_count;
+			uint32_t max_bone_index;
+			uint32_t stride;
+			uint32_t offset_vertices;
+			uint32_t offset_normals;
+			uint32_t offset_tangents;
+			uint32_t offset_bones;
+			uint32_t offset_weights;
+			uint32_t stride_write;
+			uint32_t offset_vertices_write;
+			uint32_t offset_normals_write;
+			uint32_t offset_tangents_write;
 		};
 
 		Ref<Mesh> mesh_instance;
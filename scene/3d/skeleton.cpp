@@ -30,9 +30,11 @@
 
 #include "skeleton.h"
 
+#include "core/engine.h"
 #include "core/message_queue.h"
 
 #include "core/project_settings.h"
+#include "scene/3d/camera.h"
 #include "scene/3d/physics_body.h"
 #include "scene/resources/surface_tool.h"
 
@@ -222,13 +224,27 @@ void Skeleton::_update_process_order() {
 		ERR_PRINT("Skeleton parenthood graph is cyclic");
 	}
 
+	for (int i = 0; i < len; i++) {
+		Bone &b = bonesptr[order[i]];
+		b.depth = b.parent >= 0 ? bonesptr[b.parent].depth + 1 : 0;
+	}
+
 	process_order_dirty = false;
+	all_bones_dirty = true; // parents may have changed
 }
 
 void Skeleton::_notification(int p_what) {
 
 	switch (p_what) {
 
+		case NOTIFICATION_INTERNAL_PROCESS: {
+
+			_update_bone_lod();
+		} break;
+		case NOTIFICATION_EXIT_TREE: {
+
+			bone_lod_depth_limit = -1;
+		} break;
 		case NOTIFICATION_UPDATE_SKELETON: {
 
 			VisualServer *vs = VisualServer::get_singleton();
@@ -238,10 +254,19 @@ void Skeleton::_notification(int p_what) {
 			_update_process_order();
 
 			const int *order = process_order.ptr();
+			uint8_t *dirtyptr = bones_dirty.ptr();
 
 			for (int i = 0; i < len; i++) {
 
-				Bone &b = bonesptr[order[i]];
+				int idx = order[i];
+				Bone &b = bonesptr[idx];
+
+				// parents come first in process order, so they already passed their state down
+				if (all_bones_dirty || (b.parent >= 0 && dirtyptr[b.parent] != BONE_CLEAN)) {
+					dirtyptr[idx] = BONE_DIRTY;
+				} else if (dirtyptr[idx] == BONE_CLEAN) {
+					continue;
+				}
 
 				if (b.global_pose_override_amount >= 0.999) {
 					b.pose_global = b.global_pose_override;
@@ -302,8 +327,9 @@ void Skeleton::_notification(int p_what) {
 					}
 				}
 
-				if (b.global_pose_override_reset) {
+				if (b.global_pose_override_reset && b.global_pose_override_amount != 0.0) {
 					b.global_pose_override_amount = 0.0;
+					dirtyptr[idx] = BONE_DIRTY_AGAIN;
 				}
 
 				for (List<uint32_t>::Element *E = b.nodes_bound.front(); E; E = E->next()) {
@@ -323,14 +349,19 @@ void Skeleton::_notification(int p_what) {
 				RID skeleton = E->get()->skeleton;
 				uint32_t bind_count = skin->get_bind_count();
 
+				bool update_all = false;
+
 				if (E->get()->bind_count != bind_count) {
 					VS::get_singleton()->skeleton_allocate(skeleton, bind_count);
 					E->get()->bind_count = bind_count;
 					E->get()->skin_bone_indices.resize(bind_count);
 					E->get()->skin_bone_indices_ptrs = E->get()->skin_bone_indices.ptrw();
+					E->get()->bone_transforms.resize(bind_count);
+					update_all = true;
 				}
 
 				if (E->get()->skeleton_version != version) {
+					update_all = true;
 
 					for (uint32_t i = 0; i < bind_count; i++) {
 						StringName bind_name = skin->get_bind_name(i);
@@ -367,13 +398,28 @@ void Skeleton::_notification(int p_what) {
 					E->get()->skeleton_version = version;
 				}
 
+				bool changed = false;
+				Transform *bone_transforms = E->get()->bone_transforms.ptrw();
 				for (uint32_t i = 0; i < bind_count; i++) {
 					uint32_t bone_index = E->get()->skin_bone_indices_ptrs[i];
 					ERR_CONTINUE(bone_index >= (uint32_t)len);
-					vs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].pose_global * skin->get_bind_pose(i));
+					if (!update_all && dirtyptr[bone_index] == BONE_CLEAN) {
+						continue;
+					}
+					bone_transforms[i] = bonesptr[bone_index].pose_global * skin->get_bind_pose(i);
+					changed = true;
+				}
+
+				if (changed) {
+					vs->skeleton_set_bone_transforms(skeleton, E->get()->bone_transforms);
 				}
 			}
 
+			for (int i = 0; i < len; i++) {
+				dirtyptr[i] = dirtyptr[i] == BONE_DIRTY_AGAIN ? BONE_DIRTY : BONE_CLEAN;
+			}
+			all_bones_dirty = false;
+
 			dirty = false;
 			emit_signal("skeleton_updated");
 		} break;
@@ -385,6 +431,7 @@ void Skeleton::clear_bones_global_pose_override() {
 		bones.write[i].global_pose_override_amount = 0;
 		bones.write[i].global_pose_override_reset = true;
 	}
+	all_bones_dirty = true;
 	_make_dirty();
 }
 
@@ -394,7 +441,7 @@ void Skeleton::set_bone_global_pose_override(int p_bone, const Transform &p_pose
 	bones.write[p_bone].global_pose_override_amount = p_amount;
 	bones.write[p_bone].global_pose_override = p_pose;
 	bones.write[p_bone].global_pose_override_reset = !p_persistent;
-	_make_dirty();
+	_make_bone_dirty(p_bone);
 }
 
 Transform Skeleton::get_bone_global_pose(int p_bone) const {
@@ -418,6 +465,7 @@ void Skeleton::add_bone(const String &p_name) {
 	Bone b;
 	b.name = p_name;
 	bones.push_back(b);
+	bones_dirty.push_back(BONE_DIRTY);
 	process_order_dirty = true;
 	version++;
 	_make_dirty();
@@ -490,6 +538,7 @@ void Skeleton::set_bone_disable_rest(int p_bone, bool p_disable) {
 
 	ERR_FAIL_INDEX(p_bone, bones.size());
 	bones.write[p_bone].disable_rest = p_disable;
+	bones_dirty[p_bone] = BONE_DIRTY;
 }
 
 bool Skeleton::is_bone_rest_disabled(int p_bone) const {
@@ -510,7 +559,7 @@ void Skeleton::set_bone_rest(int p_bone, const Transform &p_rest) {
 	ERR_FAIL_INDEX(p_bone, bones.size());
 
 	bones.write[p_bone].rest = p_rest;
-	_make_dirty();
+	_make_bone_dirty(p_bone);
 }
 Transform Skeleton::get_bone_rest(int p_bone) const {
 
@@ -524,7 +573,7 @@ void Skeleton::set_bone_enabled(int p_bone, bool p_enabled) {
 	ERR_FAIL_INDEX(p_bone, bones.size());
 
 	bones.write[p_bone].enabled = p_enabled;
-	_make_dirty();
+	_make_bone_dirty(p_bone);
 }
 bool Skeleton::is_bone_enabled(int p_bone) const {
 
@@ -546,6 +595,7 @@ void Skeleton::bind_child_node_to_bone(int p_bone, Node *p_node) {
 	}
 
 	bones.write[p_bone].nodes_bound.push_back(id);
+	bones_dirty[p_bone] = BONE_DIRTY;
 }
 void Skeleton::unbind_child_node_from_bone(int p_bone, Node *p_node) {
 
@@ -570,6 +620,7 @@ void Skeleton::get_bound_child_nodes_to_bone(int p_bone, List<Node *> *p_bound)
 void Skeleton::clear_bones() {
 
 	bones.clear();
+	bones_dirty.clear();
 	process_order_dirty = true;
 	version++;
 	_make_dirty();
@@ -582,6 +633,7 @@ void Skeleton::set_bone_pose(int p_bone, const Transform &p_pose) {
 	ERR_FAIL_INDEX(p_bone, bones.size());
 
 	bones.write[p_bone].pose = p_pose;
+	bones_dirty[p_bone] = BONE_DIRTY;
 	if (is_inside_tree()) {
 		_make_dirty();
 	}
@@ -600,7 +652,7 @@ void Skeleton::set_bone_custom_pose(int p_bone, const Transform &p_custom_pose)
 	bones.write[p_bone].custom_pose_enable = (p_custom_pose != Transform());
 	bones.write[p_bone].custom_pose = p_custom_pose;
 
-	_make_dirty();
+	_make_bone_dirty(p_bone);
 }
 
 Transform Skeleton::get_bone_custom_pose(int p_bone) const {
@@ -609,6 +661,12 @@ Transform Skeleton::get_bone_custom_pose(int p_bone) const {
 	return bones[p_bone].custom_pose;
 }
 
+void Skeleton::_make_bone_dirty(int p_bone) {
+
+	bones_dirty[p_bone] = BONE_DIRTY;
+	_make_dirty();
+}
+
 void Skeleton::_make_dirty() {
 
 	if (dirty)
@@ -618,6 +676,59 @@ void Skeleton::_make_dirty() {
 	dirty = true;
 }
 
+void Skeleton::_update_bone_lod() {
+
+	bone_lod_depth_limit = -1;
+
+#ifndef _3D_DISABLED
+	if (bone_lod_distance <= 0 || Engine::get_singleton()->is_editor_hint())
+		return;
+
+	Camera *camera = get_viewport()->get_camera();
+	if (camera) {
+		update_bone_lod_at_distance(camera->get_global_transform().origin.distance_to(get_global_transform().origin));
+	}
+#endif
+}
+
+void Skeleton::update_bone_lod_at_distance(float p_camera_distance) {
+
+	bone_lod_depth_limit = -1;
+
+	if (bone_lod_distance <= 0 || p_camera_distance <= bone_lod_distance)
+		return;
+
+	_update_process_order(); // bone depths
+	bone_lod_depth_limit = bone_lod_max_depth;
+}
+
+void Skeleton::set_bone_lod_distance(float p_distance) {
+
+	bone_lod_distance = MAX(p_distance, 0);
+	set_process_internal(bone_lod_distance > 0);
+	if (is_inside_tree()) {
+		_update_bone_lod();
+	}
+}
+
+float Skeleton::get_bone_lod_distance() const {
+
+	return bone_lod_distance;
+}
+
+void Skeleton::set_bone_lod_max_depth(int p_depth) {
+
+	bone_lod_max_depth = MAX(p_depth, 0);
+	if (is_inside_tree()) {
+		_update_bone_lod();
+	}
+}
+
+int Skeleton::get_bone_lod_max_depth() const {
+
+	return bone_lod_max_depth;
+}
+
 int Skeleton::get_process_order(int p_idx) {
 	ERR_FAIL_INDEX_V(p_idx, bones.size(), -1);
 	_update_process_order();
@@ -889,6 +1000,14 @@ void Skeleton::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_bone_custom_pose", "bone_idx"), &Skeleton::get_bone_custom_pose);
 	ClassDB::bind_method(D_METHOD("set_bone_custom_pose", "bone_idx", "custom_pose"), &Skeleton::set_bone_custom_pose);
 
+	ClassDB::bind_method(D_METHOD("set_bone_lod_distance", "distance"), &Skeleton::set_bone_lod_distance);
+	ClassDB::bind_method(D_METHOD("get_bone_lod_distance"), &Skeleton::get_bone_lod_distance);
+
+	ClassDB::bind_method(D_METHOD("set_bone_lod_max_depth", "depth"), &Skeleton::set_bone_lod_max_depth);
+	ClassDB::bind_method(D_METHOD("get_bone_lod_max_depth"), &Skeleton::get_bone_lod_max_depth);
+
+	ClassDB::bind_method(D_METHOD("is_bone_reduced", "bone_idx"), &Skeleton::is_bone_reduced);
+
 #ifndef _3D_DISABLED
 
 	ClassDB::bind_method(D_METHOD("physical_bones_stop_simulation"), &Skeleton::physical_bones_stop_simulation);
@@ -898,6 +1017,10 @@ void Skeleton::_bind_methods() {
 
 #endif // _3D_DISABLED
 
+	ADD_GROUP("Bone LOD", "bone_lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "bone_lod_distance", PROPERTY_HINT_RANGE, "0,4096,0.1,or_greater"), "set_bone_lod_distance", "get_bone_lod_distance");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "bone_lod_max_depth", PROPERTY_HINT_RANGE, "0,64,1,or_greater"), "set_bone_lod_max_depth", "get_bone_lod_max_depth");
+
 	ADD_SIGNAL(MethodInfo("skeleton_updated"));
 
 	BIND_CONSTANT(NOTIFICATION_UPDATE_SKELETON);
@@ -906,6 +1029,10 @@ void Skeleton::_bind_methods() {
 Skeleton::Skeleton() {
 
 	dirty = false;
+	all_bones_dirty = true;
+	bone_lod_distance = 0;
+	bone_lod_max_depth = 3;
+	bone_lod_depth_limit = -1;
 	version = 1;
 	process_order_dirty = true;
 }
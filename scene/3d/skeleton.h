@@ -31,6 +31,7 @@
 #ifndef SKELETON_H
 #define SKELETON_H
 
+#include "core/local_vector.h"
 #include "core/rid.h"
 #include "scene/3d/spatial.h"
 #include "scene/resources/skin.h"
@@ -54,6 +55,7 @@ class SkinReference : public Reference {
 	uint64_t skeleton_version = 0;
 	Vector<uint32_t> skin_bone_indices;
 	uint32_t *skin_bone_indices_ptrs = nullptr;
+	Vector<Transform> bone_transforms; // CPU copy of what was last sent to the VisualServer skeleton.
 	void _skin_changed();
 
 protected:
@@ -63,6 +65,7 @@ public:
 	RID get_skeleton() const;
 	Skeleton *get_skeleton_node() const;
 	Ref<Skin> get_skin() const;
+	const Vector<Transform> &get_bone_transforms() const { return bone_transforms; }
 	~SkinReference();
 };
 
@@ -84,6 +87,7 @@ private:
 		bool enabled;
 		int parent;
 		int sort_index; //used for re-sorting process order
+		int depth; //distance to the root bone, used by the bone LOD
 
 		bool disable_rest;
 		Transform rest;
@@ -107,6 +111,7 @@ private:
 
 		Bone() {
 			parent = -1;
+			depth = 0;
 			enabled = true;
 			disable_rest = false;
 			custom_pose_enable = false;
@@ -123,9 +128,29 @@ private:
 	Vector<int> process_order;
 	bool process_order_dirty;
 
+	enum {
+		BONE_CLEAN,
+		BONE_DIRTY,
+		BONE_DIRTY_AGAIN, // updated, but must update again next time (global pose override reset)
+	};
+
+	// Kept apart from the bones so the update only walks a byte per bone to
+	// find changed chains. Children of dirty bones update as well.
+	LocalVector<uint8_t> bones_dirty;
+	bool all_bones_dirty;
+
+	void _make_bone_dirty(int p_bone);
 	void _make_dirty();
 	bool dirty;
 
+	// Bones deeper than bone_lod_max_depth stop being animated once the
+	// skeleton is further than bone_lod_distance from the camera.
+	float bone_lod_distance;
+	int bone_lod_max_depth;
+	int bone_lod_depth_limit; // -1 when all bones are animated
+
+	void _update_bone_lod();
+
 	uint64_t version;
 
 	// bind helpers
@@ -201,6 +226,19 @@ public:
 	void localize_rests(); // used for loaders and tools
 	int get_process_order(int p_idx);
 
+	// bone LOD
+
+	void set_bone_lod_distance(float p_distance);
+	float get_bone_lod_distance() const;
+
+	void set_bone_lod_max_depth(int p_depth);
+	int get_bone_lod_max_depth() const;
+
+	void update_bone_lod_at_distance(float p_camera_distance);
+	_FORCE_INLINE_ bool is_bone_reduced(int p_bone) const {
+		return bone_lod_depth_limit >= 0 && p_bone >= 0 && p_bone < bones.size() && bones[p_bone].depth > bone_lod_depth_limit;
+	}
+
 	Ref<SkinReference> register_skin(const Ref<Skin> &p_skin);
 
 #ifndef _3D_DISABLED
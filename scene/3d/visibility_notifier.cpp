@@ -34,6 +34,7 @@
 #include "scene/3d/camera.h"
 #include "scene/3d/physics_body.h"
 #include "scene/animation/animation_player.h"
+#include "scene/animation/animation_tree.h"
 #include "scene/scene_string_names.h"
 
 void VisibilityNotifier::_enter_camera(Camera *p_camera) {
@@ -169,6 +170,14 @@ void VisibilityEnabler::_find_nodes(Node *p_node) {
 		}
 	}
 
+	{
+		AnimationTree *at = Object::cast_to<AnimationTree>(p_node);
+		if (at) {
+			add = true;
+			meta = at->is_active(); // only resume trees that were running
+		}
+	}
+
 	if (add) {
 
 		p_node->connect(SceneStringNames::get_singleton()->tree_exiting, this, "_node_removed", varray(p_node), CONNECT_ONESHOT);
@@ -234,6 +243,13 @@ void VisibilityEnabler::_change_node_state(Node *p_node, bool p_enabled) {
 
 			ap->set_active(p_enabled);
 		}
+
+		AnimationTree *at = Object::cast_to<AnimationTree>(p_node);
+
+		if (at && bool(nodes[p_node])) {
+
+			at->set_active(p_enabled);
+		}
 	}
 }
 
@@ -35,9 +35,10 @@ void AnimationNodeBlendSpace2D::get_parameter_list(List<PropertyInfo> *r_list) c
 	r_list->push_back(PropertyInfo(Variant::VECTOR2, blend_position));
 	r_list->push_back(PropertyInfo(Variant::INT, closest, PROPERTY_HINT_NONE, "", 0));
 	r_list->push_back(PropertyInfo(Variant::REAL, length_internal, PROPERTY_HINT_NONE, "", 0));
+	r_list->push_back(PropertyInfo(Variant::INT, triangle_internal, PROPERTY_HINT_NONE, "", 0));
 }
 Variant AnimationNodeBlendSpace2D::get_parameter_default_value(const StringName &p_parameter) const {
-	if (p_parameter == closest) {
+	if (p_parameter == closest || p_parameter == triangle_internal) {
 		return -1;
 	} else if (p_parameter == length_internal) {
 		return 0;
@@ -76,6 +77,7 @@ void AnimationNodeBlendSpace2D::add_blend_point(const Ref<AnimationRootNode> &p_
 	}
 	blend_points[p_at_index].node = p_node;
 	blend_points[p_at_index].position = p_position;
+	grid_dirty = true;
 
 	blend_points[p_at_index].node->connect("tree_changed", this, "_tree_changed", varray(), CONNECT_REFERENCE_COUNTED);
 	blend_points_used++;
@@ -88,6 +90,7 @@ void AnimationNodeBlendSpace2D::add_blend_point(const Ref<AnimationRootNode> &p_
 void AnimationNodeBlendSpace2D::set_blend_point_position(int p_point, const Vector2 &p_position) {
 	ERR_FAIL_INDEX(p_point, blend_points_used);
 	blend_points[p_point].position = p_position;
+	grid_dirty = true;
 	_queue_auto_triangles();
 }
 void AnimationNodeBlendSpace2D::set_blend_point_node(int p_point, const Ref<AnimationRootNode> &p_node) {
@@ -137,6 +140,7 @@ void AnimationNodeBlendSpace2D::remove_blend_point(int p_point) {
 		blend_points[i] = blend_points[i + 1];
 	}
 	blend_points_used--;
+	grid_dirty = true;
 	emit_signal("tree_changed");
 }
 
@@ -206,6 +210,7 @@ void AnimationNodeBlendSpace2D::add_triangle(int p_x, int p_y, int p_z, int p_at
 	} else {
 		triangles.insert(p_at_index, t);
 	}
+	grid_dirty = true;
 }
 int AnimationNodeBlendSpace2D::get_triangle_point(int p_triangle, int p_point) {
 
@@ -219,6 +224,7 @@ void AnimationNodeBlendSpace2D::remove_triangle(int p_triangle) {
 	ERR_FAIL_INDEX(p_triangle, triangles.size());
 
 	triangles.remove(p_triangle);
+	grid_dirty = true;
 }
 
 int AnimationNodeBlendSpace2D::get_triangle_count() const {
@@ -323,6 +329,7 @@ void AnimationNodeBlendSpace2D::_update_triangles() {
 
 	trianges_dirty = false;
 	triangles.clear();
+	grid_dirty = true;
 	if (blend_points_used < 3) {
 		emit_signal("triangles_updated");
 		return;
@@ -349,18 +356,17 @@ Vector2 AnimationNodeBlendSpace2D::get_closest_point(const Vector2 &p_point) {
 	if (triangles.size() == 0)
 		return Vector2();
 
+	if (_find_triangle(p_point, -1, NULL) != -1) {
+		return p_point;
+	}
+
 	Vector2 best_point;
 	bool first = true;
 
 	for (int i = 0; i < triangles.size(); i++) {
 		Vector2 points[3];
 		for (int j = 0; j < 3; j++) {
-			points[j] = get_blend_point_position(get_triangle_point(i, j));
-		}
-
-		if (Geometry::is_point_in_triangle(p_point, points[0], points[1], points[2])) {
-
-			return p_point;
+			points[j] = blend_points[triangles[i].points[j]].position;
 		}
 
 		for (int j = 0; j < 3; j++) {
@@ -425,6 +431,133 @@ void AnimationNodeBlendSpace2D::_blend_triangle(const Vector2 &p_pos, const Vect
 	r_weights[2] = w;
 }
 
+void AnimationNodeBlendSpace2D::_get_grid_cell_range(const Vector2 &p_min, const Vector2 &p_max, int *r_from, int *r_to) const {
+
+	Vector2 scale = Vector2(grid_cells_per_axis, grid_cells_per_axis) / grid_rect.size;
+	Vector2 from = (p_min - grid_rect.position) * scale;
+	Vector2 to = (p_max - grid_rect.position) * scale;
+
+	r_from[0] = CLAMP(int(Math::floor(from.x)), 0, grid_cells_per_axis - 1);
+	r_from[1] = CLAMP(int(Math::floor(from.y)), 0, grid_cells_per_axis - 1);
+	r_to[0] = CLAMP(int(Math::floor(to.x)), 0, grid_cells_per_axis - 1);
+	r_to[1] = CLAMP(int(Math::floor(to.y)), 0, grid_cells_per_axis - 1);
+}
+
+void AnimationNodeBlendSpace2D::_update_grid() {
+
+	if (!grid_dirty)
+		return;
+
+	grid_dirty = false;
+	grid_offsets.clear();
+	grid_triangles.clear();
+
+	int triangle_count = triangles.size();
+	if (triangle_count == 0)
+		return;
+
+	grid_rect = Rect2(blend_points[triangles[0].points[0]].position, Vector2());
+	for (int i = 0; i < triangle_count; i++) {
+		for (int j = 0; j < 3; j++) {
+			grid_rect.expand_to(blend_points[triangles[i].points[j]].position);
+		}
+	}
+	// Keep degenerate (flat) layouts from dividing by zero.
+	grid_rect.size.x = MAX(grid_rect.size.x, CMP_EPSILON);
+	grid_rect.size.y = MAX(grid_rect.size.y, CMP_EPSILON);
+
+	grid_cells_per_axis = CLAMP(int(Math::ceil(Math::sqrt(float(triangle_count)))), 1, int(MAX_GRID_CELLS_PER_AXIS));
+
+	// Count the triangles per cell, turn the counts into offsets, then fill.
+	grid_offsets.resize(grid_cells_per_axis * grid_cells_per_axis + 1);
+	for (uint32_t i = 0; i < grid_offsets.size(); i++) {
+		grid_offsets[i] = 0;
+	}
+
+	for (int pass = 0; pass < 2; pass++) {
+		for (int i = 0; i < triangle_count; i++) {
+			Vector2 min = blend_points[triangles[i].points[0]].position;
+			Vector2 max = min;
+			for (int j = 1; j < 3; j++) {
+				Vector2 p = blend_points[triangles[i].points[j]].position;
+				min.x = MIN(min.x, p.x);
+				min.y = MIN(min.y, p.y);
+				max.x = MAX(max.x, p.x);
+				max.y = MAX(max.y, p.y);
+			}
+
+			int from[2], to[2];
+			_get_grid_cell_range(min, max, from, to);
+
+			for (int y = from[1]; y <= to[1]; y++) {
+				for (int x = from[0]; x <= to[0]; x++) {
+					int cell = y * grid_cells_per_axis + x;
+					if (pass == 0) {
+						grid_offsets[cell + 1]++;
+					} else {
+						grid_triangles[grid_offsets[cell]++] = i;
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			for (uint32_t i = 1; i < grid_offsets.size(); i++) {
+				grid_offsets[i] += grid_offsets[i - 1];
+			}
+			grid_triangles.resize(grid_offsets[grid_offsets.size() - 1]);
+		}
+	}
+
+	// The fill pass advanced each offset to the start of the next cell.
+	for (uint32_t i = grid_offsets.size() - 1; i > 0; i--) {
+		grid_offsets[i] = grid_offsets[i - 1];
+	}
+	grid_offsets[0] = 0;
+}
+
+int AnimationNodeBlendSpace2D::_find_triangle(const Vector2 &p_pos, int p_hint, float *r_weights) {
+
+	Vector2 points[3];
+
+	// The blend position usually stays within the same triangle between frames.
+	if (p_hint >= 0 && p_hint < triangles.size()) {
+		for (int j = 0; j < 3; j++) {
+			points[j] = blend_points[triangles[p_hint].points[j]].position;
+		}
+		if (Geometry::is_point_in_triangle(p_pos, points[0], points[1], points[2])) {
+			if (r_weights) {
+				_blend_triangle(p_pos, points, r_weights);
+			}
+			return p_hint;
+		}
+	}
+
+	_update_grid();
+
+	if (grid_offsets.empty())
+		return -1;
+
+	int from[2], to[2];
+	_get_grid_cell_range(p_pos, p_pos, from, to);
+	int cell = from[1] * grid_cells_per_axis + from[0];
+
+	for (uint32_t k = grid_offsets[cell]; k < grid_offsets[cell + 1]; k++) {
+		int i = grid_triangles[k];
+		for (int j = 0; j < 3; j++) {
+			points[j] = blend_points[triangles[i].points[j]].position;
+		}
+		if (Geometry::is_point_in_triangle(p_pos, points[0], points[1], points[2])) {
+			if (r_weights) {
+				_blend_triangle(p_pos, points, r_weights);
+			}
+			return i;
+		}
+	}
+
+	return -1;
+}
+
 float AnimationNodeBlendSpace2D::process(float p_time, bool p_seek) {
 
 	_update_triangles();
@@ -441,43 +574,39 @@ float AnimationNodeBlendSpace2D::process(float p_time, bool p_seek) {
 
 		Vector2 best_point;
 		bool first = true;
-		int blend_triangle = -1;
 		float blend_weights[3] = { 0, 0, 0 };
+		int blend_triangle = _find_triangle(blend_pos, get_parameter(triangle_internal), blend_weights);
+
+		if (blend_triangle == -1) {
+			// Outside of every triangle, blend along the closest edge.
+			for (int i = 0; i < triangles.size(); i++) {
+				Vector2 points[3];
+				for (int j = 0; j < 3; j++) {
+					points[j] = blend_points[triangles[i].points[j]].position;
+				}
 
-		for (int i = 0; i < triangles.size(); i++) {
-			Vector2 points[3];
-			for (int j = 0; j < 3; j++) {
-				points[j] = get_blend_point_position(get_triangle_point(i, j));
-			}
-
-			if (Geometry::is_point_in_triangle(blend_pos, points[0], points[1], points[2])) {
-
-				blend_triangle = i;
-				_blend_triangle(blend_pos, points, blend_weights);
-				break;
-			}
-
-			for (int j = 0; j < 3; j++) {
-				Vector2 s[2] = {
-					points[j],
-					points[(j + 1) % 3]
-				};
-				Vector2 closest2 = Geometry::get_closest_point_to_segment_2d(blend_pos, s);
-				if (first || closest2.distance_to(blend_pos) < best_point.distance_to(blend_pos)) {
-					best_point = closest2;
-					blend_triangle = i;
-					first = false;
-					float d = s[0].distance_to(s[1]);
-					if (d == 0.0) {
-						blend_weights[j] = 1.0;
-						blend_weights[(j + 1) % 3] = 0.0;
-						blend_weights[(j + 2) % 3] = 0.0;
-					} else {
-						float c = s[0].distance_to(closest2) / d;
-
-						blend_weights[j] = 1.0 - c;
-						blend_weights[(j + 1) % 3] = c;
-						blend_weights[(j + 2) % 3] = 0.0;
+				for (int j = 0; j < 3; j++) {
+					Vector2 s[2] = {
+						points[j],
+						points[(j + 1) % 3]
+					};
+					Vector2 closest2 = Geometry::get_closest_point_to_segment_2d(blend_pos, s);
+					if (first || closest2.distance_to(blend_pos) < best_point.distance_to(blend_pos)) {
+						best_point = closest2;
+						blend_triangle = i;
+						first = false;
+						float d = s[0].distance_to(s[1]);
+						if (d == 0.0) {
+							blend_weights[j] = 1.0;
+							blend_weights[(j + 1) % 3] = 0.0;
+							blend_weights[(j + 2) % 3] = 0.0;
+						} else {
+							float c = s[0].distance_to(closest2) / d;
+
+							blend_weights[j] = 1.0 - c;
+							blend_weights[(j + 1) % 3] = c;
+							blend_weights[(j + 2) % 3] = 0.0;
+						}
 					}
 				}
 			}
@@ -485,6 +614,8 @@ float AnimationNodeBlendSpace2D::process(float p_time, bool p_seek) {
 
 		ERR_FAIL_COND_V(blend_triangle == -1, 0); //should never reach here
 
+		set_parameter(triangle_internal, blend_triangle);
+
 		int triangle_points[3];
 		for (int j = 0; j < 3; j++) {
 			triangle_points[j] = get_triangle_point(blend_triangle, j);
@@ -681,6 +812,9 @@ AnimationNodeBlendSpace2D::AnimationNodeBlendSpace2D() {
 	blend_position = "blend_position";
 	closest = "closest";
 	length_internal = "length_internal";
+	triangle_internal = "triangle_internal";
+	grid_cells_per_axis = 1;
+	grid_dirty = true;
 	blend_mode = BLEND_MODE_INTERPOLATED;
 }
 
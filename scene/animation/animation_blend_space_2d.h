@@ -31,6 +31,7 @@
 #ifndef ANIMATION_BLEND_SPACE_2D_H
 #define ANIMATION_BLEND_SPACE_2D_H
 
+#include "core/local_vector.h"
 #include "scene/animation/animation_tree.h"
 
 class AnimationNodeBlendSpace2D : public AnimationRootNode {
@@ -63,9 +64,22 @@ protected:
 
 	Vector<BlendTriangle> triangles;
 
+	// Uniform grid over the triangles, each cell listing (in index order) the
+	// triangles whose bounds overlap it, so lookups only test a few of them.
+	enum {
+		MAX_GRID_CELLS_PER_AXIS = 16
+	};
+
+	Rect2 grid_rect;
+	int grid_cells_per_axis;
+	LocalVector<uint32_t> grid_offsets;
+	LocalVector<int> grid_triangles;
+	bool grid_dirty;
+
 	StringName blend_position;
 	StringName closest;
 	StringName length_internal;
+	StringName triangle_internal;
 	Vector2 max_space;
 	Vector2 min_space;
 	Vector2 snap;
@@ -79,6 +93,10 @@ protected:
 
 	void _blend_triangle(const Vector2 &p_pos, const Vector2 *p_points, float *r_weights);
 
+	void _get_grid_cell_range(const Vector2 &p_min, const Vector2 &p_max, int *r_from, int *r_to) const;
+	void _update_grid();
+	int _find_triangle(const Vector2 &p_pos, int p_hint, float *r_weights);
+
 	bool auto_triangles;
 	bool trianges_dirty;
 
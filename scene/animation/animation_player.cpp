@@ -35,6 +35,10 @@
 #include "scene/scene_string_names.h"
 #include "servers/audio/audio_stream.h"
 
+#ifndef _3D_DISABLED
+#include "scene/3d/camera.h"
+#endif
+
 #ifdef TOOLS_ENABLED
 #include "editor/editor_settings.h"
 #include "scene/2d/skeleton_2d.h"
@@ -184,6 +188,50 @@ void AnimationPlayer::advance(float p_time) {
 	_animation_process(p_time);
 }
 
+void AnimationUpdateLOD::update_spatial(const Node *p_node) {
+
+	spatial = NULL;
+	for (const Node *n = p_node; n && !spatial; n = n->get_parent()) {
+		spatial = Object::cast_to<Spatial>(n);
+	}
+}
+
+bool AnimationUpdateLOD::process(const Node *p_node, uint64_t p_frame, float &r_delta) {
+
+	if (distance <= 0 || Engine::get_singleton()->is_editor_hint()) {
+		skipped_delta = 0;
+		return true;
+	}
+
+	float camera_distance = -1;
+#ifndef _3D_DISABLED
+	Camera *camera = p_node->get_viewport() ? p_node->get_viewport()->get_camera() : NULL;
+	if (spatial && camera) {
+		camera_distance = camera->get_global_transform().origin.distance_to(spatial->get_global_transform().origin);
+	}
+#endif
+
+	return process_at_distance(camera_distance, p_node->get_instance_id(), p_frame, r_delta);
+}
+
+bool AnimationUpdateLOD::process_at_distance(float p_camera_distance, uint64_t p_stagger, uint64_t p_frame, float &r_delta) {
+
+	if (distance > 0 && p_camera_distance >= 0) {
+		int band = MIN(int(p_camera_distance / distance), 16);
+		int interval = MIN(1 << band, max_interval);
+
+		// Offset by the stagger so that nodes in the same band don't all update on the same frame.
+		if (interval > 1 && (p_frame + p_stagger) % interval != 0) {
+			skipped_delta += r_delta;
+			return false;
+		}
+	}
+
+	r_delta += skipped_delta;
+	skipped_delta = 0;
+	return true;
+}
+
 void AnimationPlayer::_notification(int p_what) {
 
 	switch (p_what) {
@@ -198,6 +246,11 @@ void AnimationPlayer::_notification(int p_what) {
 			}
 			//_set_process(false);
 			clear_caches();
+			update_lod.update_spatial(this);
+		} break;
+		case NOTIFICATION_PARENTED: {
+
+			update_lod.update_spatial(this);
 		} break;
 		case NOTIFICATION_READY: {
 
@@ -210,20 +263,27 @@ void AnimationPlayer::_notification(int p_what) {
 			if (animation_process_mode == ANIMATION_PROCESS_PHYSICS)
 				break;
 
-			if (processing)
-				_animation_process(get_process_delta_time());
+			if (processing) {
+				float delta = get_process_delta_time();
+				if (update_lod.process(this, Engine::get_singleton()->get_idle_frames(), delta))
+					_animation_process_or_queue(delta);
+			}
 		} break;
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
 
 			if (animation_process_mode == ANIMATION_PROCESS_IDLE)
 				break;
 
-			if (processing)
-				_animation_process(get_physics_process_delta_time());
+			if (processing) {
+				float delta = get_physics_process_delta_time();
+				if (update_lod.process(this, Engine::get_singleton()->get_physics_frames(), delta))
+					_animation_process_or_queue(delta);
+			}
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
 
 			clear_caches();
+			update_lod.spatial = NULL;
 		} break;
 	}
 }
@@ -241,10 +301,12 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 	Animation *a = p_anim->animation.operator->();
 
 	p_anim->node_cache.resize(a->get_track_count());
+	p_anim->key_cursors.resize(a->get_track_count());
 
 	for (int i = 0; i < a->get_track_count(); i++) {
 
 		p_anim->node_cache.write[i] = NULL;
+		p_anim->key_cursors[i] = -1;
 		RES resource;
 		Vector<StringName> leftover_path;
 		Node *child = parent->get_node_and_resource(a->track_get_path(i), resource, leftover_path);
@@ -341,10 +403,25 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 	}
 }
 
-void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float p_time, float p_delta, float p_interp, bool p_is_current, bool p_seeked, bool p_started) {
+void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float p_time, float p_delta, float p_interp, bool p_is_current, bool p_seeked, bool p_started, bool p_skip_transforms) {
 
-	_ensure_node_caches(p_anim);
-	ERR_FAIL_COND(p_anim->node_cache.size() != p_anim->animation->get_track_count());
+	if (parallel_sampling) {
+		// on the work pool, caches were ensured before queuing
+		ERR_FAIL_COND(p_anim->node_cache.size() != p_anim->animation->get_track_count());
+
+		ParallelStep step;
+		step.anim = p_anim;
+		step.time = p_time;
+		step.delta = p_delta;
+		step.interp = p_interp;
+		step.is_current = p_is_current;
+		step.seeked = p_seeked;
+		step.started = p_started;
+		parallel_steps.push_back(step);
+	} else {
+		_ensure_node_caches(p_anim);
+		ERR_FAIL_COND(p_anim->node_cache.size() != p_anim->animation->get_track_count());
+	}
 
 	Animation *a = p_anim->animation.operator->();
 	bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
@@ -357,7 +434,12 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 			_ensure_node_caches(p_anim);
 		}
 
+		// only transform tracks are sampled in parallel, they just accumulate
+		if (parallel_sampling ? a->track_get_type(i) != Animation::TYPE_TRANSFORM : p_skip_transforms && a->track_get_type(i) == Animation::TYPE_TRANSFORM)
+			continue;
+
 		TrackNodeCache *nc = p_anim->node_cache[i];
+		int *key_cursor = &p_anim->key_cursors[i];
 
 		if (!nc)
 			continue; // no node cache for this track, skip it
@@ -375,11 +457,14 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 				if (!nc->spatial)
 					continue;
 
+				if (nc->skeleton && nc->bone_idx >= 0 && nc->skeleton->is_bone_reduced(nc->bone_idx))
+					continue; // bone LOD, keeps its last pose
+
 				Vector3 loc;
 				Quat rot;
 				Vector3 scale;
 
-				Error err = a->transform_track_interpolate(i, p_time, &loc, &rot, &scale);
+				Error err = a->transform_track_interpolate(i, p_time, &loc, &rot, &scale, key_cursor);
 				//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 
 				if (err != OK)
@@ -458,7 +543,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 
 				if (update_mode == Animation::UPDATE_CONTINUOUS || update_mode == Animation::UPDATE_CAPTURE || (p_delta == 0 && update_mode == Animation::UPDATE_DISCRETE)) { //delta == 0 means seek
 
-					Variant value = a->value_track_interpolate(i, p_time);
+					Variant value = a->value_track_interpolate(i, p_time, key_cursor);
 
 					if (value == Variant())
 						continue;
@@ -589,7 +674,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 
 				TrackNodeCache::BezierAnim *ba = &E->get();
 
-				float bezier = a->bezier_track_interpolate(i, p_time);
+				float bezier = a->bezier_track_interpolate(i, p_time, key_cursor);
 				if (ba->accum_pass != accum_pass) {
 					ERR_CONTINUE(cache_update_bezier_size >= NODE_CACHE_UPDATE_MAX);
 					cache_update_bezier[cache_update_bezier_size++] = ba;
@@ -927,6 +1012,32 @@ void AnimationPlayer::_animation_update_transforms() {
 	cache_update_bezier_size = 0;
 }
 
+void AnimationPlayer::_animation_process_finish() {
+
+	if (playback.started) {
+		playback.started = false;
+	}
+
+	_animation_update_transforms();
+	if (end_reached) {
+		if (queued.size()) {
+			String old = playback.assigned;
+			play(queued.front()->get());
+			String new_name = playback.assigned;
+			queued.pop_front();
+			if (end_notify)
+				emit_signal(SceneStringNames::get_singleton()->animation_changed, old, new_name);
+		} else {
+			//stop();
+			playing = false;
+			_set_process(false);
+			if (end_notify)
+				emit_signal(SceneStringNames::get_singleton()->animation_finished, playback.assigned);
+		}
+		end_reached = false;
+	}
+}
+
 void AnimationPlayer::_animation_process(float p_delta) {
 
 	if (playback.current.from) {
@@ -934,35 +1045,73 @@ void AnimationPlayer::_animation_process(float p_delta) {
 		end_reached = false;
 		end_notify = false;
 		_animation_process2(p_delta, playback.started);
-
-		if (playback.started) {
-			playback.started = false;
-		}
-
-		_animation_update_transforms();
-		if (end_reached) {
-			if (queued.size()) {
-				String old = playback.assigned;
-				play(queued.front()->get());
-				String new_name = playback.assigned;
-				queued.pop_front();
-				if (end_notify)
-					emit_signal(SceneStringNames::get_singleton()->animation_changed, old, new_name);
-			} else {
-				//stop();
-				playing = false;
-				_set_process(false);
-				if (end_notify)
-					emit_signal(SceneStringNames::get_singleton()->animation_finished, playback.assigned);
-			}
-			end_reached = false;
-		}
+		_animation_process_finish();
 
 	} else {
 		_set_process(false);
 	}
 }
 
+void AnimationPlayer::_animation_process_or_queue(float p_delta) {
+
+	if (!playback.current.from || !is_inside_tree() || !get_tree()->is_parallel_animation_enabled()) {
+		_animation_process(p_delta);
+		return;
+	}
+
+	// node lookups can't happen on the work pool
+	_ensure_node_caches(playback.current.from);
+	for (List<Blend>::Element *E = playback.blend.front(); E; E = E->next()) {
+		_ensure_node_caches(E->get().data.from);
+	}
+
+	parallel_delta = p_delta;
+	parallel_sampled = false;
+	get_tree()->queue_parallel_process(this, &AnimationPlayer::_parallel_process, &AnimationPlayer::_parallel_process_finish);
+}
+
+void AnimationPlayer::_parallel_process(Node *p_node) {
+
+	AnimationPlayer *player = static_cast<AnimationPlayer *>(p_node);
+
+	// playback may have changed since queuing, leave it to the main thread then
+	if (!player->playback.current.from || player->playback.current.from->node_cache.size() != player->playback.current.from->animation->get_track_count())
+		return;
+	for (List<Blend>::Element *E = player->playback.blend.front(); E; E = E->next()) {
+		if (E->get().data.from->node_cache.size() != E->get().data.from->animation->get_track_count())
+			return;
+	}
+
+	player->end_reached = false;
+	player->end_notify = false;
+	player->parallel_steps.clear();
+
+	player->parallel_sampling = true;
+	player->_animation_process2(player->parallel_delta, player->playback.started);
+	player->parallel_sampling = false;
+	player->parallel_sampled = true;
+}
+
+void AnimationPlayer::_parallel_process_finish(Node *p_node) {
+
+	AnimationPlayer *player = static_cast<AnimationPlayer *>(p_node);
+
+	if (!player->parallel_sampled) {
+		player->_animation_process(player->parallel_delta);
+		return;
+	}
+
+	player->parallel_sampled = false;
+
+	for (uint32_t i = 0; i < player->parallel_steps.size(); i++) {
+		const ParallelStep &step = player->parallel_steps[i];
+		player->_animation_process_animation(step.anim, step.time, step.delta, step.interp, step.is_current, step.seeked, step.started, true);
+	}
+	player->parallel_steps.clear();
+
+	player->_animation_process_finish();
+}
+
 Error AnimationPlayer::add_animation(const StringName &p_name, const Ref<Animation> &p_animation) {
 
 #ifdef DEBUG_ENABLED
@@ -1482,6 +1631,27 @@ AnimationPlayer::AnimationMethodCallMode AnimationPlayer::get_method_call_mode()
 	return method_call_mode;
 }
 
+void AnimationPlayer::set_update_lod_distance(float p_distance) {
+
+	update_lod.distance = MAX(p_distance, 0);
+	update_lod.skipped_delta = 0;
+}
+
+float AnimationPlayer::get_update_lod_distance() const {
+
+	return update_lod.distance;
+}
+
+void AnimationPlayer::set_update_lod_max_interval(int p_interval) {
+
+	update_lod.max_interval = CLAMP(p_interval, 1, 64);
+}
+
+int AnimationPlayer::get_update_lod_max_interval() const {
+
+	return update_lod.max_interval;
+}
+
 void AnimationPlayer::_set_process(bool p_process, bool p_force) {
 
 	if (processing == p_process && !p_force)
@@ -1495,6 +1665,7 @@ void AnimationPlayer::_set_process(bool p_process, bool p_force) {
 	}
 
 	processing = p_process;
+	update_lod.skipped_delta = 0;
 }
 
 void AnimationPlayer::animation_set_next(const StringName &p_animation, const StringName &p_next) {
@@ -1672,6 +1843,12 @@ void AnimationPlayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_method_call_mode", "mode"), &AnimationPlayer::set_method_call_mode);
 	ClassDB::bind_method(D_METHOD("get_method_call_mode"), &AnimationPlayer::get_method_call_mode);
 
+	ClassDB::bind_method(D_METHOD("set_update_lod_distance", "distance"), &AnimationPlayer::set_update_lod_distance);
+	ClassDB::bind_method(D_METHOD("get_update_lod_distance"), &AnimationPlayer::get_update_lod_distance);
+
+	ClassDB::bind_method(D_METHOD("set_update_lod_max_interval", "interval"), &AnimationPlayer::set_update_lod_max_interval);
+	ClassDB::bind_method(D_METHOD("get_update_lod_max_interval"), &AnimationPlayer::get_update_lod_max_interval);
+
 	ClassDB::bind_method(D_METHOD("get_current_animation_position"), &AnimationPlayer::get_current_animation_position);
 	ClassDB::bind_method(D_METHOD("get_current_animation_length"), &AnimationPlayer::get_current_animation_length);
 
@@ -1692,6 +1869,10 @@ void AnimationPlayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "playback_speed", PROPERTY_HINT_RANGE, "-64,64,0.01"), "set_speed_scale", "get_speed_scale");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "method_call_mode", PROPERTY_HINT_ENUM, "Deferred,Immediate"), "set_method_call_mode", "get_method_call_mode");
 
+	ADD_GROUP("Update LOD", "update_lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "update_lod_distance", PROPERTY_HINT_RANGE, "0,4096,0.1,or_greater"), "set_update_lod_distance", "get_update_lod_distance");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "update_lod_max_interval", PROPERTY_HINT_RANGE, "1,64,1"), "set_update_lod_max_interval", "get_update_lod_max_interval");
+
 	ADD_SIGNAL(MethodInfo("animation_finished", PropertyInfo(Variant::STRING, "anim_name")));
 	ADD_SIGNAL(MethodInfo("animation_changed", PropertyInfo(Variant::STRING, "old_name"), PropertyInfo(Variant::STRING, "new_name")));
 	ADD_SIGNAL(MethodInfo("animation_started", PropertyInfo(Variant::STRING, "anim_name")));
@@ -1714,6 +1895,9 @@ AnimationPlayer::AnimationPlayer() {
 	speed_scale = 1;
 	end_reached = false;
 	end_notify = false;
+	parallel_sampling = false;
+	parallel_sampled = false;
+	parallel_delta = 0;
 	animation_process_mode = ANIMATION_PROCESS_IDLE;
 	method_call_mode = ANIMATION_METHOD_CALL_DEFERRED;
 	processing = false;
@@ -31,6 +31,7 @@
 #ifndef ANIMATION_PLAYER_H
 #define ANIMATION_PLAYER_H
 
+#include "core/local_vector.h"
 #include "scene/2d/node_2d.h"
 #include "scene/3d/skeleton.h"
 #include "scene/3d/spatial.h"
@@ -54,6 +55,27 @@ public:
 };
 #endif
 
+// Lowers the update rate of an animation node as it gets further from the
+// current camera. Skipped time is accumulated and applied on the next update.
+struct AnimationUpdateLOD {
+	float distance; // Width of each distance band, 0 disables the LOD.
+	int max_interval;
+	float skipped_delta;
+	const Spatial *spatial; // The node itself or its closest Spatial ancestor, found when entering the tree.
+
+	void update_spatial(const Node *p_node);
+	bool process(const Node *p_node, uint64_t p_frame, float &r_delta);
+	// Negative distances (no camera) update every frame. p_stagger spreads nodes in the same band over frames.
+	bool process_at_distance(float p_camera_distance, uint64_t p_stagger, uint64_t p_frame, float &r_delta);
+
+	AnimationUpdateLOD() {
+		distance = 0;
+		max_interval = 8;
+		skipped_delta = 0;
+		spatial = NULL;
+	}
+};
+
 class AnimationPlayer : public Node {
 	GDCLASS(AnimationPlayer, Node);
 	OBJ_CATEGORY("Animation Nodes");
@@ -191,6 +213,7 @@ private:
 		String name;
 		StringName next;
 		Vector<TrackNodeCache *> node_cache;
+		LocalVector<int> key_cursors; // last key found per track, speeds up sequential playback
 		Ref<Animation> animation;
 	};
 
@@ -246,21 +269,45 @@ private:
 	bool end_reached;
 	bool end_notify;
 
+	// Playback state for SceneTree::queue_parallel_process(): transform tracks
+	// are sampled on the work pool, the other tracks are processed afterwards
+	// on the main thread for every animation sampled.
+	struct ParallelStep {
+		AnimationData *anim;
+		float time;
+		float delta;
+		float interp;
+		bool is_current;
+		bool seeked;
+		bool started;
+	};
+
+	bool parallel_sampling;
+	bool parallel_sampled;
+	float parallel_delta;
+	LocalVector<ParallelStep> parallel_steps;
+
 	String autoplay;
 	AnimationProcessMode animation_process_mode;
 	AnimationMethodCallMode method_call_mode;
 	bool processing;
+	AnimationUpdateLOD update_lod;
 	bool active;
 
 	NodePath root;
 
-	void _animation_process_animation(AnimationData *p_anim, float p_time, float p_delta, float p_interp, bool p_is_current = true, bool p_seeked = false, bool p_started = false);
+	void _animation_process_animation(AnimationData *p_anim, float p_time, float p_delta, float p_interp, bool p_is_current = true, bool p_seeked = false, bool p_started = false, bool p_skip_transforms = false);
 
 	void _ensure_node_caches(AnimationData *p_anim);
 	void _animation_process_data(PlaybackData &cd, float p_delta, float p_blend, bool p_seeked, bool p_started);
 	void _animation_process2(float p_delta, bool p_started);
 	void _animation_update_transforms();
+	void _animation_process_finish();
 	void _animation_process(float p_delta);
+	void _animation_process_or_queue(float p_delta);
+
+	static void _parallel_process(Node *p_node);
+	static void _parallel_process_finish(Node *p_node);
 
 	void _node_removed(Node *p_node);
 	void _stop_playing_caches();
@@ -344,6 +391,12 @@ public:
 	void set_method_call_mode(AnimationMethodCallMode p_mode);
 	AnimationMethodCallMode get_method_call_mode() const;
 
+	void set_update_lod_distance(float p_distance);
+	float get_update_lod_distance() const;
+
+	void set_update_lod_max_interval(int p_interval);
+	int get_update_lod_max_interval() const;
+
 	void seek(float p_time, bool p_update = false);
 	void seek_delta(float p_time, float p_delta);
 	float get_current_animation_position() const;
@@ -488,6 +488,7 @@ void AnimationTree::set_active(bool p_active) {
 
 	active = p_active;
 	started = active;
+	update_lod.skipped_delta = 0;
 
 	if (process_mode == ANIMATION_PROCESS_IDLE) {
 		set_process_internal(active);
@@ -534,6 +535,27 @@ AnimationTree::AnimationProcessMode AnimationTree::get_process_mode() const {
 	return process_mode;
 }
 
+void AnimationTree::set_update_lod_distance(float p_distance) {
+
+	update_lod.distance = MAX(p_distance, 0);
+	update_lod.skipped_delta = 0;
+}
+
+float AnimationTree::get_update_lod_distance() const {
+
+	return update_lod.distance;
+}
+
+void AnimationTree::set_update_lod_max_interval(int p_interval) {
+
+	update_lod.max_interval = CLAMP(p_interval, 1, 64);
+}
+
+int AnimationTree::get_update_lod_max_interval() const {
+
+	return update_lod.max_interval;
+}
+
 void AnimationTree::_node_removed(Node *p_node) {
 	cache_valid = false;
 }
@@ -743,7 +765,7 @@ void AnimationTree::_clear_caches() {
 	cache_valid = false;
 }
 
-void AnimationTree::_process_graph(float p_delta) {
+bool AnimationTree::_process_graph_states(float p_delta) {
 
 	_update_properties(); //if properties need updating, update them
 
@@ -755,14 +777,14 @@ void AnimationTree::_process_graph(float p_delta) {
 		ERR_PRINT("AnimationTree: root AnimationNode is not set, disabling playback.");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	if (!has_node(animation_player)) {
 		ERR_PRINT("AnimationTree: no valid AnimationPlayer path set, disabling playback");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(get_node(animation_player));
@@ -793,12 +815,12 @@ void AnimationTree::_process_graph(float p_delta) {
 		ERR_PRINT("AnimationTree: path points to a node not an AnimationPlayer, disabling playback");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	if (!cache_valid) {
 		if (!_update_caches(player)) {
-			return;
+			return false;
 		}
 	}
 
@@ -836,9 +858,11 @@ void AnimationTree::_process_graph(float p_delta) {
 		root->_pre_process(SceneStringNames::get_singleton()->parameters_base_path, NULL, &state, p_delta, false, Vector<StringName>());
 	}
 
-	if (!state.valid) {
-		return; //state is not valid. do nothing.
-	}
+	return state.valid;
+}
+
+void AnimationTree::_process_graph_tracks(bool p_transforms, bool p_others) {
+
 	//apply value/transform/bezier blends to track caches and execute method/audio/animation tracks
 
 	{
@@ -866,6 +890,10 @@ void AnimationTree::_process_graph(float p_delta) {
 					continue; //may happen should not
 				}
 
+				if (track->type == Animation::TYPE_TRANSFORM ? !p_transforms : !p_others) {
+					continue;
+				}
+
 				track->root_motion = root_motion_track == path;
 
 				ERR_CONTINUE(!state.track_map.has(path));
@@ -884,6 +912,9 @@ void AnimationTree::_process_graph(float p_delta) {
 
 						TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
 
+						if (!track->root_motion && t->skeleton && t->bone_idx >= 0 && t->skeleton->is_bone_reduced(t->bone_idx))
+							continue; // bone LOD, keeps its last pose
+
 						if (track->root_motion) {
 
 							if (t->process_pass != process_pass) {
@@ -1222,6 +1253,9 @@ void AnimationTree::_process_graph(float p_delta) {
 			}
 		}
 	}
+}
+
+void AnimationTree::_process_graph_apply() {
 
 	{
 		// finally, set the tracks
@@ -1280,6 +1314,76 @@ void AnimationTree::_process_graph(float p_delta) {
 	}
 }
 
+void AnimationTree::_process_graph(float p_delta) {
+
+	if (!_process_graph_states(p_delta)) {
+		return;
+	}
+
+	_process_graph_tracks(true, true);
+	_process_graph_apply();
+}
+
+void AnimationTree::_process_graph_or_queue(float p_delta) {
+
+	if (!get_tree()->is_parallel_animation_enabled()) {
+		_process_graph(p_delta);
+		return;
+	}
+
+	// the graph itself may run scripts, so only the blending of its result is queued
+	if (_process_graph_states(p_delta)) {
+		parallel_sampled = false;
+		get_tree()->queue_parallel_process(this, &AnimationTree::_parallel_process, &AnimationTree::_parallel_process_finish);
+	}
+}
+
+void AnimationTree::_parallel_process(Node *p_node) {
+
+	AnimationTree *tree = static_cast<AnimationTree *>(p_node);
+
+	if (!tree->cache_valid || !tree->state.valid)
+		return; // caches were cleared since queuing
+
+	tree->_process_graph_tracks(true, false);
+	tree->parallel_sampled = true;
+}
+
+void AnimationTree::_parallel_process_finish(Node *p_node) {
+
+	AnimationTree *tree = static_cast<AnimationTree *>(p_node);
+
+	if (tree->parallel_sampled && tree->cache_valid) {
+		tree->parallel_sampled = false;
+		tree->_process_graph_tracks(false, true);
+		tree->_process_graph_apply();
+		return;
+	}
+
+	// the caches were cleared since queuing, so nothing was sampled; do it all here instead of losing the frame
+	tree->parallel_sampled = false;
+
+	if (!tree->cache_valid) {
+		int track_count = tree->state.track_count;
+		AnimationPlayer *player = Object::cast_to<AnimationPlayer>(tree->get_node_or_null(tree->animation_player));
+		if (!player || !tree->_update_caches(player)) {
+			return;
+		}
+
+		if (tree->state.track_count != track_count) {
+			// the blends of this frame were sized for the old tracks, evaluate the graph again where it is now
+			tree->_process_graph(0);
+			return;
+		}
+	}
+
+	if (!tree->state.valid)
+		return;
+
+	tree->_process_graph_tracks(true, true);
+	tree->_process_graph_apply();
+}
+
 void AnimationTree::advance(float p_time) {
 
 	_process_graph(p_time);
@@ -1288,15 +1392,22 @@ void AnimationTree::advance(float p_time) {
 void AnimationTree::_notification(int p_what) {
 
 	if (active && p_what == NOTIFICATION_INTERNAL_PHYSICS_PROCESS && process_mode == ANIMATION_PROCESS_PHYSICS) {
-		_process_graph(get_physics_process_delta_time());
+		float delta = get_physics_process_delta_time();
+		if (update_lod.process(this, Engine::get_singleton()->get_physics_frames(), delta)) {
+			_process_graph_or_queue(delta);
+		}
 	}
 
 	if (active && p_what == NOTIFICATION_INTERNAL_PROCESS && process_mode == ANIMATION_PROCESS_IDLE) {
-		_process_graph(get_process_delta_time());
+		float delta = get_process_delta_time();
+		if (update_lod.process(this, Engine::get_singleton()->get_idle_frames(), delta)) {
+			_process_graph_or_queue(delta);
+		}
 	}
 
 	if (p_what == NOTIFICATION_EXIT_TREE) {
 		_clear_caches();
+		update_lod.spatial = NULL;
 		if (last_animation_player) {
 
 			Object *player = ObjectDB::get_instance(last_animation_player);
@@ -1305,6 +1416,7 @@ void AnimationTree::_notification(int p_what) {
 			}
 		}
 	} else if (p_what == NOTIFICATION_ENTER_TREE) {
+		update_lod.update_spatial(this);
 		if (last_animation_player) {
 
 			Object *player = ObjectDB::get_instance(last_animation_player);
@@ -1312,6 +1424,8 @@ void AnimationTree::_notification(int p_what) {
 				player->connect("caches_cleared", this, "_clear_caches");
 			}
 		}
+	} else if (p_what == NOTIFICATION_PARENTED) {
+		update_lod.update_spatial(this);
 	}
 }
 
@@ -1546,6 +1660,12 @@ void AnimationTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_process_mode", "mode"), &AnimationTree::set_process_mode);
 	ClassDB::bind_method(D_METHOD("get_process_mode"), &AnimationTree::get_process_mode);
 
+	ClassDB::bind_method(D_METHOD("set_update_lod_distance", "distance"), &AnimationTree::set_update_lod_distance);
+	ClassDB::bind_method(D_METHOD("get_update_lod_distance"), &AnimationTree::get_update_lod_distance);
+
+	ClassDB::bind_method(D_METHOD("set_update_lod_max_interval", "interval"), &AnimationTree::set_update_lod_max_interval);
+	ClassDB::bind_method(D_METHOD("get_update_lod_max_interval"), &AnimationTree::get_update_lod_max_interval);
+
 	ClassDB::bind_method(D_METHOD("set_animation_player", "root"), &AnimationTree::set_animation_player);
 	ClassDB::bind_method(D_METHOD("get_animation_player"), &AnimationTree::get_animation_player);
 
@@ -1568,6 +1688,9 @@ void AnimationTree::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "anim_player", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "AnimationPlayer"), "set_animation_player", "get_animation_player");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "active"), "set_active", "is_active");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_mode", PROPERTY_HINT_ENUM, "Physics,Idle,Manual"), "set_process_mode", "get_process_mode");
+	ADD_GROUP("Update LOD", "update_lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "update_lod_distance", PROPERTY_HINT_RANGE, "0,4096,0.1,or_greater"), "set_update_lod_distance", "get_update_lod_distance");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "update_lod_max_interval", PROPERTY_HINT_RANGE, "1,64,1"), "set_update_lod_max_interval", "get_update_lod_max_interval");
 	ADD_GROUP("Root Motion", "root_motion_");
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_motion_track"), "set_root_motion_track", "get_root_motion_track");
 
@@ -1584,6 +1707,7 @@ AnimationTree::AnimationTree() {
 	setup_pass = 1;
 	process_pass = 1;
 	started = true;
+	parallel_sampled = false;
 	properties_dirty = true;
 	last_animation_player = 0;
 }
@@ -262,6 +262,7 @@ private:
 
 	AnimationProcessMode process_mode;
 	bool active;
+	AnimationUpdateLOD update_lod;
 	NodePath animation_player;
 
 	AnimationNode::State state;
@@ -271,7 +272,17 @@ private:
 
 	void _clear_caches();
 	bool _update_caches(AnimationPlayer *player);
+	bool _process_graph_states(float p_delta);
+	void _process_graph_tracks(bool p_transforms, bool p_others);
+	void _process_graph_apply();
 	void _process_graph(float p_delta);
+	void _process_graph_or_queue(float p_delta);
+
+	// see SceneTree::queue_parallel_process(), only transform tracks are
+	// blended on the work pool
+	bool parallel_sampled;
+	static void _parallel_process(Node *p_node);
+	static void _parallel_process_finish(Node *p_node);
 
 	uint64_t setup_pass;
 	uint64_t process_pass;
@@ -319,6 +330,12 @@ public:
 	void set_process_mode(AnimationProcessMode p_mode);
 	AnimationProcessMode get_process_mode() const;
 
+	void set_update_lod_distance(float p_distance);
+	float get_update_lod_distance() const;
+
+	void set_update_lod_max_interval(int p_interval);
+	int get_update_lod_max_interval() const;
+
 	void set_animation_player(const NodePath &p_player);
 	NodePath get_animation_player() const;
 
@@ -430,25 +430,29 @@ Variant Tween::_run_equation(InterpolateData &p_data) {
 	Variant &delta_val = _get_delta_val(p_data);
 	Variant result;
 
+	// Every equation is linear in its start and change values, so the eased
+	// ratio is computed once and applied to each component.
+	real_t ratio = run_equation(p_data.trans_type, p_data.ease_type, p_data.elapsed - p_data.delay, 0, 1, p_data.duration);
+
 #define APPLY_EQUATION(element) \
-	r.element = _run_equation(p_data.trans_type, p_data.ease_type, p_data.elapsed - p_data.delay, i.element, d.element, p_data.duration);
+	r.element = i.element + d.element * ratio;
 
 	// What type of data are we interpolating?
 	switch (initial_val.get_type()) {
 
 		case Variant::BOOL:
 			// Run the boolean specific equation (checking if it is at least 0.5)
-			result = (_run_equation(p_data.trans_type, p_data.ease_type, p_data.elapsed - p_data.delay, initial_val, delta_val, p_data.duration)) >= 0.5;
+			result = ((real_t)initial_val + (real_t)delta_val * ratio) >= 0.5;
 			break;
 
 		case Variant::INT:
 			// Run the integer specific equation
-			result = (int)_run_equation(p_data.trans_type, p_data.ease_type, p_data.elapsed - p_data.delay, (int)initial_val, (int)delta_val, p_data.duration);
+			result = (int)((int)initial_val + (int)delta_val * ratio);
 			break;
 
 		case Variant::REAL:
 			// Run the REAL specific equation
-			result = _run_equation(p_data.trans_type, p_data.ease_type, p_data.elapsed - p_data.delay, (real_t)initial_val, (real_t)delta_val, p_data.duration);
+			result = (real_t)initial_val + (real_t)delta_val * ratio;
 			break;
 
 		case Variant::VECTOR2: {
@@ -621,6 +625,28 @@ bool Tween::_apply_tween_value(InterpolateData &p_data, Variant &value) {
 		case INTER_PROPERTY:
 		case FOLLOW_PROPERTY:
 		case TARGETING_PROPERTY: {
+			if (!p_data.setter_resolved) {
+				// Only plain properties can use the setter directly
+				p_data.setter_resolved = true;
+				if (p_data.key.size() != 1 || !ClassDB::get_property_setter_bind(object->get_class_name(), p_data.key[0], p_data.setter, p_data.setter_index)) {
+					p_data.setter = NULL;
+				}
+			}
+
+			// Scripts can override properties, so they still go through Object::set()
+			if (p_data.setter && !object->get_script_instance()) {
+				Variant::CallError error;
+				if (p_data.setter_index >= 0) {
+					Variant index = p_data.setter_index;
+					const Variant *args[2] = { &index, &value };
+					p_data.setter->call(object, args, 2, error);
+				} else {
+					const Variant *args[1] = { &value };
+					p_data.setter->call(object, args, 1, error);
+				}
+				return error.error == Variant::CallError::CALL_OK;
+			}
+
 			// Simply set the property on the object
 			bool valid = false;
 			object->set_indexed(p_data.key, value, &valid);
@@ -671,9 +697,9 @@ void Tween::_tween_process(float p_delta) {
 	if (repeat) {
 		// For each interpolation...
 		bool repeats_finished = true;
-		for (List<InterpolateData>::Element *E = interpolates.front(); E; E = E->next()) {
+		for (uint32_t i = 0; i < interpolates.size(); i++) {
 			// Get the data from it
-			InterpolateData &data = E->get();
+			InterpolateData &data = interpolates[i];
 
 			// Is not finished?
 			if (!data.finish) {
@@ -692,10 +718,10 @@ void Tween::_tween_process(float p_delta) {
 	bool all_finished = true;
 
 	// For each tween we wish to interpolate...
-	for (List<InterpolateData>::Element *E = interpolates.front(); E; E = E->next()) {
+	for (uint32_t i = 0; i < interpolates.size(); i++) {
 
 		// Get the data from it
-		InterpolateData &data = E->get();
+		InterpolateData &data = interpolates[i];
 
 		// Track if we hit one that isn't finished yet
 		all_finished = all_finished && data.finish;
@@ -717,7 +743,7 @@ void Tween::_tween_process(float p_delta) {
 		else if (prev_delaying) {
 			// We can apply the tween's value to the data and emit that the tween has started
 			_apply_tween_value(data, data.initial_val);
-			emit_signal("tween_started", object, NodePath(Vector<StringName>(), data.key, false));
+			emit_signal("tween_started", object, data.key_path);
 		}
 
 		// Are we at the end of the tween?
@@ -773,7 +799,7 @@ void Tween::_tween_process(float p_delta) {
 			_apply_tween_value(data, result);
 
 			// Emit that the tween has taken a step
-			emit_signal("tween_step", object, NodePath(Vector<StringName>(), data.key, false), data.elapsed, result);
+			emit_signal("tween_step", object, data.key_path, data.elapsed, result);
 		}
 
 		// Is the tween now finished?
@@ -784,7 +810,7 @@ void Tween::_tween_process(float p_delta) {
 
 			// Mark the tween as completed and emit the signal
 			data.elapsed = 0;
-			emit_signal("tween_completed", object, NodePath(Vector<StringName>(), data.key, false));
+			emit_signal("tween_completed", object, data.key_path);
 
 			// If we are not repeating the tween, remove it
 			if (!repeat)
@@ -863,9 +889,9 @@ bool Tween::start() {
 bool Tween::reset(Object *p_object, StringName p_key) {
 	// Find all interpolations that use the same object and target string
 	pending_update++;
-	for (List<InterpolateData>::Element *E = interpolates.front(); E; E = E->next()) {
+	for (uint32_t i = 0; i < interpolates.size(); i++) {
 		// Get the target object
-		InterpolateData &data = E->get();
+		InterpolateData &data = interpolates[i];
 		Object *object = ObjectDB::get_instance(data.id);
 		if (object == NULL)
 			continue;
@@ -888,9 +914,9 @@ bool Tween::reset(Object *p_object, StringName p_key) {
 bool Tween::reset_all() {
 	// Go through all interpolations
 	pending_update++;
-	for (List<InterpolateData>::Element *E = interpolates.front(); E; E = E->next()) {
+	for (uint32_t i = 0; i < interpolates.size(); i++) {
 		// Get the target data and set it back to the initial state
-		InterpolateData &data = E->get();
+		InterpolateData &data = interpolates[i];
 		data.elapsed = 0;
 		data.finish = false;
 
@@ -905,10 +931,10 @@ bool Tween::reset_all() {
 bool Tween::stop(Object *p_object, StringName p_key) {
 	// Find the tween that has the given target object and string key
 	pending_update++;
-	for (List<InterpolateData>::Element *E = interpolates.front(); E; E = E->next()) {
+	for (uint32_t i = 0; i < interpolates.size(); i++) {
 
 		// Get the object the tween is targeting
-		InterpolateData &data = E->get();
+		InterpolateData &data = interpolates[i];
 		Object *object = ObjectDB::get_instance(data.id);
 		if (object == NULL)
 			continue;
@@ -928,9 +954,9 @@ bool Tween::stop_all() {
 
 	// For each interpolation...
 	pending_update++;
-	for (List<InterpolateData>::Element *E = interpolates.front(); E; E = E->next()) {
+	for (uint32_t i = 0; i < interpolates.size(); i++) {
 		// Simply set it inactive
-		InterpolateData &data = E->get();
+		InterpolateData &data = interpolates[i];
 		data.active = false;
 	}
 	pending_update--;
@@ -944,9 +970,9 @@ bool Tween::resume(Object *p_object, StringName p_key) {
 
 	// Find the tween that uses the given target object and string key
 	pending_update++;
-	for (List<InterpolateData>::Element *E = interpolates.front(); E; E = E->next()) {
+	for (uint32_t i = 0; i < interpolates.size(); i++) {
 		// Grab the object
-		InterpolateData &data = E->get();
+		InterpolateData &data = interpolates[i];
 		Object *object = ObjectDB::get_instance(data.id);
 		if (object == NULL)
 			continue;
@@ -966,9 +992,9 @@ bool Tween::resume_all() {
 
 	// For each interpolation...
 	pending_update++;
-	for (List<InterpolateData>::Element *E = interpolates.front(); E; E = E->next()) {
+	for (uint32_t i = 0; i < interpolates.size(); i++) {
 		// Simply grab it and set it to active
-		InterpolateData &data = E->get();
+		InterpolateData &data = interpolates[i];
 		data.active = true;
 	}
 	pending_update--;
@@ -983,24 +1009,24 @@ bool Tween::remove(Object *p_object, StringName p_key) {
 	}
 
 	// For each interpolation...
-	List<List<InterpolateData>::Element *> for_removal;
-	for (List<InterpolateData>::Element *E = interpolates.front(); E; E = E->next()) {
+	List<uint32_t> for_removal;
+	for (uint32_t i = 0; i < interpolates.size(); i++) {
 		// Get the target object
-		InterpolateData &data = E->get();
+		InterpolateData &data = interpolates[i];
 		Object *object = ObjectDB::get_instance(data.id);
 		if (object == NULL)
 			continue;
 
 		// If the target object and string key match, queue it for removal
 		if (object == p_object && (data.concatenated_key == p_key || p_key == "")) {
-			for_removal.push_back(E);
+			for_removal.push_front(i);
 		}
 	}
 
-	// For each interpolation we wish to remove...
-	for (List<List<InterpolateData>::Element *>::Element *E = for_removal.front(); E; E = E->next()) {
+	// For each interpolation we wish to remove, last first so the indices stay valid...
+	for (List<uint32_t>::Element *E = for_removal.front(); E; E = E->next()) {
 		// Erase it
-		interpolates.erase(E->get());
+		interpolates.remove(E->get());
 	}
 	return true;
 }
@@ -1013,10 +1039,10 @@ void Tween::_remove_by_uid(int uid) {
 	}
 
 	// Find the interpolation that matches the given UID
-	for (List<InterpolateData>::Element *E = interpolates.front(); E; E = E->next()) {
-		if (uid == E->get().uid) {
+	for (uint32_t i = 0; i < interpolates.size(); i++) {
+		if (uid == interpolates[i].uid) {
 			// It matches, erase it and stop looking
-			E->erase();
+			interpolates.remove(i);
 			break;
 		}
 	}
@@ -1027,6 +1053,7 @@ void Tween::_push_interpolate_data(InterpolateData &p_data) {
 
 	// Add the new interpolation
 	p_data.uid = ++uid;
+	p_data.key_path = NodePath(Vector<StringName>(), p_data.key, false);
 	interpolates.push_back(p_data);
 
 	pending_update--;
@@ -1051,9 +1078,9 @@ bool Tween::remove_all() {
 bool Tween::seek(real_t p_time) {
 	// Go through each interpolation...
 	pending_update++;
-	for (List<InterpolateData>::Element *E = interpolates.front(); E; E = E->next()) {
+	for (uint32_t i = 0; i < interpolates.size(); i++) {
 		// Get the target data
-		InterpolateData &data = E->get();
+		InterpolateData &data = interpolates[i];
 
 		// Update the elapsed data to be set to the target time
 		data.elapsed = p_time;
@@ -1091,9 +1118,9 @@ real_t Tween::tell() const {
 	real_t pos = 0;
 
 	// For each interpolation...
-	for (const List<InterpolateData>::Element *E = interpolates.front(); E; E = E->next()) {
+	for (uint32_t i = 0; i < interpolates.size(); i++) {
 		// Get the data and figure out if it's position is further along than the previous ones
-		const InterpolateData &data = E->get();
+		const InterpolateData &data = interpolates[i];
 		if (data.elapsed > pos)
 			// Save it if so
 			pos = data.elapsed;
@@ -1112,9 +1139,9 @@ real_t Tween::get_runtime() const {
 
 	// For each interpolation...
 	real_t runtime = 0;
-	for (const List<InterpolateData>::Element *E = interpolates.front(); E; E = E->next()) {
+	for (uint32_t i = 0; i < interpolates.size(); i++) {
 		// Get the tween data and see if it's runtime is greater than the previous tweens
-		const InterpolateData &data = E->get();
+		const InterpolateData &data = interpolates[i];
 		real_t t = data.delay + data.duration;
 		if (t > runtime)
 			// This is the longest running tween
@@ -31,6 +31,7 @@
 #ifndef TWEEN_H
 #define TWEEN_H
 
+#include "core/local_vector.h"
 #include "scene/main/node.h"
 
 class Tween : public Node {
@@ -89,6 +90,7 @@ private:
 		ObjectID id;
 		Vector<StringName> key;
 		StringName concatenated_key;
+		NodePath key_path; // key as passed to the signals
 		Variant initial_val;
 		Variant delta_val;
 		Variant final_val;
@@ -101,11 +103,21 @@ private:
 		int args;
 		Variant arg[5];
 		int uid;
+
+		// Setter of a plain property, resolved on the first update so it can
+		// be called without going through Object::set() every step.
+		bool setter_resolved;
+		MethodBind *setter;
+		int setter_index;
+
 		InterpolateData() {
 			active = false;
 			finish = false;
 			call_deferred = false;
 			uid = 0;
+			setter_resolved = false;
+			setter = NULL;
+			setter_index = -1;
 		}
 	};
 
@@ -116,7 +128,7 @@ private:
 	mutable int pending_update;
 	int uid;
 
-	List<InterpolateData> interpolates;
+	LocalVector<InterpolateData> interpolates;
 
 	struct PendingCommand {
 		StringName key;
@@ -131,7 +143,6 @@ private:
 	typedef real_t (*interpolater)(real_t t, real_t b, real_t c, real_t d);
 	static interpolater interpolaters[TRANS_COUNT][EASE_COUNT];
 
-	real_t _run_equation(TransitionType p_trans_type, EaseType p_ease_type, real_t t, real_t b, real_t c, real_t d);
 	Variant &_get_delta_val(InterpolateData &p_data);
 	Variant _get_initial_val(const InterpolateData &p_data) const;
 	Variant _get_final_val(const InterpolateData &p_data) const;
@@ -153,6 +164,8 @@ protected:
 	static void _bind_methods();
 
 public:
+	static real_t run_equation(TransitionType p_trans_type, EaseType p_ease_type, real_t t, real_t b, real_t c, real_t d);
+
 	bool is_active() const;
 	void set_active(bool p_active);
 
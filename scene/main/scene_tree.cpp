@@ -185,6 +185,50 @@ void SceneTree::_flush_ugc() {
 	ugc_locked = false;
 }
 
+void SceneTree::queue_parallel_process(Node *p_node, void (*p_process)(Node *), void (*p_finish)(Node *)) {
+
+	ERR_FAIL_NULL(p_node);
+
+	ParallelProcess pp;
+	pp.id = p_node->get_instance_id();
+	pp.node = p_node;
+	pp.process = p_process;
+	pp.finish = p_finish;
+	parallel_processes.push_back(pp);
+}
+
+void SceneTree::_parallel_process(uint32_t p_index, void *p_userdata) {
+
+	const ParallelProcess &pp = parallel_processes[p_index];
+	if (pp.node) {
+		pp.process(pp.node);
+	}
+}
+
+void SceneTree::_flush_parallel_processes() {
+
+	if (parallel_processes.size() == 0)
+		return;
+
+	// skip nodes freed by something else processing after they were queued
+	for (uint32_t i = 0; i < parallel_processes.size(); i++) {
+		if (!ObjectDB::get_instance(parallel_processes[i].id)) {
+			parallel_processes[i].node = NULL;
+		}
+	}
+
+	get_work_pool().do_work(parallel_processes.size(), this, &SceneTree::_parallel_process, (void *)NULL);
+
+	for (uint32_t i = 0; i < parallel_processes.size(); i++) {
+		const ParallelProcess &pp = parallel_processes[i];
+		if (pp.node && ObjectDB::get_instance(pp.id)) {
+			pp.finish(pp.node);
+		}
+	}
+
+	parallel_processes.clear();
+}
+
 void SceneTree::_update_group_order(Group &g, bool p_use_priority) {
 
 	if (!g.changed)
@@ -480,6 +524,7 @@ bool SceneTree::iteration(float p_time) {
 	emit_signal("physics_frame");
 
 	_notify_group_pause("physics_process_internal", Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
+	_flush_parallel_processes();
 	if (GLOBAL_GET("physics/common/enable_pause_aware_picking")) {
 		call_group_flags(GROUP_CALL_REALTIME, "_viewports", "_process_picking", true);
 	}
@@ -527,6 +572,7 @@ bool SceneTree::idle(float p_time) {
 	flush_transform_notifications();
 
 	_notify_group_pause("idle_process_internal", Node::NOTIFICATION_INTERNAL_PROCESS);
+	_flush_parallel_processes();
 	_notify_group_pause("idle_process", Node::NOTIFICATION_PROCESS);
 
 	Size2 win_size = Size2(OS::get_singleton()->get_window_size().width, OS::get_singleton()->get_window_size().height);
@@ -2152,6 +2198,20 @@ SceneTree::SceneTree() {
 
 	root->set_physics_object_picking(GLOBAL_DEF("physics/common/enable_object_picking", true));
 
+	int worker_threads = GLOBAL_DEF_RST("threading/worker_pool/max_threads", -1);
+	ProjectSettings::get_singleton()->set_custom_property_info("threading/worker_pool/max_threads", PropertyInfo(Variant::INT, "threading/worker_pool/max_threads", PROPERTY_HINT_RANGE, "-1,64,1,or_greater"));
+	if (worker_threads < 0) {
+		// the editor and the project manager only get threads when asked for
+		worker_threads = Engine::get_singleton()->is_editor_hint() ? 0 : OS::get_singleton()->get_processor_count() - 1;
+	}
+#ifdef NO_THREADS
+	worker_threads = 0;
+#endif
+	work_pool_threads = MAX(worker_threads, 0);
+	work_pool_initialized = false; //started on first use, see get_work_pool()
+	parallel_animation = GLOBAL_DEF("threading/worker_pool/use_for_animation", false) && work_pool_threads > 0 && !Engine::get_singleton()->is_editor_hint();
+	parallel_particles = GLOBAL_DEF("threading/worker_pool/use_for_particles", false) && work_pool_threads > 0 && !Engine::get_singleton()->is_editor_hint();
+
 #ifdef TOOLS_ENABLED
 	edited_scene_root = NULL;
 #endif
@@ -2170,5 +2230,7 @@ SceneTree::~SceneTree() {
 		memdelete(root);
 	}
 
+	work_pool.finish();
+
 	if (singleton == this) singleton = NULL;
 }
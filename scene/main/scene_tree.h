@@ -32,7 +32,9 @@
 #define SCENE_MAIN_LOOP_H
 
 #include "core/io/multiplayer_api.h"
+#include "core/local_vector.h"
 #include "core/os/main_loop.h"
+#include "core/os/thread_work_pool.h"
 #include "core/os/thread_safe.h"
 #include "core/self_list.h"
 #include "scene/resources/mesh.h"
@@ -128,12 +130,29 @@ private:
 
 	bool use_font_oversampling;
 	int64_t current_frame;
+	ThreadWorkPool work_pool;
+	int work_pool_threads;
+	bool work_pool_initialized;
+	bool parallel_animation;
+	bool parallel_particles;
 	int64_t current_event;
 	int node_count;
 
 #ifdef TOOLS_ENABLED
 	Node *edited_scene_root;
 #endif
+	struct ParallelProcess {
+		ObjectID id;
+		Node *node;
+		void (*process)(Node *);
+		void (*finish)(Node *);
+	};
+
+	LocalVector<ParallelProcess> parallel_processes;
+
+	void _parallel_process(uint32_t p_index, void *p_userdata);
+	void _flush_parallel_processes();
+
 	struct UGCall {
 
 		StringName group;
@@ -389,6 +408,23 @@ public:
 
 	static SceneTree *get_singleton() { return singleton; }
 
+	// Shared worker threads for splitting per-frame node work, main thread only.
+	// The threads are started the first time the pool is asked for.
+	ThreadWorkPool &get_work_pool() {
+		if (!work_pool_initialized) {
+			work_pool_initialized = true;
+			work_pool.init(work_pool_threads);
+		}
+		return work_pool;
+	}
+
+	// Nodes queue this from their internal process notification. Once every
+	// node got the notification, p_process runs for all queued nodes on the work
+	// pool, then p_finish runs for each of them on the main thread in queue order.
+	void queue_parallel_process(Node *p_node, void (*p_process)(Node *), void (*p_finish)(Node *));
+	bool is_parallel_animation_enabled() const { return parallel_animation; }
+	bool is_parallel_particles_enabled() const { return parallel_particles; }
+
 	void drop_files(const Vector<String> &p_files, int p_from_screen = 0);
 	void global_menu_action(const Variant &p_id, const Variant &p_meta);
 	void get_argument_options(const StringName &p_function, int p_idx, List<String> *r_options) const;
@@ -95,7 +95,8 @@ public:
 		UPDATE_DISABLED,
 		UPDATE_ONCE, //then goes to disabled
 		UPDATE_WHEN_VISIBLE, // default
-		UPDATE_ALWAYS
+		UPDATE_ALWAYS,
+		UPDATE_WHEN_DIRTY,
 	};
 
 	enum ShadowAtlasQuadrantSubdiv {
@@ -135,6 +136,7 @@ public:
 		RENDER_INFO_DRAW_CALLS_IN_FRAME,
 		RENDER_INFO_2D_ITEMS_IN_FRAME,
 		RENDER_INFO_2D_DRAW_CALLS_IN_FRAME,
+		RENDER_INFO_2D_ITEMS_SKIPPED_IN_FRAME,
 		RENDER_INFO_MAX
 	};
 
@@ -477,6 +477,9 @@ void register_scene_types() {
 
 	AcceptDialog::set_swap_ok_cancel(GLOBAL_DEF("gui/common/swap_ok_cancel", bool(OS::get_singleton()->get_swap_ok_cancel())));
 
+	StreamTexture::set_default_stream_size_limit(GLOBAL_DEF("rendering/quality/texture_streaming/default_size_limit", 0));
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/texture_streaming/default_size_limit", PropertyInfo(Variant::INT, "rendering/quality/texture_streaming/default_size_limit", PROPERTY_HINT_RANGE, "0,16384,1"));
+
 	ClassDB::register_class<Shader>();
 	ClassDB::register_class<VisualShader>();
 	ClassDB::register_virtual_class<VisualShaderNode>();
@@ -31,6 +31,7 @@
 #include "animation.h"
 #include "scene/scene_string_names.h"
 
+#include "core/io/marshalls.h"
 #include "core/math/geometry.h"
 
 #define ANIM_MIN_LENGTH 0.001
@@ -86,7 +87,70 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 			track_set_imported(track, p_value);
 		else if (what == "enabled")
 			track_set_enabled(track, p_value);
-		else if (what == "keys" || what == "key_values") {
+		else if (what == "compressed") {
+
+			ERR_FAIL_COND_V(track_get_type(track) != TYPE_TRANSFORM, false);
+			TransformTrack *tt = static_cast<TransformTrack *>(tracks[track]);
+
+			Dictionary d = p_value;
+			ERR_FAIL_COND_V(!d.has("keys") || !d.has("pages") || !d.has("data") || !d.has("constant") || !d.has("constant_parts"), false);
+
+			CompressedTransforms packed;
+			int constant_parts = d["constant_parts"];
+			packed.loc_constant = constant_parts & 1;
+			packed.rot_constant = constant_parts & 2;
+			packed.scale_constant = constant_parts & 4;
+			packed.stride = (packed.loc_constant ? 0 : 3) + (packed.rot_constant ? 0 : 3) + (packed.scale_constant ? 0 : 3);
+
+			PoolVector<float> keys = d["keys"];
+			ERR_FAIL_COND_V(keys.size() % 2, false);
+			packed.keys.resize(keys.size() / 2);
+			{
+				PoolVector<float>::Read r = keys.read();
+				for (int i = 0; i < packed.keys.size(); i++) {
+					packed.keys.write[i].time = r[i * 2 + 0];
+					packed.keys.write[i].transition = r[i * 2 + 1];
+				}
+			}
+
+			PoolVector<float> pages = d["pages"];
+			ERR_FAIL_COND_V(pages.size() != (packed.keys.size() + CompressedTransforms::KEYS_PER_PAGE - 1) / CompressedTransforms::KEYS_PER_PAGE * 12, false);
+			packed.pages.resize(pages.size() / 12);
+			{
+				PoolVector<float>::Read r = pages.read();
+				for (int i = 0; i < packed.pages.size(); i++) {
+					const float *ofs = &r[i * 12];
+					CompressedTransforms::Page &page = packed.pages.write[i];
+					page.loc_min = Vector3(ofs[0], ofs[1], ofs[2]);
+					page.loc_step = Vector3(ofs[3], ofs[4], ofs[5]);
+					page.scale_min = Vector3(ofs[6], ofs[7], ofs[8]);
+					page.scale_step = Vector3(ofs[9], ofs[10], ofs[11]);
+				}
+			}
+
+			PoolVector<uint8_t> data = d["data"];
+			ERR_FAIL_COND_V(data.size() != packed.keys.size() * packed.stride * 2, false);
+			packed.data.resize(data.size() / 2);
+			{
+				PoolVector<uint8_t>::Read r = data.read();
+				for (int i = 0; i < packed.data.size(); i++) {
+					packed.data.write[i] = decode_uint16(&r[i * 2]);
+				}
+			}
+
+			PoolVector<float> constant = d["constant"];
+			ERR_FAIL_COND_V(constant.size() != 10, false);
+			{
+				PoolVector<float>::Read r = constant.read();
+				packed.constant.loc = Vector3(r[0], r[1], r[2]);
+				packed.constant.rot = Quat(r[3], r[4], r[5], r[6]);
+				packed.constant.scale = Vector3(r[7], r[8], r[9]);
+			}
+
+			tt->transforms.clear();
+			tt->packed = packed;
+			tt->compressed = true;
+		} else if (what == "keys" || what == "key_values") {
 
 			if (track_get_type(track) == TYPE_TRANSFORM) {
 
@@ -120,6 +184,9 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 					tk.value.scale.z = ofs[11];
 				}
 
+				tt->compressed = false;
+				tt->packed = CompressedTransforms();
+
 			} else if (track_get_type(track) == TYPE_VALUE) {
 
 				ValueTrack *vt = static_cast<ValueTrack *>(tracks[track]);
@@ -369,7 +436,73 @@ bool Animation::_get(const StringName &p_name, Variant &r_ret) const {
 			r_ret = track_is_imported(track);
 		else if (what == "enabled")
 			r_ret = track_is_enabled(track);
-		else if (what == "keys") {
+		else if (what == "compressed") {
+
+			ERR_FAIL_COND_V(track_get_type(track) != TYPE_TRANSFORM, false);
+			const TransformTrack *tt = static_cast<const TransformTrack *>(tracks[track]);
+			ERR_FAIL_COND_V(!tt->compressed, false);
+			const CompressedTransforms &packed = tt->packed;
+
+			PoolVector<float> keys;
+			keys.resize(packed.keys.size() * 2);
+			{
+				PoolVector<float>::Write w = keys.write();
+				for (int i = 0; i < packed.keys.size(); i++) {
+					w[i * 2 + 0] = packed.keys[i].time;
+					w[i * 2 + 1] = packed.keys[i].transition;
+				}
+			}
+
+			PoolVector<float> pages;
+			pages.resize(packed.pages.size() * 12);
+			{
+				PoolVector<float>::Write w = pages.write();
+				for (int i = 0; i < packed.pages.size(); i++) {
+					const CompressedTransforms::Page &page = packed.pages[i];
+					const Vector3 values[4] = { page.loc_min, page.loc_step, page.scale_min, page.scale_step };
+					for (int j = 0; j < 4; j++) {
+						w[i * 12 + j * 3 + 0] = values[j].x;
+						w[i * 12 + j * 3 + 1] = values[j].y;
+						w[i * 12 + j * 3 + 2] = values[j].z;
+					}
+				}
+			}
+
+			PoolVector<uint8_t> data;
+			data.resize(packed.data.size() * 2);
+			{
+				PoolVector<uint8_t>::Write w = data.write();
+				for (int i = 0; i < packed.data.size(); i++) {
+					encode_uint16(packed.data[i], &w[i * 2]);
+				}
+			}
+
+			PoolVector<float> constant;
+			constant.resize(10);
+			{
+				PoolVector<float>::Write w = constant.write();
+				const TransformKey &c = packed.constant;
+				w[0] = c.loc.x;
+				w[1] = c.loc.y;
+				w[2] = c.loc.z;
+				w[3] = c.rot.x;
+				w[4] = c.rot.y;
+				w[5] = c.rot.z;
+				w[6] = c.rot.w;
+				w[7] = c.scale.x;
+				w[8] = c.scale.y;
+				w[9] = c.scale.z;
+			}
+
+			Dictionary d;
+			d["keys"] = keys;
+			d["pages"] = pages;
+			d["data"] = data;
+			d["constant"] = constant;
+			d["constant_parts"] = (packed.loc_constant ? 1 : 0) | (packed.rot_constant ? 2 : 0) | (packed.scale_constant ? 4 : 0);
+			r_ret = d;
+			return true;
+		} else if (what == "keys") {
 
 			if (track_get_type(track) == TYPE_TRANSFORM) {
 
@@ -622,7 +755,11 @@ void Animation::_get_property_list(List<PropertyInfo> *p_list) const {
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/loop_wrap", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/imported", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/enabled", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
-		p_list->push_back(PropertyInfo(Variant::ARRAY, "tracks/" + itos(i) + "/keys", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		if (tracks[i]->type == TYPE_TRANSFORM && static_cast<const TransformTrack *>(tracks[i])->compressed) {
+			p_list->push_back(PropertyInfo(Variant::DICTIONARY, "tracks/" + itos(i) + "/compressed", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		} else {
+			p_list->push_back(PropertyInfo(Variant::ARRAY, "tracks/" + itos(i) + "/keys", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		}
 	}
 }
 
@@ -684,6 +821,8 @@ void Animation::remove_track(int p_track) {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
 			_clear(tt->transforms);
+			_clear(tt->packed.keys);
+			_clear(tt->packed.data);
 
 		} break;
 		case TYPE_VALUE: {
@@ -852,6 +991,19 @@ Error Animation::transform_track_get_key(int p_track, int p_key, Vector3 *r_loc,
 
 	TransformTrack *tt = static_cast<TransformTrack *>(t);
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, ERR_INVALID_PARAMETER);
+
+	if (tt->compressed) {
+		ERR_FAIL_INDEX_V(p_key, tt->packed.keys.size(), ERR_INVALID_PARAMETER);
+		TransformKey tk = _transform_track_get_compressed_key(tt->packed, p_key);
+		if (r_loc)
+			*r_loc = tk.loc;
+		if (r_rot)
+			*r_rot = tk.rot;
+		if (r_scale)
+			*r_scale = tk.scale;
+		return OK;
+	}
+
 	ERR_FAIL_INDEX_V(p_key, tt->transforms.size(), ERR_INVALID_PARAMETER);
 
 	if (r_loc)
@@ -871,6 +1023,7 @@ int Animation::transform_track_insert_key(int p_track, float p_time, const Vecto
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, -1);
 
 	TransformTrack *tt = static_cast<TransformTrack *>(t);
+	_transform_track_decompress(tt);
 
 	TKey<TransformKey> tkey;
 	tkey.time = p_time;
@@ -899,6 +1052,7 @@ void Animation::track_remove_key(int p_track, int p_idx) {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_idx, tt->transforms.size());
 			tt->transforms.remove(p_idx);
 
@@ -952,6 +1106,14 @@ int Animation::track_find_key(int p_track, float p_time, bool p_exact) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				int k = _find(tt->packed.keys, p_time);
+				if (k < 0 || k >= tt->packed.keys.size())
+					return -1;
+				if (tt->packed.keys[k].time != p_time && p_exact)
+					return -1;
+				return k;
+			}
 			int k = _find(tt->transforms, p_time);
 			if (k < 0 || k >= tt->transforms.size())
 				return -1;
@@ -1137,7 +1299,7 @@ int Animation::track_get_key_count(int p_track) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
-			return tt->transforms.size();
+			return tt->compressed ? tt->packed.keys.size() : tt->transforms.size();
 		} break;
 		case TYPE_VALUE: {
 
@@ -1179,13 +1341,15 @@ Variant Animation::track_get_key_value(int p_track, int p_key_idx) const {
 
 		case TYPE_TRANSFORM: {
 
-			TransformTrack *tt = static_cast<TransformTrack *>(t);
-			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), Variant());
+			Vector3 loc;
+			Quat rot;
+			Vector3 scale;
+			ERR_FAIL_COND_V(transform_track_get_key(p_track, p_key_idx, &loc, &rot, &scale) != OK, Variant());
 
 			Dictionary d;
-			d["location"] = tt->transforms[p_key_idx].value.loc;
-			d["rotation"] = tt->transforms[p_key_idx].value.rot;
-			d["scale"] = tt->transforms[p_key_idx].value.scale;
+			d["location"] = loc;
+			d["rotation"] = rot;
+			d["scale"] = scale;
 
 			return d;
 		} break;
@@ -1256,6 +1420,10 @@ float Animation::track_get_key_time(int p_track, int p_key_idx) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->packed.keys.size(), -1);
+				return tt->packed.keys[p_key_idx].time;
+			}
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
 			return tt->transforms[p_key_idx].time;
 		} break;
@@ -1309,6 +1477,7 @@ void Animation::track_set_key_time(int p_track, int p_key_idx, float p_time) {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 			TKey<TransformKey> key = tt->transforms[p_key_idx];
 			key.time = p_time;
@@ -1381,6 +1550,10 @@ float Animation::track_get_key_transition(int p_track, int p_key_idx) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->packed.keys.size(), -1);
+				return tt->packed.keys[p_key_idx].transition;
+			}
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
 			return tt->transforms[p_key_idx].transition;
 		} break;
@@ -1425,6 +1598,7 @@ void Animation::track_set_key_value(int p_track, int p_key_idx, const Variant &p
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 
 			Dictionary d = p_value;
@@ -1511,6 +1685,7 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_tra
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 			tt->transforms.write[p_key_idx].transition = p_transition;
 		} break;
@@ -1539,37 +1714,61 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_tra
 }
 
 template <class K>
-int Animation::_find(const Vector<K> &p_keys, float p_time) const {
+static _FORCE_INLINE_ bool _key_reached(const K *p_keys, int p_idx, float p_time) {
+
+	return p_keys[p_idx].time < p_time || Math::is_equal_approx(p_time, p_keys[p_idx].time);
+}
+
+template <class K>
+int Animation::_find(const Vector<K> &p_keys, float p_time, int *p_cursor) const {
 
 	int len = p_keys.size();
 	if (len == 0)
 		return -2;
 
-	int low = 0;
-	int high = len - 1;
+	const K *keys = &p_keys[0];
+
+	if (p_cursor) {
+		// sequential playback stays on the last key found or moves to the next one,
+		// so check those first and only search on seeks
+		int cursor = *p_cursor;
+		for (int i = MAX(cursor, -1); i <= cursor + 1 && i < len; i++) {
+
+			if ((i < 0 || _key_reached(keys, i, p_time)) && (i + 1 >= len || !_key_reached(keys, i + 1, p_time))) {
+				*p_cursor = i;
+				return i;
+			}
+		}
+	}
+
 	int middle = 0;
 
-#ifdef DEBUG_ENABLED
-	if (low > high)
-		ERR_PRINT("low > high, this may be a bug");
-#endif
+	if (_key_reached(keys, len - 1, p_time)) {
+		// past the last key, common when holding the end of an animation
+		middle = len - 1;
+	} else {
 
-	const K *keys = &p_keys[0];
+		int low = 0;
+		int high = len - 1;
 
-	while (low <= high) {
+		while (low <= high) {
 
-		middle = (low + high) / 2;
+			middle = (low + high) / 2;
+
+			if (Math::is_equal_approx(p_time, keys[middle].time)) { //match
+				break;
+			} else if (p_time < keys[middle].time)
+				high = middle - 1; //search low end of array
+			else
+				low = middle + 1; //search high end of array
+		}
 
-		if (Math::is_equal_approx(p_time, keys[middle].time)) { //match
-			return middle;
-		} else if (p_time < keys[middle].time)
-			high = middle - 1; //search low end of array
-		else
-			low = middle + 1; //search high end of array
+		if (keys[middle].time > p_time && !Math::is_equal_approx(p_time, keys[middle].time))
+			middle--;
 	}
 
-	if (keys[middle].time > p_time)
-		middle--;
+	if (p_cursor)
+		*p_cursor = middle;
 
 	return middle;
 }
@@ -1720,27 +1919,26 @@ float Animation::_cubic_interpolate(const float &p_pre_a, const float &p_a, cons
 	return _interpolate(p_a, p_b, p_c);
 }
 
-template <class T>
-T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const {
+template <class K>
+bool Animation::_find_interpolation_keys(const Vector<K> &p_keys, float p_time, bool p_loop_wrap, int &r_idx, int &r_next, int &r_len, float &r_c, int *p_cursor) const {
 
 	int len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+	r_len = len;
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
 		// meaning no keys, or only key time is larger than length
-		if (p_ok)
-			*p_ok = false;
-		return T();
+		return false;
 	} else if (len == 1) { // one key found (0+1), return it
 
-		if (p_ok)
-			*p_ok = true;
-		return p_keys[0].value;
+		r_idx = r_next = 0;
+		r_c = 0;
+		return true;
 	}
 
-	int idx = _find(p_keys, p_time);
+	int idx = _find(p_keys, p_time, p_cursor);
 
-	ERR_FAIL_COND_V(idx == -2, T());
+	ERR_FAIL_COND_V(idx == -2, false);
 
 	bool result = true;
 	int next = 0;
@@ -1820,6 +2018,21 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
 		}
 	}
 
+	r_idx = idx;
+	r_next = next;
+	r_c = c;
+	return result;
+}
+
+template <class T>
+T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *p_cursor) const {
+
+	int idx = 0;
+	int next = 0;
+	int len = 0;
+	float c = 0;
+	bool result = _find_interpolation_keys(p_keys, p_time, p_loop_wrap, idx, next, len, c, p_cursor);
+
 	if (p_ok)
 		*p_ok = result;
 	if (!result)
@@ -1864,7 +2077,7 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
 	// do a barrel roll
 }
 
-Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const {
+Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *p_cursor) const {
 
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
@@ -1872,12 +2085,47 @@ Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3
 
 	TransformTrack *tt = static_cast<TransformTrack *>(t);
 
-	bool ok = false;
+	TransformKey tk;
 
-	TransformKey tk = _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok);
+	if (tt->compressed) {
+		// same as _interpolate(), but only the keys used get decoded
+		const CompressedTransforms &packed = tt->packed;
+		int idx = 0;
+		int next = 0;
+		int len = 0;
+		float c = 0;
+		if (!_find_interpolation_keys(packed.keys, p_time, tt->loop_wrap, idx, next, len, c, p_cursor))
+			return ERR_UNAVAILABLE;
 
-	if (!ok)
-		return ERR_UNAVAILABLE;
+		float tr = packed.keys[idx].transition;
+
+		if (tr == 0 || idx == next || tt->interpolation == INTERPOLATION_NEAREST) {
+			tk = _transform_track_get_compressed_key(packed, idx);
+		} else {
+
+			if (tr != 1.0) {
+				c = Math::ease(c, tr);
+			}
+
+			if (tt->interpolation == INTERPOLATION_CUBIC) {
+				int pre = MAX(idx - 1, 0);
+				int post = next + 1;
+				if (post >= len)
+					post = next;
+				tk = _cubic_interpolate(_transform_track_get_compressed_key(packed, pre), _transform_track_get_compressed_key(packed, idx), _transform_track_get_compressed_key(packed, next), _transform_track_get_compressed_key(packed, post), c);
+			} else {
+				tk = _interpolate(_transform_track_get_compressed_key(packed, idx), _transform_track_get_compressed_key(packed, next), c);
+			}
+		}
+	} else {
+
+		bool ok = false;
+
+		tk = _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok, p_cursor);
+
+		if (!ok)
+			return ERR_UNAVAILABLE;
+	}
 
 	if (r_loc)
 		*r_loc = tk.loc;
@@ -1891,7 +2139,7 @@ Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3
 	return OK;
 }
 
-Variant Animation::value_track_interpolate(int p_track, float p_time) const {
+Variant Animation::value_track_interpolate(int p_track, float p_time, int *p_cursor) const {
 
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), 0);
 	Track *t = tracks[p_track];
@@ -1900,7 +2148,7 @@ Variant Animation::value_track_interpolate(int p_track, float p_time) const {
 
 	bool ok = false;
 
-	Variant res = _interpolate(vt->values, p_time, (vt->update_mode == UPDATE_CONTINUOUS || vt->update_mode == UPDATE_CAPTURE) ? vt->interpolation : INTERPOLATION_NEAREST, vt->loop_wrap, &ok);
+	Variant res = _interpolate(vt->values, p_time, (vt->update_mode == UPDATE_CONTINUOUS || vt->update_mode == UPDATE_CAPTURE) ? vt->interpolation : INTERPOLATION_NEAREST, vt->loop_wrap, &ok, p_cursor);
 
 	if (ok) {
 
@@ -2066,8 +2314,13 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
 				case TYPE_TRANSFORM: {
 
 					const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-					_track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
-					_track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+					if (tt->compressed) {
+						_track_get_key_indices_in_range(tt->packed.keys, from_time, length, p_indices);
+						_track_get_key_indices_in_range(tt->packed.keys, 0, to_time, p_indices);
+					} else {
+						_track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
+						_track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+					}
 
 				} break;
 				case TYPE_VALUE: {
@@ -2126,7 +2379,11 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
 		case TYPE_TRANSFORM: {
 
 			const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-			_track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
+			if (tt->compressed) {
+				_track_get_key_indices_in_range(tt->packed.keys, from_time, to_time, p_indices);
+			} else {
+				_track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
+			}
 
 		} break;
 		case TYPE_VALUE: {
@@ -2384,7 +2641,7 @@ static _FORCE_INLINE_ Vector2 _bezier_interp(real_t t, const Vector2 &start, con
 	return start * omt3 + control_1 * omt2 * t * 3.0 + control_2 * omt * t2 * 3.0 + end * t3;
 }
 
-float Animation::bezier_track_interpolate(int p_track, float p_time) const {
+float Animation::bezier_track_interpolate(int p_track, float p_time, int *p_cursor) const {
 	//this uses a different interpolation scheme
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), 0);
 	Track *track = tracks[p_track];
@@ -2401,7 +2658,7 @@ float Animation::bezier_track_interpolate(int p_track, float p_time) const {
 		return bt->values[0].value.value;
 	}
 
-	int idx = _find(bt->values, p_time);
+	int idx = _find(bt->values, p_time, p_cursor);
 
 	ERR_FAIL_COND_V(idx == -2, 0);
 
@@ -2784,11 +3041,13 @@ void Animation::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("track_get_interpolation_loop_wrap", "track_idx"), &Animation::track_get_interpolation_loop_wrap);
 
 	ClassDB::bind_method(D_METHOD("transform_track_interpolate", "track_idx", "time_sec"), &Animation::_transform_track_interpolate);
+	ClassDB::bind_method(D_METHOD("get_pose_track_map", "skeleton_path", "bone_names"), &Animation::_get_pose_track_map);
+	ClassDB::bind_method(D_METHOD("sample_pose", "time_sec", "track_map", "bone_count"), &Animation::_sample_pose);
 	ClassDB::bind_method(D_METHOD("value_track_set_update_mode", "track_idx", "mode"), &Animation::value_track_set_update_mode);
 	ClassDB::bind_method(D_METHOD("value_track_get_update_mode", "track_idx"), &Animation::value_track_get_update_mode);
 
 	ClassDB::bind_method(D_METHOD("value_track_get_key_indices", "track_idx", "time_sec", "delta"), &Animation::_value_track_get_key_indices);
-	ClassDB::bind_method(D_METHOD("value_track_interpolate", "track_idx", "time_sec"), &Animation::value_track_interpolate);
+	ClassDB::bind_method(D_METHOD("value_track_interpolate", "track_idx", "time_sec"), &Animation::_value_track_interpolate);
 
 	ClassDB::bind_method(D_METHOD("method_track_get_key_indices", "track_idx", "time_sec", "delta"), &Animation::_method_track_get_key_indices);
 	ClassDB::bind_method(D_METHOD("method_track_get_name", "track_idx", "key_idx"), &Animation::method_track_get_name);
@@ -2804,7 +3063,7 @@ void Animation::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("bezier_track_get_key_in_handle", "track_idx", "key_idx"), &Animation::bezier_track_get_key_in_handle);
 	ClassDB::bind_method(D_METHOD("bezier_track_get_key_out_handle", "track_idx", "key_idx"), &Animation::bezier_track_get_key_out_handle);
 
-	ClassDB::bind_method(D_METHOD("bezier_track_interpolate", "track_idx", "time"), &Animation::bezier_track_interpolate);
+	ClassDB::bind_method(D_METHOD("bezier_track_interpolate", "track_idx", "time"), &Animation::_bezier_track_interpolate);
 
 	ClassDB::bind_method(D_METHOD("audio_track_insert_key", "track_idx", "time", "stream", "start_offset", "end_offset"), &Animation::audio_track_insert_key, DEFVAL(0), DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("audio_track_set_key_stream", "track_idx", "key_idx", "stream"), &Animation::audio_track_set_key_stream);
@@ -2829,6 +3088,8 @@ void Animation::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("clear"), &Animation::clear);
 	ClassDB::bind_method(D_METHOD("copy_track", "track_idx", "to_animation"), &Animation::copy_track);
+	ClassDB::bind_method(D_METHOD("compress", "location_tolerance", "rotation_tolerance", "scale_tolerance"), &Animation::compress, DEFVAL(0.001), DEFVAL(0.001), DEFVAL(0.001));
+	ClassDB::bind_method(D_METHOD("track_is_compressed", "track_idx"), &Animation::track_is_compressed);
 
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "length", PROPERTY_HINT_RANGE, "0.001,99999,0.001"), "set_length", "get_length");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "loop"), "set_loop", "has_loop");
@@ -3081,11 +3342,373 @@ void Animation::optimize(float p_allowed_linear_err, float p_allowed_angular_err
 
 	for (int i = 0; i < tracks.size(); i++) {
 
-		if (tracks[i]->type == TYPE_TRANSFORM)
+		// compressed tracks were quantized from the optimized keys already
+		if (tracks[i]->type == TYPE_TRANSFORM && !static_cast<TransformTrack *>(tracks[i])->compressed)
 			_transform_track_optimize(i, p_allowed_linear_err, p_allowed_angular_err, p_max_optimizable_angle);
 	}
 }
 
+// Smallest three: the largest component is left out and rebuilt from the unit length.
+// 15 bits per stored component, the index and sign of the largest in the top bits.
+static void _encode_rotation(const Quat &p_rot, uint16_t *r_data) {
+
+	const real_t c[4] = { p_rot.x, p_rot.y, p_rot.z, p_rot.w };
+	int largest = 0;
+	for (int i = 1; i < 4; i++) {
+		if (Math::abs(c[i]) > Math::abs(c[largest])) {
+			largest = i;
+		}
+	}
+
+	int j = 0;
+	for (int i = 0; i < 4; i++) {
+		if (i == largest) {
+			continue;
+		}
+		real_t v = CLAMP(c[i] / Math_SQRT12, -1.0, 1.0) * 0.5 + 0.5;
+		r_data[j++] = uint16_t(Math::round(v * 32767.0));
+	}
+
+	r_data[0] |= (largest & 1) << 15;
+	r_data[1] |= (largest >> 1) << 15;
+	r_data[2] |= (c[largest] < 0 ? 1 : 0) << 15;
+}
+
+static Quat _decode_rotation(const uint16_t *p_data) {
+
+	int largest = (p_data[0] >> 15) | ((p_data[1] >> 15) << 1);
+
+	real_t c[4];
+	real_t sum = 0;
+	int j = 0;
+	for (int i = 0; i < 4; i++) {
+		if (i == largest) {
+			continue;
+		}
+		c[i] = ((p_data[j++] & 0x7FFF) / 32767.0 * 2.0 - 1.0) * Math_SQRT12;
+		sum += c[i] * c[i];
+	}
+	c[largest] = Math::sqrt(MAX(1.0 - sum, 0.0));
+	if (p_data[2] >> 15) {
+		c[largest] = -c[largest];
+	}
+
+	return Quat(c[0], c[1], c[2], c[3]).normalized();
+}
+
+static real_t _rotation_error(const Quat &p_a, const Quat &p_b) {
+
+	// angle of the rotation between them, from the chord as acos() is imprecise near 1
+	Quat diff = p_a.dot(p_b) < 0 ? p_a + p_b : p_a - p_b;
+	return 4.0 * Math::asin(MIN(diff.length() * 0.5, 1.0));
+}
+
+Animation::TransformKey Animation::_transform_track_get_compressed_key(const CompressedTransforms &p_packed, int p_key) const {
+
+	const CompressedTransforms::Page &page = p_packed.pages[p_key / CompressedTransforms::KEYS_PER_PAGE];
+	const uint16_t *data = p_packed.data.ptr() + p_key * p_packed.stride;
+
+	TransformKey tk;
+
+	if (p_packed.loc_constant) {
+		tk.loc = p_packed.constant.loc;
+	} else {
+		tk.loc = page.loc_min + page.loc_step * Vector3(data[0], data[1], data[2]);
+		data += 3;
+	}
+
+	if (p_packed.rot_constant) {
+		tk.rot = p_packed.constant.rot;
+	} else {
+		tk.rot = _decode_rotation(data);
+		data += 3;
+	}
+
+	if (p_packed.scale_constant) {
+		tk.scale = p_packed.constant.scale;
+	} else {
+		tk.scale = page.scale_min + page.scale_step * Vector3(data[0], data[1], data[2]);
+	}
+
+	return tk;
+}
+
+static void _quantize_vector(const Vector3 &p_value, const Vector3 &p_min, const Vector3 &p_step, uint16_t *r_data) {
+
+	for (int i = 0; i < 3; i++) {
+		r_data[i] = p_step[i] > 0 ? uint16_t(CLAMP(Math::round((p_value[i] - p_min[i]) / p_step[i]), 0.0, 65535.0)) : 0;
+	}
+}
+
+bool Animation::_transform_track_compress(TransformTrack *p_track, float p_location_tolerance, float p_rotation_tolerance, float p_scale_tolerance) {
+
+	const Vector<TKey<TransformKey> > &transforms = p_track->transforms;
+	int count = transforms.size();
+	if (count == 0) {
+		return false;
+	}
+
+	CompressedTransforms packed;
+	packed.constant = transforms[0].value;
+	packed.loc_constant = true;
+	packed.rot_constant = true;
+	packed.scale_constant = true;
+
+	for (int i = 0; i < count; i++) {
+		const TransformKey &tk = transforms[i].value;
+		if (!tk.rot.is_normalized()) {
+			return false; // can't be rebuilt from three components
+		}
+		packed.loc_constant = packed.loc_constant && tk.loc.distance_to(packed.constant.loc) <= p_location_tolerance;
+		packed.rot_constant = packed.rot_constant && _rotation_error(tk.rot, packed.constant.rot) <= p_rotation_tolerance;
+		packed.scale_constant = packed.scale_constant && tk.scale.distance_to(packed.constant.scale) <= p_scale_tolerance;
+	}
+
+	packed.stride = (packed.loc_constant ? 0 : 3) + (packed.rot_constant ? 0 : 3) + (packed.scale_constant ? 0 : 3);
+
+	packed.keys.resize(count);
+	for (int i = 0; i < count; i++) {
+		packed.keys.write[i].time = transforms[i].time;
+		packed.keys.write[i].transition = transforms[i].transition;
+	}
+
+	packed.pages.resize((count + CompressedTransforms::KEYS_PER_PAGE - 1) / CompressedTransforms::KEYS_PER_PAGE);
+	packed.data.resize(count * packed.stride);
+	uint16_t *data = packed.data.ptrw();
+
+	for (int p = 0; p < packed.pages.size(); p++) {
+
+		int from = p * CompressedTransforms::KEYS_PER_PAGE;
+		int to = MIN(from + CompressedTransforms::KEYS_PER_PAGE, count);
+
+		AABB loc_range(transforms[from].value.loc, Vector3());
+		AABB scale_range(transforms[from].value.scale, Vector3());
+		for (int i = from + 1; i < to; i++) {
+			loc_range.expand_to(transforms[i].value.loc);
+			scale_range.expand_to(transforms[i].value.scale);
+		}
+
+		CompressedTransforms::Page &page = packed.pages.write[p];
+		page.loc_min = loc_range.position;
+		page.loc_step = loc_range.size / 65535.0;
+		page.scale_min = scale_range.position;
+		page.scale_step = scale_range.size / 65535.0;
+
+		for (int i = from; i < to; i++) {
+			const TransformKey &tk = transforms[i].value;
+			if (!packed.loc_constant) {
+				_quantize_vector(tk.loc, page.loc_min, page.loc_step, data);
+				data += 3;
+			}
+			if (!packed.rot_constant) {
+				_encode_rotation(tk.rot, data);
+				data += 3;
+			}
+			if (!packed.scale_constant) {
+				_quantize_vector(tk.scale, page.scale_min, page.scale_step, data);
+				data += 3;
+			}
+		}
+	}
+
+	// very large ranges may not fit the tolerances in 16 bits, keep those tracks as they are
+	for (int i = 0; i < count; i++) {
+		const TransformKey &tk = transforms[i].value;
+		TransformKey decoded = _transform_track_get_compressed_key(packed, i);
+		if (decoded.loc.distance_to(tk.loc) > p_location_tolerance || _rotation_error(decoded.rot, tk.rot) > p_rotation_tolerance || decoded.scale.distance_to(tk.scale) > p_scale_tolerance) {
+			return false;
+		}
+	}
+
+	p_track->transforms.clear();
+	p_track->packed = packed;
+	p_track->compressed = true;
+	return true;
+}
+
+void Animation::_transform_track_decompress(TransformTrack *p_track) {
+
+	if (!p_track->compressed) {
+		return;
+	}
+
+	const CompressedTransforms &packed = p_track->packed;
+	p_track->transforms.resize(packed.keys.size());
+	for (int i = 0; i < packed.keys.size(); i++) {
+		TKey<TransformKey> &key = p_track->transforms.write[i];
+		key.time = packed.keys[i].time;
+		key.transition = packed.keys[i].transition;
+		key.value = _transform_track_get_compressed_key(packed, i);
+	}
+
+	p_track->packed = CompressedTransforms();
+	p_track->compressed = false;
+}
+
+void Animation::compress(float p_location_tolerance, float p_rotation_tolerance, float p_scale_tolerance) {
+
+	for (int i = 0; i < tracks.size(); i++) {
+
+		if (tracks[i]->type == TYPE_TRANSFORM && !static_cast<TransformTrack *>(tracks[i])->compressed)
+			_transform_track_compress(static_cast<TransformTrack *>(tracks[i]), p_location_tolerance, p_rotation_tolerance, p_scale_tolerance);
+	}
+	emit_changed();
+}
+
+bool Animation::track_is_compressed(int p_track) const {
+
+	ERR_FAIL_INDEX_V(p_track, tracks.size(), false);
+	return tracks[p_track]->type == TYPE_TRANSFORM && static_cast<const TransformTrack *>(tracks[p_track])->compressed;
+}
+
+Vector<int> Animation::get_pose_track_map(const NodePath &p_skeleton, const Vector<StringName> &p_bones) const {
+
+	Vector<int> map;
+	map.resize(tracks.size());
+
+	for (int i = 0; i < tracks.size(); i++) {
+
+		const NodePath &path = tracks[i]->path;
+		int bone = -1;
+
+		if (tracks[i]->type == TYPE_TRANSFORM && path.get_subname_count() == 1) {
+			if (p_skeleton.is_empty() || NodePath(path.get_names(), path.is_absolute()) == p_skeleton) {
+				bone = p_bones.find(path.get_subname(0));
+			}
+		}
+
+		map.write[i] = bone;
+	}
+
+	return map;
+}
+
+void Animation::sample_pose(float p_time, const Vector<int> &p_track_map, PoseBone *r_pose, int p_pose_size, float p_weight, int *r_cursors) const {
+
+	ERR_FAIL_COND(p_track_map.size() != tracks.size());
+
+	if (p_weight < CMP_EPSILON)
+		return;
+
+	// same time wrapping as AnimationNodeAnimation
+	if (loop) {
+		if (length) {
+			p_time = Math::fposmod(p_time, length);
+		}
+	} else {
+		p_time = CLAMP(p_time, 0, length);
+	}
+
+	for (int i = 0; i < tracks.size(); i++) {
+
+		int bone = p_track_map[i];
+		if (bone < 0 || !tracks[i]->enabled)
+			continue;
+
+		ERR_CONTINUE(bone >= p_pose_size);
+
+		Vector3 loc;
+		Quat rot;
+		Vector3 scale;
+
+		Error err = transform_track_interpolate(i, p_time, &loc, &rot, &scale, r_cursors ? &r_cursors[i] : NULL);
+		if (err != OK)
+			continue;
+
+		PoseBone &pb = r_pose[bone];
+
+		if (pb.weight == 0) {
+			pb.loc = loc;
+			pb.rot = rot;
+			pb.scale = scale;
+			pb.weight = p_weight;
+		} else {
+			// weighted average of everything sampled into this bone
+			float total = pb.weight + p_weight;
+			float c = p_weight / total;
+			pb.loc = pb.loc.linear_interpolate(loc, c);
+			pb.rot = pb.rot.slerp(rot, c).normalized();
+			pb.scale = pb.scale.linear_interpolate(scale, c);
+			pb.weight = total;
+		}
+	}
+}
+
+PoolVector<int> Animation::_get_pose_track_map(const NodePath &p_skeleton, const PoolVector<String> &p_bones) const {
+
+	Vector<StringName> bones;
+	bones.resize(p_bones.size());
+	PoolVector<String>::Read r = p_bones.read();
+	for (int i = 0; i < p_bones.size(); i++) {
+		bones.write[i] = r[i];
+	}
+
+	Vector<int> map = get_pose_track_map(p_skeleton, bones);
+
+	PoolVector<int> ret;
+	ret.resize(map.size());
+	PoolVector<int>::Write w = ret.write();
+	for (int i = 0; i < map.size(); i++) {
+		w[i] = map[i];
+	}
+	return ret;
+}
+
+Array Animation::_sample_pose(float p_time, const PoolVector<int> &p_track_map, int p_bone_count) const {
+
+	ERR_FAIL_COND_V(p_bone_count < 0, Array());
+	ERR_FAIL_COND_V(p_track_map.size() != tracks.size(), Array());
+
+	Vector<int> map;
+	map.resize(p_track_map.size());
+	PoolVector<int>::Read r = p_track_map.read();
+	for (int i = 0; i < p_track_map.size(); i++) {
+		map.write[i] = r[i];
+	}
+
+	Vector<PoseBone> pose;
+	pose.resize(p_bone_count);
+	sample_pose(p_time, map, pose.ptrw(), p_bone_count);
+
+	Array ret;
+	ret.resize(p_bone_count);
+	for (int i = 0; i < p_bone_count; i++) {
+		ret[i] = pose[i].get_transform();
+	}
+	return ret;
+}
+
+uint64_t Animation::get_memory_usage() const {
+
+	uint64_t size = 0;
+	for (int i = 0; i < tracks.size(); i++) {
+
+		switch (tracks[i]->type) {
+			case TYPE_TRANSFORM: {
+				const TransformTrack *tt = static_cast<const TransformTrack *>(tracks[i]);
+				size += tt->transforms.size() * sizeof(TKey<TransformKey>);
+				size += tt->packed.keys.size() * sizeof(Key) + tt->packed.pages.size() * sizeof(CompressedTransforms::Page) + tt->packed.data.size() * sizeof(uint16_t);
+			} break;
+			case TYPE_VALUE: {
+				size += static_cast<const ValueTrack *>(tracks[i])->values.size() * sizeof(TKey<Variant>);
+			} break;
+			case TYPE_METHOD: {
+				size += static_cast<const MethodTrack *>(tracks[i])->methods.size() * sizeof(MethodKey);
+			} break;
+			case TYPE_BEZIER: {
+				size += static_cast<const BezierTrack *>(tracks[i])->values.size() * sizeof(TKey<BezierKey>);
+			} break;
+			case TYPE_AUDIO: {
+				size += static_cast<const AudioTrack *>(tracks[i])->values.size() * sizeof(TKey<AudioKey>);
+			} break;
+			case TYPE_ANIMATION: {
+				size += static_cast<const AnimationTrack *>(tracks[i])->values.size() * sizeof(TKey<StringName>);
+			} break;
+		}
+	}
+	return size;
+}
+
 Animation::Animation() {
 
 	step = 0.1;
@@ -103,11 +103,48 @@ private:
 
 	/* TRANSFORM TRACK */
 
+	// Quantized keys made by compress(). Keys are split in pages, each with its own
+	// range for location and scale, so any key can be decoded on its own.
+	struct CompressedTransforms {
+
+		enum {
+			KEYS_PER_PAGE = 64,
+		};
+
+		struct Page {
+			Vector3 loc_min;
+			Vector3 loc_step;
+			Vector3 scale_min;
+			Vector3 scale_step;
+		};
+
+		Vector<Key> keys; // time and transition
+		Vector<Page> pages;
+		Vector<uint16_t> data; // per key: location, rotation (smallest three), scale, except constant parts
+		TransformKey constant; // parts with the same value in every key
+		bool loc_constant;
+		bool rot_constant;
+		bool scale_constant;
+		int stride; // values in data per key
+
+		CompressedTransforms() {
+			loc_constant = false;
+			rot_constant = false;
+			scale_constant = false;
+			stride = 0;
+		}
+	};
+
 	struct TransformTrack : public Track {
 
 		Vector<TKey<TransformKey> > transforms;
+		bool compressed; // keys are in packed instead of transforms
+		CompressedTransforms packed;
 
-		TransformTrack() { type = TYPE_TRANSFORM; }
+		TransformTrack() {
+			type = TYPE_TRANSFORM;
+			compressed = false;
+		}
 	};
 
 	/* PROPERTY VALUE TRACK */
@@ -200,7 +237,7 @@ private:
 	int _insert(float p_time, T &p_keys, const V &p_value);
 
 	template <class K>
-	inline int _find(const Vector<K> &p_keys, float p_time) const;
+	inline int _find(const Vector<K> &p_keys, float p_time, int *p_cursor = NULL) const;
 
 	_FORCE_INLINE_ Animation::TransformKey _interpolate(const Animation::TransformKey &p_a, const Animation::TransformKey &p_b, float p_c) const;
 
@@ -215,8 +252,11 @@ private:
 	_FORCE_INLINE_ Variant _cubic_interpolate(const Variant &p_pre_a, const Variant &p_a, const Variant &p_b, const Variant &p_post_b, float p_c) const;
 	_FORCE_INLINE_ float _cubic_interpolate(const float &p_pre_a, const float &p_a, const float &p_b, const float &p_post_b, float p_c) const;
 
+	template <class K>
+	_FORCE_INLINE_ bool _find_interpolation_keys(const Vector<K> &p_keys, float p_time, bool p_loop_wrap, int &r_idx, int &r_next, int &r_len, float &r_c, int *p_cursor) const;
+
 	template <class T>
-	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const;
+	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *p_cursor = NULL) const;
 
 	template <class T>
 	_FORCE_INLINE_ void _track_get_key_indices_in_range(const Vector<T> &p_array, float from_time, float to_time, List<int> *p_indices) const;
@@ -242,6 +282,17 @@ private:
 		return ret;
 	}
 
+	Variant _value_track_interpolate(int p_track, float p_time) const {
+		return value_track_interpolate(p_track, p_time);
+	}
+
+	float _bezier_track_interpolate(int p_track, float p_time) const {
+		return bezier_track_interpolate(p_track, p_time);
+	}
+
+	PoolVector<int> _get_pose_track_map(const NodePath &p_skeleton, const PoolVector<String> &p_bones) const;
+	Array _sample_pose(float p_time, const PoolVector<int> &p_track_map, int p_bone_count) const;
+
 	PoolVector<int> _value_track_get_key_indices(int p_track, float p_time, float p_delta) const {
 
 		List<int> idxs;
@@ -267,6 +318,10 @@ private:
 		return idxr;
 	}
 
+	TransformKey _transform_track_get_compressed_key(const CompressedTransforms &p_packed, int p_key) const;
+	bool _transform_track_compress(TransformTrack *p_track, float p_location_tolerance, float p_rotation_tolerance, float p_scale_tolerance);
+	void _transform_track_decompress(TransformTrack *p_track);
+
 	bool _transform_track_optimize_key(const TKey<TransformKey> &t0, const TKey<TransformKey> &t1, const TKey<TransformKey> &t2, float p_alowed_linear_err, float p_alowed_angular_err, float p_max_optimizable_angle, const Vector3 &p_norm);
 	void _transform_track_optimize(int p_idx, float p_allowed_linear_err = 0.05, float p_allowed_angular_err = 0.01, float p_max_optimizable_angle = Math_PI * 0.125);
 
@@ -325,7 +380,7 @@ public:
 	Vector2 bezier_track_get_key_in_handle(int p_track, int p_index) const;
 	Vector2 bezier_track_get_key_out_handle(int p_track, int p_index) const;
 
-	float bezier_track_interpolate(int p_track, float p_time) const;
+	float bezier_track_interpolate(int p_track, float p_time, int *p_cursor = NULL) const;
 
 	int audio_track_insert_key(int p_track, float p_time, const RES &p_stream, float p_start_offset = 0, float p_end_offset = 0);
 	void audio_track_set_key_stream(int p_track, int p_key, const RES &p_stream);
@@ -342,9 +397,9 @@ public:
 	void track_set_interpolation_loop_wrap(int p_track, bool p_enable);
 	bool track_get_interpolation_loop_wrap(int p_track) const;
 
-	Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const;
+	Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *p_cursor = NULL) const;
 
-	Variant value_track_interpolate(int p_track, float p_time) const;
+	Variant value_track_interpolate(int p_track, float p_time, int *p_cursor = NULL) const;
 	void value_track_get_key_indices(int p_track, float p_time, float p_delta, List<int> *p_indices) const;
 	void value_track_set_update_mode(int p_track, UpdateMode p_mode);
 	UpdateMode value_track_get_update_mode(int p_track) const;
@@ -370,6 +425,36 @@ public:
 
 	void optimize(float p_allowed_linear_err = 0.05, float p_allowed_angular_err = 0.01, float p_max_optimizable_angle = Math_PI * 0.125);
 
+	void compress(float p_location_tolerance = 0.001, float p_rotation_tolerance = 0.001, float p_scale_tolerance = 0.001);
+	bool track_is_compressed(int p_track) const;
+
+	// Pose sampling without nodes, e.g. for hitboxes on a server. It only
+	// reads the animation, so poses can be sampled from any thread.
+	struct PoseBone {
+
+		Vector3 loc;
+		Quat rot;
+		Vector3 scale;
+		float weight; // blend weight sampled so far, 0 until a track writes it
+
+		Transform get_transform() const {
+			Transform xform;
+			xform.basis.set_quat_scale(rot, scale);
+			xform.origin = loc;
+			return xform;
+		}
+
+		PoseBone() {
+			scale = Vector3(1, 1, 1);
+			weight = 0;
+		}
+	};
+
+	Vector<int> get_pose_track_map(const NodePath &p_skeleton, const Vector<StringName> &p_bones) const;
+	void sample_pose(float p_time, const Vector<int> &p_track_map, PoseBone *r_pose, int p_pose_size, float p_weight = 1.0, int *r_cursors = NULL) const;
+
+	virtual uint64_t get_memory_usage() const;
+
 	Animation();
 	~Animation();
 };
@@ -137,6 +137,7 @@ public:
 	bool is_stereo() const;
 
 	virtual float get_length() const; //if supported, otherwise return 0
+	virtual uint64_t get_memory_usage() const { return data_bytes; }
 
 	void set_data(const PoolVector<uint8_t> &p_data);
 	PoolVector<uint8_t> get_data() const;
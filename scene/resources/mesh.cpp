@@ -32,6 +32,7 @@
 
 #include "core/crypto/crypto_core.h"
 #include "core/local_vector.h"
+#include "core/math/mesh_simplifier.h"
 #include "core/pair.h"
 #include "scene/resources/concave_polygon_shape.h"
 #include "scene/resources/convex_polygon_shape.h"
@@ -706,6 +707,17 @@ bool ArrayMesh::_set(const StringName &p_name, const Variant &p_value) {
 		if (d.has("name")) {
 			surface_set_name(idx, d["name"]);
 		}
+		if (d.has("lods")) {
+			// pairs of error and index array
+			Array lods = d["lods"];
+			Vector<float> errors;
+			Vector<PoolVector<uint8_t> > index_arrays;
+			for (int i = 0; i + 1 < lods.size(); i += 2) {
+				errors.push_back(lods[i]);
+				index_arrays.push_back(lods[i + 1]);
+			}
+			_surface_set_lods(idx, errors, index_arrays);
+		}
 
 		return true;
 	}
@@ -783,6 +795,16 @@ bool ArrayMesh::_get(const StringName &p_name, Variant &r_ret) const {
 	if (n != "")
 		d["name"] = n;
 
+	const Surface &surface = surfaces[idx];
+	if (surface.lod_errors.size()) {
+		Array lods;
+		for (int i = 0; i < surface.lod_errors.size(); i++) {
+			lods.push_back(surface.lod_errors[i]);
+			lods.push_back(surface.lod_index_arrays[i]);
+		}
+		d["lods"] = lods;
+	}
+
 	r_ret = d;
 
 	return true;
@@ -829,12 +851,36 @@ void ArrayMesh::add_surface(uint32_t p_format, PrimitiveType p_primitive, const
 	Surface s;
 	s.aabb = p_aabb;
 	s.is_2d = p_format & ARRAY_FLAG_USE_2D_VERTICES;
+	s.data_size = p_array.size() + p_index_array.size();
+	for (int i = 0; i < p_blend_shapes.size(); i++) {
+		s.data_size += p_blend_shapes[i].size();
+	}
 	surfaces.push_back(s);
 	_recompute_aabb();
 
 	VisualServer::get_singleton()->mesh_add_surface(mesh, p_format, (VS::PrimitiveType)p_primitive, p_array, p_vertex_count, p_index_array, p_index_count, p_aabb, p_blend_shapes, p_bone_aabbs);
 }
 
+static uint64_t _get_arrays_size(const Array &p_arrays) {
+
+	// size of the arrays as given, before the visual server compresses them
+	uint64_t size = 0;
+	for (int i = 0; i < p_arrays.size(); i++) {
+		const Variant &arr = p_arrays[i];
+		switch (arr.get_type()) {
+			case Variant::POOL_BYTE_ARRAY: size += PoolVector<uint8_t>(arr).size(); break;
+			case Variant::POOL_INT_ARRAY: size += PoolVector<int>(arr).size() * sizeof(int); break;
+			case Variant::POOL_REAL_ARRAY: size += PoolVector<real_t>(arr).size() * sizeof(real_t); break;
+			case Variant::POOL_VECTOR2_ARRAY: size += PoolVector<Vector2>(arr).size() * sizeof(Vector2); break;
+			case Variant::POOL_VECTOR3_ARRAY: size += PoolVector<Vector3>(arr).size() * sizeof(Vector3); break;
+			case Variant::POOL_COLOR_ARRAY: size += PoolVector<Color>(arr).size() * sizeof(Color); break;
+			default: {
+			}
+		}
+	}
+	return size;
+}
+
 void ArrayMesh::add_surface_from_arrays(PrimitiveType p_primitive, const Array &p_arrays, const Array &p_blend_shapes, uint32_t p_flags) {
 
 	ERR_FAIL_COND(p_arrays.size() != ARRAY_MAX);
@@ -864,6 +910,10 @@ void ArrayMesh::add_surface_from_arrays(PrimitiveType p_primitive, const Array &
 
 		s.aabb = aabb;
 		s.is_2d = arr.get_type() == Variant::POOL_VECTOR2_ARRAY;
+		s.data_size = _get_arrays_size(p_arrays);
+		for (int i = 0; i < p_blend_shapes.size(); i++) {
+			s.data_size += _get_arrays_size(p_blend_shapes[i]);
+		}
 		surfaces.push_back(s);
 
 		_recompute_aabb();
@@ -1043,6 +1093,7 @@ void ArrayMesh::add_surface_from_mesh_data(const Geometry::MeshData &p_mesh_data
 
 	Surface s;
 	s.aabb = aabb;
+	s.data_size = p_mesh_data.vertices.size() * sizeof(Vector3);
 	if (surfaces.size() == 0)
 		aabb = s.aabb;
 	else
@@ -1060,6 +1111,15 @@ RID ArrayMesh::get_rid() const {
 
 	return mesh;
 }
+
+uint64_t ArrayMesh::get_memory_usage() const {
+
+	uint64_t size = 0;
+	for (int i = 0; i < surfaces.size(); i++) {
+		size += surfaces[i].data_size;
+	}
+	return size;
+}
 AABB ArrayMesh::get_aabb() const {
 
 	return aabb;
@@ -1098,6 +1158,119 @@ void ArrayMesh::regen_normalmaps() {
 	}
 }
 
+void ArrayMesh::_surface_set_lods(int p_idx, const Vector<float> &p_errors, const Vector<PoolVector<uint8_t> > &p_index_arrays) {
+
+	ERR_FAIL_INDEX(p_idx, surfaces.size());
+	ERR_FAIL_COND(p_errors.size() != p_index_arrays.size());
+
+	Surface &surface = surfaces.write[p_idx];
+	for (int i = 0; i < surface.lod_index_arrays.size(); i++) {
+		surface.data_size -= surface.lod_index_arrays[i].size();
+	}
+	surface.lod_errors = p_errors;
+	surface.lod_index_arrays = p_index_arrays;
+	for (int i = 0; i < p_index_arrays.size(); i++) {
+		surface.data_size += p_index_arrays[i].size();
+	}
+
+	VS::get_singleton()->mesh_surface_set_lods(mesh, p_idx, p_errors, p_index_arrays);
+}
+
+void ArrayMesh::generate_lods() {
+
+	for (int i = 0; i < surfaces.size(); i++) {
+
+		Vector<float> errors;
+		Vector<PoolVector<uint8_t> > index_arrays;
+
+		// LODs only replace the index array, so blend shapes (which need every vertex) are skipped
+		if (surface_get_primitive_type(i) != PRIMITIVE_TRIANGLES || !(surface_get_format(i) & ARRAY_FORMAT_INDEX) || blend_shapes.size()) {
+			_surface_set_lods(i, errors, index_arrays);
+			continue;
+		}
+
+		Array arrays = surface_get_arrays(i);
+		PoolVector<Vector3> vertex_array = arrays[ARRAY_VERTEX];
+		PoolVector<int> index_array = arrays[ARRAY_INDEX];
+
+		Vector<Vector3> vertices;
+		vertices.resize(vertex_array.size());
+		{
+			PoolVector<Vector3>::Read r = vertex_array.read();
+			for (int j = 0; j < vertex_array.size(); j++) {
+				vertices.write[j] = r[j];
+			}
+		}
+		Vector<int> indices;
+		indices.resize(index_array.size());
+		{
+			PoolVector<int>::Read r = index_array.read();
+			for (int j = 0; j < index_array.size(); j++) {
+				indices.write[j] = r[j];
+			}
+		}
+
+		// errors past a quarter of the surface size would only be used when it covers a pixel or two
+		float max_error = surfaces[i].aabb.get_longest_axis_size() * 0.25;
+		bool use_32_bit = vertices.size() >= (1 << 16);
+		int last_index_count = indices.size();
+
+		while (true) {
+
+			int target = (last_index_count / 2) / 3 * 3;
+			if (target < 16 * 3) {
+				break;
+			}
+
+			float error = 0;
+			Vector<int> lod = MeshSimplifier::simplify(vertices, indices, target, max_error, &error);
+			if (lod.size() > last_index_count * 4 / 5) {
+				break; // stuck on borders, seams or the error limit, further levels would save little
+			}
+
+			PoolVector<uint8_t> lod_data;
+			lod_data.resize(lod.size() * (use_32_bit ? 4 : 2));
+			{
+				PoolVector<uint8_t>::Write w = lod_data.write();
+				if (use_32_bit) {
+					uint32_t *dst = (uint32_t *)w.ptr();
+					for (int j = 0; j < lod.size(); j++) {
+						dst[j] = lod[j];
+					}
+				} else {
+					uint16_t *dst = (uint16_t *)w.ptr();
+					for (int j = 0; j < lod.size(); j++) {
+						dst[j] = lod[j];
+					}
+				}
+			}
+
+			// keep the errors increasing even if a coarser level happened to measure lower
+			errors.push_back(errors.size() ? MAX(error, errors[errors.size() - 1]) : error);
+			index_arrays.push_back(lod_data);
+			last_index_count = lod.size();
+		}
+
+		_surface_set_lods(i, errors, index_arrays);
+	}
+
+	emit_changed();
+}
+
+void ArrayMesh::clear_lods() {
+
+	for (int i = 0; i < surfaces.size(); i++) {
+		_surface_set_lods(i, Vector<float>(), Vector<PoolVector<uint8_t> >());
+	}
+	emit_changed();
+}
+
+int ArrayMesh::surface_get_lod_count(int p_idx) const {
+
+	ERR_FAIL_INDEX_V(p_idx, surfaces.size(), 0);
+	return surfaces[p_idx].lod_errors.size();
+}
+
 //dirty hack
 bool (*array_mesh_lightmap_unwrap_callback)(float p_texel_size, const float *p_vertices, const float *p_normals, int p_vertex_count, const int *p_indices, const int *p_face_materials, int p_index_count, float **r_uv, int **r_vertex, int *r_vertex_count, int **r_index, int *r_index_count, int *r_size_hint_x, int *r_size_hint_y) = NULL;
 
@@ -1457,6 +1630,9 @@ void ArrayMesh::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("create_convex_shape"), &ArrayMesh::create_convex_shape);
 	ClassDB::bind_method(D_METHOD("create_outline", "margin"), &ArrayMesh::create_outline);
 	ClassDB::bind_method(D_METHOD("regen_normalmaps"), &ArrayMesh::regen_normalmaps);
+	ClassDB::bind_method(D_METHOD("generate_lods"), &ArrayMesh::generate_lods);
+	ClassDB::bind_method(D_METHOD("clear_lods"), &ArrayMesh::clear_lods);
+	ClassDB::bind_method(D_METHOD("surface_get_lod_count", "surf_idx"), &ArrayMesh::surface_get_lod_count);
 	ClassDB::set_method_flags(get_class_static(), _scs_create("regen_normalmaps"), METHOD_FLAGS_DEFAULT | METHOD_FLAG_EDITOR);
 	ClassDB::bind_method(D_METHOD("lightmap_unwrap", "transform", "texel_size"), &ArrayMesh::lightmap_unwrap);
 	ClassDB::set_method_flags(get_class_static(), _scs_create("lightmap_unwrap"), METHOD_FLAGS_DEFAULT | METHOD_FLAG_EDITOR);
@@ -166,6 +166,9 @@ private:
 		AABB aabb;
 		Ref<Material> material;
 		bool is_2d;
+		uint64_t data_size; // bytes of vertex, index and blend shape data
+		Vector<float> lod_errors; // increasing, one per simplified index array
+		Vector<PoolVector<uint8_t> > lod_index_arrays;
 	};
 	Vector<Surface> surfaces;
 	RID mesh;
@@ -175,6 +178,7 @@ private:
 	AABB custom_aabb;
 
 	void _recompute_aabb();
+	void _surface_set_lods(int p_idx, const Vector<float> &p_errors, const Vector<PoolVector<uint8_t> > &p_index_arrays);
 
 protected:
 	virtual bool _is_generated() const { return false; }
@@ -227,9 +231,14 @@ public:
 
 	AABB get_aabb() const;
 	virtual RID get_rid() const;
+	virtual uint64_t get_memory_usage() const;
 
 	void regen_normalmaps();
 
+	void generate_lods();
+	void clear_lods();
+	int surface_get_lod_count(int p_idx) const;
+
 	Error lightmap_unwrap(const Transform &p_base_transform = Transform(), float p_texel_size = 0.05);
 	Error lightmap_unwrap_cached(int *&r_cache_data, unsigned int &r_cache_size, bool &r_used_cache, const Transform &p_base_transform = Transform(), float p_texel_size = 0.05);
 
@@ -41,6 +41,20 @@
 
 #define PACKED_SCENE_VERSION 2
 
+static _FORCE_INLINE_ void _call_property_setter(Object *p_object, MethodBind *p_setter, int p_index, const Variant &p_value) {
+
+	// same call ClassDB::set_property() makes once the setter is found
+	Variant::CallError ce;
+	if (p_index >= 0) {
+		Variant index = p_index;
+		const Variant *args[2] = { &index, &p_value };
+		p_setter->call(p_object, args, 2, ce);
+	} else {
+		const Variant *args[1] = { &p_value };
+		p_setter->call(p_object, args, 1, ce);
+	}
+}
+
 bool SceneState::can_instance() const {
 
 	return nodes.size() > 0;
@@ -70,9 +84,13 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 		snames = &names[0];
 
 	const Variant *props = NULL;
+	const uint8_t *kinds = NULL;
 	int prop_count = variants.size();
-	if (prop_count)
+	ERR_FAIL_COND_V(variant_kinds.size() != prop_count, NULL);
+	if (prop_count) {
 		props = &variants[0];
+		kinds = &variant_kinds[0];
+	}
 
 	//Vector<Variant> properties;
 
@@ -82,6 +100,12 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 
 	bool gen_node_path_cache = p_edit_state != GEN_EDIT_STATE_DISABLED && node_path_cache.empty();
 
+	// the cached setters skip Object::set(), so they are only used for runtime instances
+	const NodeSetters *node_setters = NULL;
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && setter_cache_ready.is_set()) {
+		node_setters = setter_cache.ptr();
+	}
+
 	Map<Ref<Resource>, Ref<Resource> > resources_local_to_scene;
 
 	for (int i = 0; i < nc; i++) {
@@ -194,6 +218,11 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 
 				const NodeData::Property *nprops = &n.properties[0];
 
+				const PropertySetter *setters = NULL;
+				if (node_setters && node_setters[i].type == node->get_class_name()) {
+					setters = node_setters[i].setters.ptr();
+				}
+
 				for (int j = 0; j < nprop_count; j++) {
 
 					bool valid;
@@ -216,45 +245,55 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 						for (List<Pair<StringName, Variant> >::Element *E = old_state.front(); E; E = E->next()) {
 							node->set(E->get().first, E->get().second);
 						}
-					} else {
-
-						Variant value = props[nprops[j].value];
+					} else if (kinds[nprops[j].value] == VARIANT_KIND_RESOURCE) {
+
+						//handle resources that are local to scene by duplicating them if needed
+						Resource *resource = static_cast<Resource *>(props[nprops[j].value].operator Object *());
+						if (!resource->is_local_to_scene()) {
+							if (setters && setters[j].setter && !node->get_script_instance()) {
+								_call_property_setter(node, setters[j].setter, setters[j].index, props[nprops[j].value]);
+							} else {
+								node->set(snames[nprops[j].name], props[nprops[j].value], &valid);
+							}
+						} else {
 
-						if (value.get_type() == Variant::OBJECT) {
-							//handle resources that are local to scene by duplicating them if needed
-							Ref<Resource> res = value;
-							if (res.is_valid()) {
-								if (res->is_local_to_scene()) {
+							Ref<Resource> res = Ref<Resource>(resource);
+							Variant value = res;
 
-									Map<Ref<Resource>, Ref<Resource> >::Element *E = resources_local_to_scene.find(res);
+							Map<Ref<Resource>, Ref<Resource> >::Element *E = resources_local_to_scene.find(res);
 
-									if (E) {
-										value = E->get();
-									} else {
+							if (E) {
+								value = E->get();
+							} else {
 
-										Node *base = i == 0 ? node : ret_nodes[0];
+								Node *base = i == 0 ? node : ret_nodes[0];
 
-										if (p_edit_state == GEN_EDIT_STATE_MAIN) {
-											//for the main scene, use the resource as is
-											res->configure_for_local_scene(base, resources_local_to_scene);
-											resources_local_to_scene[res] = res;
+								if (p_edit_state == GEN_EDIT_STATE_MAIN) {
+									//for the main scene, use the resource as is
+									res->configure_for_local_scene(base, resources_local_to_scene);
+									resources_local_to_scene[res] = res;
 
-										} else {
-											//for instances, a copy must be made
-											Node *base2 = i == 0 ? node : ret_nodes[0];
-											Ref<Resource> local_dupe = res->duplicate_for_local_scene(base2, resources_local_to_scene);
-											resources_local_to_scene[res] = local_dupe;
-											res = local_dupe;
-											value = local_dupe;
-										}
-									}
-									//must make a copy, because this res is local to scene
+								} else {
+									//for instances, a copy must be made
+									Node *base2 = i == 0 ? node : ret_nodes[0];
+									Ref<Resource> local_dupe = res->duplicate_for_local_scene(base2, resources_local_to_scene);
+									resources_local_to_scene[res] = local_dupe;
+									res = local_dupe;
+									value = local_dupe;
 								}
 							}
-						} else if (p_edit_state == GEN_EDIT_STATE_INSTANCE) {
-							value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor
+							//must make a copy, because this res is local to scene
+							node->set(snames[nprops[j].name], value, &valid);
 						}
-						node->set(snames[nprops[j].name], value, &valid);
+					} else if (kinds[nprops[j].value] == VARIANT_KIND_CONTAINER && p_edit_state == GEN_EDIT_STATE_INSTANCE) {
+						// Duplicate arrays and dictionaries for the editor
+						node->set(snames[nprops[j].name], props[nprops[j].value].duplicate(true), &valid);
+					} else if (setters && setters[j].setter && !node->get_script_instance()) {
+						// script instances may override native properties, so those always go through Object::set()
+						_call_property_setter(node, setters[j].setter, setters[j].index, props[nprops[j].value]);
+					} else {
+						// plain values need no copy, the setter receives the stored variant directly
+						node->set(snames[nprops[j].name], props[nprops[j].value], &valid);
 					}
 				}
 			}
@@ -306,6 +345,10 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 		}
 	}
 
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && !setter_cache_ready.is_set()) {
+		_build_setter_cache(ret_nodes);
+	}
+
 	for (Map<Ref<Resource>, Ref<Resource> >::Element *E = resources_local_to_scene.front(); E; E = E->next()) {
 
 		E->get()->setup_local_to_scene();
@@ -356,6 +399,302 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+void SceneState::_reset_unstored_properties(Node *p_node, const Vector<PropertyDefault> &p_defaults) {
+
+	// native properties the scene leaves at their default may have been changed since
+	for (int i = 0; i < p_defaults.size(); i++) {
+
+		const PropertyDefault &pd = p_defaults[i];
+		if (p_node->get(pd.name) != pd.value) {
+			p_node->set(pd.name, pd.value);
+		}
+	}
+}
+
+bool SceneState::restore_instance(Node *p_root) const {
+
+	// puts the stored property values, groups and connections back on a
+	// previously instanced scene, walking the nodes the same way instance()
+	// created them. Returns false if a node created by the scene is gone.
+
+	ERR_FAIL_NULL_V(p_root, false);
+
+	int nc = nodes.size();
+	ERR_FAIL_COND_V(nc == 0, false);
+
+	const StringName *snames = names.ptr();
+	const Variant *props = variants.ptr();
+	const uint8_t *kinds = variant_kinds.ptr();
+	int sname_count = names.size();
+	int prop_count = variants.size();
+	ERR_FAIL_COND_V(variant_kinds.size() != prop_count, false);
+
+	const NodeSetters *node_setters = setter_cache_ready.is_set() ? setter_cache.ptr() : NULL;
+
+	prepare_restore();
+	const NodeDefaults *node_defaults = default_cache.ptr();
+
+	Node **ret_nodes = (Node **)alloca(sizeof(Node *) * nc);
+
+	for (int i = 0; i < nc; i++) {
+
+		const NodeData &n = nodes[i];
+		bool created_here = n.instance >= 0 || n.type != TYPE_INSTANCED;
+
+		Node *node = NULL;
+		if (i == 0) {
+			node = p_root;
+		} else {
+			Node *parent = NULL;
+			if (n.parent & FLAG_ID_IS_PATH) {
+				parent = p_root->get_node_or_null(node_paths[n.parent & FLAG_MASK]);
+			} else if ((n.parent & FLAG_MASK) < i) {
+				parent = ret_nodes[n.parent & FLAG_MASK];
+			}
+			if (parent) {
+				node = parent->_get_child_by_name(snames[n.name]);
+			}
+		}
+
+		ret_nodes[i] = node;
+
+		if (!node) {
+			if (created_here) {
+				return false; //removed since it was instanced, can't be restored
+			}
+			continue; //instance() would not find it either
+		}
+
+		//instanced and inherited scenes restore their own values first, then the ones overridden here
+		if (i == 0 && base_scene_idx >= 0) {
+			Ref<PackedScene> sdata = props[base_scene_idx];
+			if (sdata.is_valid() && !sdata->get_state()->restore_instance(node)) {
+				return false;
+			}
+		} else if (n.instance >= 0) {
+			if (!(n.instance & FLAG_INSTANCE_IS_PLACEHOLDER)) {
+				Ref<PackedScene> sdata = props[n.instance & FLAG_MASK];
+				if (sdata.is_valid() && !sdata->get_state()->restore_instance(node)) {
+					return false;
+				}
+			}
+		} else if (n.type != TYPE_INSTANCED) {
+			if (node_defaults[i].type == node->get_class_name()) {
+				_reset_unstored_properties(node, node_defaults[i].defaults);
+			} else {
+				//a script or the game replaced the node with another class
+				Vector<PropertyDefault> defaults;
+				_get_unstored_defaults(node->get_class_name(), n, &defaults);
+				_reset_unstored_properties(node, defaults);
+			}
+		}
+
+		const PropertySetter *setters = NULL;
+		if (node_setters && node_setters[i].type == node->get_class_name()) {
+			setters = node_setters[i].setters.ptr();
+		}
+
+		for (int j = 0; j < n.properties.size(); j++) {
+
+			const NodeData::Property &prop = n.properties[j];
+			ERR_CONTINUE(prop.name < 0 || prop.name >= sname_count);
+			ERR_CONTINUE(prop.value < 0 || prop.value >= prop_count);
+
+			if (snames[prop.name] == CoreStringNames::get_singleton()->_script) {
+				continue; //keep the script instance, reuse is notified instead
+			}
+
+			if (kinds[prop.value] == VARIANT_KIND_RESOURCE && static_cast<Resource *>(props[prop.value].operator Object *())->is_local_to_scene()) {
+				continue; //the instance already owns its local copy
+			}
+
+			if (setters && setters[j].setter && !node->get_script_instance()) {
+				_call_property_setter(node, setters[j].setter, setters[j].index, props[prop.value]);
+			} else {
+				node->set(snames[prop.name], props[prop.value]);
+			}
+		}
+
+		//groups, persistent ones not in the scene were added by the game
+		if (created_here) {
+			List<Node::GroupInfo> groups;
+			node->get_groups(&groups);
+			for (List<Node::GroupInfo>::Element *E = groups.front(); E; E = E->next()) {
+				if (E->get().persistent && !_has_group(n, E->get().name)) {
+					node->remove_from_group(E->get().name);
+				}
+			}
+		}
+
+		for (int j = 0; j < n.groups.size(); j++) {
+
+			ERR_CONTINUE(n.groups[j] < 0 || n.groups[j] >= sname_count);
+			if (!node->is_in_group(snames[n.groups[j]])) {
+				node->add_to_group(snames[n.groups[j]], true);
+			}
+		}
+	}
+
+	//connections that were disconnected since
+	for (int i = 0; i < connections.size(); i++) {
+
+		const ConnectionData &c = connections[i];
+
+		Node *cfrom = (c.from & FLAG_ID_IS_PATH) ? p_root->get_node_or_null(node_paths[c.from & FLAG_MASK]) : ((c.from & FLAG_MASK) < nc ? ret_nodes[c.from & FLAG_MASK] : NULL);
+		Node *cto = (c.to & FLAG_ID_IS_PATH) ? p_root->get_node_or_null(node_paths[c.to & FLAG_MASK]) : ((c.to & FLAG_MASK) < nc ? ret_nodes[c.to & FLAG_MASK] : NULL);
+
+		if (!cfrom || !cto || cfrom->is_connected(snames[c.signal], cto, snames[c.method])) {
+			continue;
+		}
+
+		Vector<Variant> binds;
+		if (c.binds.size()) {
+			binds.resize(c.binds.size());
+			for (int j = 0; j < c.binds.size(); j++)
+				binds.write[j] = props[c.binds[j]];
+		}
+
+		cfrom->connect(snames[c.signal], cto, snames[c.method], binds, CONNECT_PERSIST | c.flags);
+	}
+
+	return true;
+}
+
+bool SceneState::_has_group(const NodeData &p_node, const StringName &p_group) const {
+
+	for (int i = 0; i < p_node.groups.size(); i++) {
+		if (names[p_node.groups[i]] == p_group) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void SceneState::_build_setter_cache(Node *const *p_nodes) const {
+
+	MutexLock lock(setter_cache_mutex);
+
+	if (setter_cache_ready.is_set()) {
+		return; //built by another thread in the meantime
+	}
+
+	int nc = nodes.size();
+	setter_cache.resize(nc);
+
+	for (int i = 0; i < nc; i++) {
+
+		NodeSetters &ns = setter_cache.write[i];
+		ns.type = StringName();
+		ns.setters.clear();
+
+		if (!p_nodes[i]) {
+			continue;
+		}
+
+		const NodeData &n = nodes[i];
+		ns.type = p_nodes[i]->get_class_name();
+		ns.setters.resize(n.properties.size());
+
+		for (int j = 0; j < n.properties.size(); j++) {
+
+			PropertySetter &ps = ns.setters.write[j];
+			ps.setter = NULL;
+			ps.index = -1;
+
+			const StringName &name = names[n.properties[j].name];
+			if (name == CoreStringNames::get_singleton()->_script) {
+				continue;
+			}
+
+			if (!ClassDB::get_property_setter_bind(ns.type, name, ps.setter, ps.index)) {
+				ps.setter = NULL;
+				ps.index = -1;
+			}
+		}
+	}
+
+	setter_cache_ready.set();
+}
+
+void SceneState::_get_unstored_defaults(const StringName &p_type, const NodeData &p_node, Vector<PropertyDefault> *r_defaults) const {
+
+	List<PropertyInfo> plist;
+	ClassDB::get_property_list(p_type, &plist);
+
+	for (List<PropertyInfo>::Element *E = plist.front(); E; E = E->next()) {
+
+		const PropertyInfo &pi = E->get();
+		if (!(pi.usage & PROPERTY_USAGE_STORAGE) || pi.name == CoreStringNames::get_singleton()->_script) {
+			continue;
+		}
+
+		bool stored = false;
+		for (int j = 0; j < p_node.properties.size(); j++) {
+			int name = p_node.properties[j].name;
+			if (name >= 0 && name < names.size() && names[name] == pi.name) {
+				stored = true;
+				break;
+			}
+		}
+		if (stored) {
+			continue;
+		}
+
+		PropertyDefault pd;
+		bool valid;
+		pd.value = ClassDB::class_get_default_property_value(p_type, pi.name, &valid);
+		if (!valid) {
+			continue;
+		}
+		pd.name = pi.name;
+		r_defaults->push_back(pd);
+	}
+}
+
+void SceneState::prepare_restore() const {
+
+	// looks up the defaults restore_instance() puts back, once per node
+	if (default_cache_ready.is_set()) {
+		return;
+	}
+
+	MutexLock lock(setter_cache_mutex);
+
+	if (default_cache_ready.is_set()) {
+		return; //built by another thread in the meantime
+	}
+
+	int nc = nodes.size();
+	default_cache.resize(nc);
+
+	for (int i = 0; i < nc; i++) {
+
+		NodeDefaults &nd = default_cache.write[i];
+		nd.type = StringName();
+		nd.defaults.clear();
+
+		const NodeData &n = nodes[i];
+		if (n.instance >= 0 || n.type == TYPE_INSTANCED || n.type < 0 || n.type >= names.size()) {
+			continue; //instanced scenes reset their own nodes
+		}
+
+		nd.type = names[n.type];
+		_get_unstored_defaults(nd.type, n, &nd.defaults);
+	}
+
+	default_cache_ready.set();
+}
+
+void SceneState::_clear_setter_cache() {
+
+	MutexLock lock(setter_cache_mutex);
+
+	setter_cache_ready.clear();
+	setter_cache.clear();
+	default_cache_ready.clear();
+	default_cache.clear();
+}
+
 static int _nm_get_string(const String &p_string, Map<StringName, int> &name_map) {
 
 	if (name_map.has(p_string))
@@ -903,6 +1242,8 @@ Error SceneState::pack(Node *p_scene) {
 		names.write[E->get()] = E->key();
 	}
 
+	_clear_setter_cache();
+
 	variants.resize(variant_map.size());
 	const Variant *K = NULL;
 	while ((K = variant_map.next(K))) {
@@ -910,6 +1251,7 @@ Error SceneState::pack(Node *p_scene) {
 		int idx = variant_map[*K];
 		variants.write[idx] = *K;
 	}
+	_update_variant_kinds();
 
 	node_paths.resize(nodepath_map.size());
 	for (Map<Node *, int>::Element *E = nodepath_map.front(); E; E = E->next()) {
@@ -934,7 +1276,9 @@ void SceneState::clear() {
 
 	names.clear();
 	variants.clear();
+	variant_kinds.clear();
 	nodes.clear();
+	_clear_setter_cache();
 	connections.clear();
 	node_path_cache.clear();
 	node_paths.clear();
@@ -987,6 +1331,32 @@ int SceneState::find_node_by_path(const NodePath &p_node) const {
 	return nid;
 }
 
+SceneState::VariantKind SceneState::_get_variant_kind(const Variant &p_value) {
+
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			// the stored reference keeps the object alive, so its class can't change afterwards
+			return Object::cast_to<Resource>(p_value.operator Object *()) ? VARIANT_KIND_RESOURCE : VARIANT_KIND_PLAIN;
+		}
+		case Variant::ARRAY:
+		case Variant::DICTIONARY: {
+			return VARIANT_KIND_CONTAINER;
+		}
+		default: {
+			return VARIANT_KIND_PLAIN;
+		}
+	}
+}
+
+void SceneState::_update_variant_kinds() {
+
+	int varcount = variants.size();
+	variant_kinds.resize(varcount);
+	for (int i = 0; i < varcount; i++) {
+		variant_kinds.write[i] = _get_variant_kind(variants[i]);
+	}
+}
+
 int SceneState::_find_base_scene_node_remap_key(int p_idx) const {
 
 	for (Map<int, int>::Element *E = base_scene_node_remap.front(); E; E = E->next()) {
@@ -1105,6 +1475,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 
 	ERR_FAIL_COND_MSG(version > PACKED_SCENE_VERSION, "Save format version too new.");
 
+	_clear_setter_cache();
+
 	const int node_count = p_dictionary["node_count"];
 	const PoolVector<int> snodes = p_dictionary["nodes"];
 	ERR_FAIL_COND(snodes.size() < node_count);
@@ -1136,6 +1508,7 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 	} else {
 		variants.clear();
 	}
+	_update_variant_kinds();
 
 	nodes.resize(node_count);
 	if (node_count) {
@@ -1554,6 +1927,7 @@ int SceneState::find_name(const StringName &p_name) const {
 int SceneState::add_value(const Variant &p_value) {
 
 	variants.push_back(p_value);
+	variant_kinds.push_back(_get_variant_kind(p_value));
 	return variants.size() - 1;
 }
 
@@ -1573,6 +1947,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.index = p_index;
 
 	nodes.push_back(nd);
+	_clear_setter_cache();
 
 	return nodes.size() - 1;
 }
@@ -1586,6 +1961,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value) {
 	prop.name = p_name;
 	prop.value = p_value;
 	nodes.write[p_node].properties.push_back(prop);
+	_clear_setter_cache();
 }
 void SceneState::add_node_group(int p_node, int p_group) {
 
@@ -1716,6 +2092,109 @@ Node *PackedScene::instance(GenEditState p_edit_state) const {
 	return s;
 }
 
+SafeNumeric<uint32_t> PackedScene::pooled_instance_count;
+SafeNumeric<uint64_t> PackedScene::pool_reuse_count;
+
+void PackedScene::set_pool_capacity(int p_capacity) {
+
+	ERR_FAIL_COND(p_capacity < 0);
+
+	if (p_capacity > 0) {
+		state->prepare_restore();
+	}
+
+	List<Node *> to_free;
+	{
+		MutexLock lock(pool_mutex);
+		pool_capacity = p_capacity;
+		while (pool.size() > pool_capacity) {
+			Node *node = Object::cast_to<Node>(ObjectDB::get_instance(pool[pool.size() - 1]));
+			if (node) {
+				to_free.push_back(node);
+			}
+			pool.resize(pool.size() - 1);
+			pooled_instance_count.decrement();
+		}
+	}
+
+	for (List<Node *>::Element *E = to_free.front(); E; E = E->next()) {
+		memdelete(E->get());
+	}
+}
+
+int PackedScene::get_pool_capacity() const {
+
+	return pool_capacity;
+}
+
+int PackedScene::get_pooled_count() const {
+
+	MutexLock lock(pool_mutex);
+	return pool.size();
+}
+
+Node *PackedScene::instance_pooled() {
+
+	Node *node = NULL;
+	{
+		MutexLock lock(pool_mutex);
+		while (!node && pool.size()) {
+			//the instance may have been freed behind the pool's back
+			node = Object::cast_to<Node>(ObjectDB::get_instance(pool[pool.size() - 1]));
+			pool.resize(pool.size() - 1);
+			pooled_instance_count.decrement();
+		}
+	}
+
+	if (!node) {
+		return instance();
+	}
+
+	if (!state->restore_instance(node)) {
+		//lost part of its structure while in use, start over
+		memdelete(node);
+		return instance();
+	}
+
+	pool_reuse_count.increment();
+
+	node->propagate_notification(Node::NOTIFICATION_POOL_REUSED);
+
+	return node;
+}
+
+void PackedScene::release_to_pool(Node *p_node) {
+
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(get_path() != "" && p_node->get_filename() != get_path(), "Node was not instanced from this scene.");
+
+	{
+		MutexLock lock(pool_mutex);
+		ERR_FAIL_COND_MSG(pool.find(p_node->get_instance_id()) != -1, "Node is already in the pool.");
+	}
+
+	if (p_node->get_parent()) {
+		p_node->get_parent()->remove_child(p_node);
+	}
+
+	{
+		MutexLock lock(pool_mutex);
+		if (pool.size() < pool_capacity) {
+			pool.push_back(p_node->get_instance_id());
+			pooled_instance_count.increment();
+			return;
+		}
+	}
+
+	//pool is full
+	memdelete(p_node);
+}
+
+void PackedScene::clear_pool() {
+
+	set_pool_capacity(0);
+}
+
 void PackedScene::replace_state(Ref<SceneState> p_by) {
 
 	state = p_by;
@@ -1753,6 +2232,12 @@ void PackedScene::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
 	ClassDB::bind_method(D_METHOD("get_state"), &PackedScene::get_state);
+	ClassDB::bind_method(D_METHOD("set_pool_capacity", "capacity"), &PackedScene::set_pool_capacity);
+	ClassDB::bind_method(D_METHOD("get_pool_capacity"), &PackedScene::get_pool_capacity);
+	ClassDB::bind_method(D_METHOD("get_pooled_count"), &PackedScene::get_pooled_count);
+	ClassDB::bind_method(D_METHOD("instance_pooled"), &PackedScene::instance_pooled);
+	ClassDB::bind_method(D_METHOD("release_to_pool", "node"), &PackedScene::release_to_pool);
+	ClassDB::bind_method(D_METHOD("clear_pool"), &PackedScene::clear_pool);
 
 	ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "_bundled"), "_set_bundled_scene", "_get_bundled_scene");
 
@@ -1764,4 +2249,10 @@ void PackedScene::_bind_methods() {
 PackedScene::PackedScene() {
 
 	state = Ref<SceneState>(memnew(SceneState));
+	pool_capacity = 0;
+}
+
+PackedScene::~PackedScene() {
+
+	clear_pool();
 }
@@ -31,7 +31,9 @@
 #ifndef PACKED_SCENE_H
 #define PACKED_SCENE_H
 
+#include "core/os/mutex.h"
 #include "core/resource.h"
+#include "core/safe_refcount.h"
 #include "scene/main/node.h"
 
 class SceneState : public Reference {
@@ -40,6 +42,7 @@ class SceneState : public Reference {
 
 	Vector<StringName> names;
 	Vector<Variant> variants;
+	Vector<uint8_t> variant_kinds;
 	Vector<NodePath> node_paths;
 	Vector<NodePath> editable_instances;
 	mutable HashMap<NodePath, int> node_path_cache;
@@ -47,6 +50,14 @@ class SceneState : public Reference {
 
 	int base_scene_idx;
 
+	// Classification of stored values, resolved once when the state is built so
+	// instancing can hand values to setters without re-inspecting each Variant.
+	enum VariantKind {
+		VARIANT_KIND_PLAIN, // passed to the setter as is
+		VARIANT_KIND_RESOURCE, // may need a local to scene duplicate
+		VARIANT_KIND_CONTAINER, // arrays and dictionaries, deep copied for the editor
+	};
+
 	enum {
 		NO_PARENT_SAVED = 0x7FFFFFFF,
 		NAME_INDEX_BITS = 18,
@@ -92,6 +103,47 @@ class SceneState : public Reference {
 
 	Vector<ConnectionData> connections;
 
+	// Setters resolved on the first runtime instance, so later instances can call
+	// them directly instead of looking each property up by name.
+	struct PropertySetter {
+
+		MethodBind *setter; // NULL when Object::set() has to resolve the property
+		int index;
+	};
+
+	struct NodeSetters {
+
+		StringName type; // class the setters were resolved for
+		Vector<PropertySetter> setters;
+	};
+
+	mutable Vector<NodeSetters> setter_cache;
+	mutable SafeFlag setter_cache_ready;
+	mutable Mutex setter_cache_mutex;
+
+	// Native properties each node leaves at their default, with those defaults,
+	// so reusing a pooled instance only has to put these back.
+	struct PropertyDefault {
+
+		StringName name;
+		Variant value;
+	};
+
+	struct NodeDefaults {
+
+		StringName type; // class the defaults were looked up for
+		Vector<PropertyDefault> defaults;
+	};
+
+	mutable Vector<NodeDefaults> default_cache;
+	mutable SafeFlag default_cache_ready;
+
+	void _build_setter_cache(Node *const *p_nodes) const;
+	void _get_unstored_defaults(const StringName &p_type, const NodeData &p_node, Vector<PropertyDefault> *r_defaults) const;
+	static void _reset_unstored_properties(Node *p_node, const Vector<PropertyDefault> &p_defaults);
+	bool _has_group(const NodeData &p_node, const StringName &p_group) const;
+	void _clear_setter_cache();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 
@@ -107,6 +159,9 @@ class SceneState : public Reference {
 
 	int _find_base_scene_node_remap_key(int p_idx) const;
 
+	static VariantKind _get_variant_kind(const Variant &p_value);
+	void _update_variant_kinds();
+
 protected:
 	static void _bind_methods();
 
@@ -143,6 +198,8 @@ public:
 
 	bool can_instance() const;
 	Node *instance(GenEditState p_edit_state) const;
+	void prepare_restore() const;
+	bool restore_instance(Node *p_root) const;
 
 	//unbuild API
 
@@ -201,6 +258,14 @@ class PackedScene : public Resource {
 
 	Ref<SceneState> state;
 
+	// detached instances kept around for reuse, see instance_pooled()
+	Vector<ObjectID> pool;
+	int pool_capacity;
+	Mutex pool_mutex;
+
+	static SafeNumeric<uint32_t> pooled_instance_count;
+	static SafeNumeric<uint64_t> pool_reuse_count;
+
 	void _set_bundled_scene(const Dictionary &p_scene);
 	Dictionary _get_bundled_scene() const;
 
@@ -222,6 +287,17 @@ public:
 	bool can_instance() const;
 	Node *instance(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
 
+	void set_pool_capacity(int p_capacity);
+	int get_pool_capacity() const;
+	int get_pooled_count() const;
+
+	Node *instance_pooled();
+	void release_to_pool(Node *p_node);
+	void clear_pool();
+
+	static uint32_t get_pooled_instance_count() { return pooled_instance_count.get(); }
+	static uint64_t get_pool_reuse_count() { return pool_reuse_count.get(); }
+
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
 
@@ -233,6 +309,7 @@ public:
 	Ref<SceneState> get_state();
 
 	PackedScene();
+	~PackedScene();
 };
 
 VARIANT_ENUM_CAST(PackedScene::GenEditState)
@@ -288,6 +288,14 @@ RID ImageTexture::get_rid() const {
 	return texture;
 }
 
+uint64_t ImageTexture::get_memory_usage() const {
+
+	if (format == Image::FORMAT_MAX || w == 0 || h == 0) {
+		return 0;
+	}
+	return Image::get_image_data_size(w, h, format, flags & FLAG_MIPMAPS);
+}
+
 bool ImageTexture::has_alpha() const {
 
 	return (format == Image::FORMAT_LA8 || format == Image::FORMAT_RGBA8);
@@ -548,7 +556,8 @@ Error StreamTexture::_load_data(const String &p_path, int &tw, int &th, int &tw_
 		VS::get_singleton()->texture_set_detect_normal_callback(texture, NULL, NULL);
 	}
 #endif
-	if (!(df & FORMAT_BIT_STREAM)) {
+	streamable = df & FORMAT_BIT_STREAM;
+	if (!streamable) {
 		p_size_limit = 0;
 	}
 
@@ -565,8 +574,8 @@ Error StreamTexture::_load_data(const String &p_path, int &tw, int &th, int &tw_
 
 		while (mipmaps > 1 && p_size_limit > 0 && (sw > p_size_limit || sh > p_size_limit)) {
 
+			//each mipmap is stored as its size followed by its data
 			f->seek(f->get_position() + size);
-			mipmaps = f->get_32();
 			size = f->get_32();
 
 			sw = MAX(sw >> 1, 1);
@@ -719,7 +728,7 @@ Error StreamTexture::load(const String &p_path) {
 	int lw, lh, lwc, lhc, lflags;
 	Ref<Image> image;
 	image.instance();
-	Error err = _load_data(p_path, lw, lh, lwc, lhc, lflags, image);
+	Error err = _load_data(p_path, lw, lh, lwc, lhc, lflags, image, stream_size_limit >= 0 ? stream_size_limit : default_stream_size_limit);
 	if (err)
 		return err;
 
@@ -731,7 +740,9 @@ Error StreamTexture::load(const String &p_path) {
 	VS::get_singleton()->texture_set_data(texture, image);
 	if (lwc || lhc) {
 		VS::get_singleton()->texture_set_size_override(texture, lwc, lhc, 0);
-	} else {
+	} else if (image->get_width() != lw || image->get_height() != lh) {
+		//only the lower mipmaps are resident, keep reporting the full size so UVs and regions stay valid
+		VS::get_singleton()->texture_set_size_override(texture, lw, lh, 0);
 	}
 
 	w = lwc ? lwc : lw;
@@ -739,6 +750,7 @@ Error StreamTexture::load(const String &p_path) {
 	flags = lflags;
 	path_to_file = p_path;
 	format = image->get_format();
+	resident_size = image->get_data().size();
 
 	_change_notify();
 	emit_changed();
@@ -749,6 +761,42 @@ String StreamTexture::get_load_path() const {
 	return path_to_file;
 }
 
+bool StreamTexture::is_streamable() const {
+
+	return streamable;
+}
+
+void StreamTexture::set_stream_size_limit(int p_limit) {
+
+	if (stream_size_limit == p_limit) {
+		return;
+	}
+
+	stream_size_limit = p_limit;
+
+	if (streamable && path_to_file != String()) {
+		//reload the mipmap chain from disk, only the mipmaps within the limit are read
+		load(path_to_file);
+	}
+}
+
+int StreamTexture::get_stream_size_limit() const {
+
+	return stream_size_limit;
+}
+
+int StreamTexture::default_stream_size_limit = 0;
+
+void StreamTexture::set_default_stream_size_limit(int p_limit) {
+
+	default_stream_size_limit = MAX(p_limit, 0);
+}
+
+int StreamTexture::get_default_stream_size_limit() {
+
+	return default_stream_size_limit;
+}
+
 int StreamTexture::get_width() const {
 
 	return w;
@@ -762,6 +810,11 @@ RID StreamTexture::get_rid() const {
 	return texture;
 }
 
+uint64_t StreamTexture::get_memory_usage() const {
+
+	return resident_size;
+}
+
 void StreamTexture::draw(RID p_canvas_item, const Point2 &p_pos, const Color &p_modulate, bool p_transpose, const Ref<Texture> &p_normal_map) const {
 
 	if ((w | h) == 0)
@@ -860,6 +913,9 @@ void StreamTexture::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("load", "path"), &StreamTexture::load);
 	ClassDB::bind_method(D_METHOD("get_load_path"), &StreamTexture::get_load_path);
+	ClassDB::bind_method(D_METHOD("is_streamable"), &StreamTexture::is_streamable);
+	ClassDB::bind_method(D_METHOD("set_stream_size_limit", "limit"), &StreamTexture::set_stream_size_limit);
+	ClassDB::bind_method(D_METHOD("get_stream_size_limit"), &StreamTexture::get_stream_size_limit);
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "load_path", PROPERTY_HINT_FILE, "*.stex"), "load", "get_load_path");
 }
@@ -870,6 +926,9 @@ StreamTexture::StreamTexture() {
 	flags = 0;
 	w = 0;
 	h = 0;
+	streamable = false;
+	stream_size_limit = -1;
+	resident_size = 0;
 
 	texture = VS::get_singleton()->texture_create();
 }
@@ -141,6 +141,7 @@ public:
 	int get_height() const;
 
 	virtual RID get_rid() const;
+	virtual uint64_t get_memory_usage() const;
 
 	bool has_alpha() const;
 	virtual void draw(RID p_canvas_item, const Point2 &p_pos, const Color &p_modulate = Color(1, 1, 1), bool p_transpose = false, const Ref<Texture> &p_normal_map = Ref<Texture>()) const;
@@ -193,6 +194,12 @@ private:
 	int w, h;
 	mutable Ref<BitMap> alpha_cache;
 
+	bool streamable;
+	int stream_size_limit;
+	uint64_t resident_size;
+
+	static int default_stream_size_limit;
+
 	virtual void reload_from_file();
 
 	static void _requested_3d(void *p_ud);
@@ -215,9 +222,17 @@ public:
 	Error load(const String &p_path);
 	String get_load_path() const;
 
+	bool is_streamable() const;
+	void set_stream_size_limit(int p_limit);
+	int get_stream_size_limit() const;
+
+	static void set_default_stream_size_limit(int p_limit);
+	static int get_default_stream_size_limit();
+
 	int get_width() const;
 	int get_height() const;
 	virtual RID get_rid() const;
+	virtual uint64_t get_memory_usage() const;
 
 	virtual void set_path(const String &p_path, bool p_take_over);
 
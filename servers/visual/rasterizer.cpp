@@ -40,6 +40,8 @@ Rasterizer *Rasterizer::create() {
 	return _create_func();
 }
 
+uint32_t RasterizerCanvas::Item::next_command_version = 0;
+
 RasterizerStorage *RasterizerStorage::base_singleton = NULL;
 
 RasterizerStorage::RasterizerStorage() {
@@ -114,6 +114,7 @@ public:
 		bool redraw_if_visible : 4;
 
 		float depth; //used for sorting
+		float lod_error; //largest mesh LOD error allowed, in the instance's local space, 0 for full detail
 
 		SelfList<InstanceBase> dependency_item;
 
@@ -138,6 +139,7 @@ public:
 			redraw_if_visible = false;
 			lightmap_capture = NULL;
 			lightmap_slice = -1;
+			lod_error = 0;
 			lightmap_uv_rect = Rect2(0, 0, 1, 1);
 		}
 	};
@@ -304,6 +306,8 @@ public:
 	virtual Vector<PoolVector<uint8_t> > mesh_surface_get_blend_shapes(RID p_mesh, int p_surface) const = 0;
 	virtual Vector<AABB> mesh_surface_get_skeleton_aabb(RID p_mesh, int p_surface) const = 0;
 
+	virtual void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<float> &p_errors, const Vector<PoolVector<uint8_t> > &p_index_arrays) = 0;
+
 	virtual void mesh_remove_surface(RID p_mesh, int p_index) = 0;
 	virtual int mesh_get_surface_count(RID p_mesh) const = 0;
 
@@ -364,6 +368,7 @@ public:
 	virtual int skeleton_get_bone_count(RID p_skeleton) const = 0;
 	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform) = 0;
 	virtual Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const = 0;
+	virtual void skeleton_set_bone_transforms(RID p_skeleton, const Vector<Transform> &p_transforms) = 0;
 	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) = 0;
 	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const = 0;
 	virtual void skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform) = 0;
@@ -872,6 +877,10 @@ public:
 		//VS::MaterialBlendMode blend_mode;
 		int light_mask;
 		Vector<Command *> commands;
+		// commands are only ever appended or cleared, so the version together with
+		// the command count identifies the contents (used by renderer side caches)
+		uint32_t command_version;
+		static uint32_t next_command_version;
 		mutable bool custom_rect;
 		mutable bool rect_dirty;
 		mutable Rect2 rect;
@@ -1097,6 +1106,7 @@ public:
 			for (int i = 0; i < commands.size(); i++)
 				memdelete(commands[i]);
 			commands.clear();
+			command_version = ++next_command_version;
 			clip = false;
 			rect_dirty = true;
 			final_clip_owner = NULL;
@@ -1112,6 +1122,7 @@ public:
 			final_modulate = Color(1, 1, 1, 1);
 			visible = true;
 			rect_dirty = true;
+			command_version = ++next_command_version;
 			custom_rect = false;
 			behind = false;
 			material_owner = NULL;
@@ -1184,6 +1195,7 @@ public:
 	virtual void set_current_render_target(RID p_render_target) = 0;
 	virtual void restore_render_target(bool p_3d) = 0;
 	virtual void clear_render_target(const Color &p_color) = 0;
+	virtual void clear_render_target_rect(const Rect2 &p_rect, const Color &p_color) = 0;
 	virtual void blit_render_target_to_screen(RID p_render_target, const Rect2 &p_screen_rect, int p_screen = 0) = 0;
 	virtual void output_lens_distorted_to_screen(RID p_render_target, const Rect2 &p_screen_rect, float p_k1, float p_k2, const Vector2 &p_eye_center, float p_oversample) = 0;
 	virtual void end_frame(bool p_swap_buffers) = 0;
@@ -229,7 +229,7 @@ void VisualServerCanvas::_light_mask_canvas_items(int p_z, RasterizerCanvas::Ite
 	}
 }
 
-void VisualServerCanvas::render_canvas(Canvas *p_canvas, const Transform2D &p_transform, RasterizerCanvas::Light *p_lights, RasterizerCanvas::Light *p_masked_lights, const Rect2 &p_clip_rect, int p_canvas_layer_id) {
+void VisualServerCanvas::render_canvas(Canvas *p_canvas, const Transform2D &p_transform, RasterizerCanvas::Light *p_lights, RasterizerCanvas::Light *p_masked_lights, const Rect2 &p_clip_rect, int p_canvas_layer_id, const Rect2 *p_damage_rect, int *r_items_skipped) {
 
 	VSG::canvas_render->canvas_begin();
 
@@ -259,12 +259,38 @@ void VisualServerCanvas::render_canvas(Canvas *p_canvas, const Transform2D &p_tr
 		memset(z_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
 		memset(z_last_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
 
+		Item *canvas_clip = NULL;
+		if (p_damage_rect) {
+			damage_clip_item.final_clip_rect = *p_damage_rect;
+			canvas_clip = &damage_clip_item;
+		}
+
 		for (int i = 0; i < l; i++) {
-			_render_canvas_item(ci[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, NULL, NULL);
+			_render_canvas_item(ci[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, canvas_clip, NULL);
 		}
 
 		VSG::canvas_render->canvas_render_items_begin(p_canvas->modulate, p_lights, p_transform);
 		for (int i = 0; i < z_range; i++) {
+
+			if (p_damage_rect) {
+				// drop the items that don't touch the damaged region
+				int skipped = 0;
+				RasterizerCanvas::Item **prev = &z_list[i];
+				for (RasterizerCanvas::Item *ci2 = z_list[i]; ci2; ci2 = ci2->next) {
+					if (ci2->copy_back_buffer || ci2->global_rect_cache.intersects(*p_damage_rect, true)) {
+						*prev = ci2;
+						prev = &ci2->next;
+					} else {
+						skipped++;
+					}
+				}
+				*prev = NULL;
+
+				if (r_items_skipped) {
+					*r_items_skipped += skipped;
+				}
+			}
+
 			if (!z_list[i])
 				continue;
 
@@ -304,6 +330,147 @@ void VisualServerCanvas::render_canvas(Canvas *p_canvas, const Transform2D &p_tr
 	VSG::canvas_render->canvas_end();
 }
 
+bool VisualServerCanvas::_item_textures_changed(Item *p_item, uint64_t p_serial) const {
+
+	for (int i = 0; i < p_item->commands.size(); i++) {
+
+		const RasterizerCanvas::Item::Command *c = p_item->commands[i];
+		RID texture;
+		RID normal_map;
+
+		switch (c->type) {
+			case RasterizerCanvas::Item::Command::TYPE_RECT: {
+				const RasterizerCanvas::Item::CommandRect *rect = static_cast<const RasterizerCanvas::Item::CommandRect *>(c);
+				texture = rect->texture;
+				normal_map = rect->normal_map;
+			} break;
+			case RasterizerCanvas::Item::Command::TYPE_NINEPATCH: {
+				const RasterizerCanvas::Item::CommandNinePatch *np = static_cast<const RasterizerCanvas::Item::CommandNinePatch *>(c);
+				texture = np->texture;
+				normal_map = np->normal_map;
+			} break;
+			case RasterizerCanvas::Item::Command::TYPE_PRIMITIVE: {
+				const RasterizerCanvas::Item::CommandPrimitive *primitive = static_cast<const RasterizerCanvas::Item::CommandPrimitive *>(c);
+				texture = primitive->texture;
+				normal_map = primitive->normal_map;
+			} break;
+			case RasterizerCanvas::Item::Command::TYPE_POLYGON: {
+				const RasterizerCanvas::Item::CommandPolygon *polygon = static_cast<const RasterizerCanvas::Item::CommandPolygon *>(c);
+				texture = polygon->texture;
+				normal_map = polygon->normal_map;
+			} break;
+			default: {
+				// meshes, multimeshes and particles are redrawn every update anyway
+				continue;
+			}
+		}
+
+		if ((texture.is_valid() && VSG::viewport->texture_changed_since(texture, p_serial)) || (normal_map.is_valid() && VSG::viewport->texture_changed_since(normal_map, p_serial))) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void VisualServerCanvas::_update_item_damage(Item *p_item, VisualServerViewport::Viewport::Damage &r_damage) {
+
+	uint32_t order = r_damage.order++;
+	r_damage.item_count++;
+
+	if (p_item->copy_back_buffer) {
+		r_damage.has_back_buffer = true;
+	}
+
+	Rect2 clip_rect = p_item->final_clip_owner ? p_item->final_clip_owner->final_clip_rect : Rect2();
+	RID material = p_item->material_owner ? p_item->material_owner->material : p_item->material;
+
+	uint64_t key = (uint64_t)(uintptr_t)p_item;
+	VisualServerViewport::Viewport::Damage::ItemState *state = r_damage.items.getptr(key);
+
+	if (!state) {
+		r_damage.items.set(key, VisualServerViewport::Viewport::Damage::ItemState());
+		state = r_damage.items.getptr(key);
+		state->command_version = p_item->command_version - 1;
+		r_damage.add(p_item->global_rect_cache);
+	} else {
+		bool changed = state->command_version != p_item->command_version ||
+					   state->command_count != p_item->commands.size() ||
+					   state->volatile_content ||
+					   p_item->skeleton.is_valid() ||
+					   material.is_valid() ||
+					   (r_damage.textures_changed && _item_textures_changed(p_item, r_damage.texture_serial)) ||
+					   state->order != order ||
+					   state->rect != p_item->global_rect_cache ||
+					   state->xform != p_item->final_transform ||
+					   state->modulate != p_item->final_modulate ||
+					   state->clip_rect != clip_rect ||
+					   state->material != material;
+
+		if (changed) {
+			r_damage.add(state->rect);
+			r_damage.add(p_item->global_rect_cache);
+		}
+	}
+
+	if (state->command_version != p_item->command_version || state->command_count != p_item->commands.size()) {
+		state->volatile_content = false;
+		for (int i = 0; i < p_item->commands.size(); i++) {
+			RasterizerCanvas::Item::Command::Type type = p_item->commands[i]->type;
+			if (type == RasterizerCanvas::Item::Command::TYPE_MESH || type == RasterizerCanvas::Item::Command::TYPE_MULTIMESH || type == RasterizerCanvas::Item::Command::TYPE_PARTICLES) {
+				state->volatile_content = true;
+				break;
+			}
+		}
+	}
+
+	state->rect = p_item->global_rect_cache;
+	state->xform = p_item->final_transform;
+	state->modulate = p_item->final_modulate;
+	state->clip_rect = clip_rect;
+	state->material = material;
+	state->command_version = p_item->command_version;
+	state->command_count = p_item->commands.size();
+	state->order = order;
+	state->pass = r_damage.pass;
+}
+
+void VisualServerCanvas::canvas_update_damage(Canvas *p_canvas, const Transform2D &p_transform, const Rect2 &p_clip_rect, VisualServerViewport::Viewport::Damage &r_damage) {
+
+	if (p_canvas->children_order_dirty) {
+
+		p_canvas->child_items.sort();
+		p_canvas->children_order_dirty = false;
+	}
+
+	// lights and mirrored items are not tracked, they redraw everything
+	if (!p_canvas->lights.empty()) {
+		r_damage.full = true;
+	}
+
+	int l = p_canvas->child_items.size();
+	Canvas::ChildItem *ci = p_canvas->child_items.ptrw();
+
+	for (int i = 0; i < l; i++) {
+		if (ci[i].mirror.x || ci[i].mirror.y) {
+			r_damage.full = true;
+		}
+	}
+
+	memset(z_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
+	memset(z_last_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
+
+	for (int i = 0; i < l; i++) {
+		_render_canvas_item(ci[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, NULL, NULL);
+	}
+
+	for (int i = 0; i < z_range; i++) {
+		for (RasterizerCanvas::Item *ci2 = z_list[i]; ci2; ci2 = ci2->next) {
+			_update_item_damage(static_cast<Item *>(ci2), r_damage);
+		}
+	}
+}
+
 RID VisualServerCanvas::canvas_create() {
 
 	Canvas *canvas = memnew(Canvas);
@@ -167,8 +167,15 @@ private:
 	RasterizerCanvas::Item **z_list;
 	RasterizerCanvas::Item **z_last_list;
 
+	// clips everything to the damaged region when only part of a viewport is redrawn
+	Item damage_clip_item;
+
+	bool _item_textures_changed(Item *p_item, uint64_t p_serial) const;
+	void _update_item_damage(Item *p_item, VisualServerViewport::Viewport::Damage &r_damage);
+
 public:
-	void render_canvas(Canvas *p_canvas, const Transform2D &p_transform, RasterizerCanvas::Light *p_lights, RasterizerCanvas::Light *p_masked_lights, const Rect2 &p_clip_rect, int p_canvas_layer_id);
+	void render_canvas(Canvas *p_canvas, const Transform2D &p_transform, RasterizerCanvas::Light *p_lights, RasterizerCanvas::Light *p_masked_lights, const Rect2 &p_clip_rect, int p_canvas_layer_id, const Rect2 *p_damage_rect = NULL, int *r_items_skipped = NULL);
+	void canvas_update_damage(Canvas *p_canvas, const Transform2D &p_transform, const Rect2 &p_clip_rect, VisualServerViewport::Viewport::Damage &r_damage);
 
 	RID canvas_create();
 	void canvas_set_item_mirroring(RID p_canvas, RID p_item, const Point2 &p_mirroring);
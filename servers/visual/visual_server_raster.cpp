@@ -69,6 +69,8 @@ void VisualServerRaster::_draw_margins() {
 
 void VisualServerRaster::free(RID p_rid) {
 
+	VSG::viewport->texture_removed(p_rid);
+
 	if (VSG::storage->free(p_rid))
 		return;
 	if (VSG::canvas->free(p_rid))
@@ -81,6 +83,38 @@ void VisualServerRaster::free(RID p_rid) {
 		return;
 }
 
+/* TEXTURE API */
+
+// these also tell the viewports which textures changed, see VS::VIEWPORT_UPDATE_WHEN_DIRTY
+
+void VisualServerRaster::texture_allocate(RID p_texture, int p_width, int p_height, int p_depth_3d, Image::Format p_format, TextureType p_type, uint32_t p_flags) {
+
+	redraw_request();
+	VSG::storage->texture_allocate(p_texture, p_width, p_height, p_depth_3d, p_format, p_type, p_flags);
+	VSG::viewport->texture_changed(p_texture);
+}
+
+void VisualServerRaster::texture_set_data(RID p_texture, const Ref<Image> &p_image, int p_layer) {
+
+	redraw_request();
+	VSG::storage->texture_set_data(p_texture, p_image, p_layer);
+	VSG::viewport->texture_changed(p_texture);
+}
+
+void VisualServerRaster::texture_set_data_partial(RID p_texture, const Ref<Image> &p_image, int p_src_x, int p_src_y, int p_src_w, int p_src_h, int p_dst_x, int p_dst_y, int p_dst_mip, int p_layer) {
+
+	redraw_request();
+	VSG::storage->texture_set_data_partial(p_texture, p_image, p_src_x, p_src_y, p_src_w, p_src_h, p_dst_x, p_dst_y, p_dst_mip, p_layer);
+	VSG::viewport->texture_changed(p_texture);
+}
+
+void VisualServerRaster::texture_set_proxy(RID p_proxy, RID p_base) {
+
+	redraw_request();
+	VSG::storage->texture_set_proxy(p_proxy, p_base);
+	VSG::viewport->texture_set_proxy(p_proxy, p_base);
+}
+
 /* EVENT QUEUING */
 
 void VisualServerRaster::request_frame_drawn_callback(Object *p_where, const StringName &p_method, const Variant &p_userdata) {
@@ -143,9 +143,9 @@ public:
 	/* TEXTURE API */
 
 	BIND0R(RID, texture_create)
-	BIND7(texture_allocate, RID, int, int, int, Image::Format, TextureType, uint32_t)
-	BIND3(texture_set_data, RID, const Ref<Image> &, int)
-	BIND10(texture_set_data_partial, RID, const Ref<Image> &, int, int, int, int, int, int, int, int)
+	void texture_allocate(RID p_texture, int p_width, int p_height, int p_depth_3d, Image::Format p_format, TextureType p_type, uint32_t p_flags);
+	void texture_set_data(RID p_texture, const Ref<Image> &p_image, int p_layer);
+	void texture_set_data_partial(RID p_texture, const Ref<Image> &p_image, int p_src_x, int p_src_y, int p_src_w, int p_src_h, int p_dst_x, int p_dst_y, int p_dst_mip, int p_layer);
 	BIND2RC(Ref<Image>, texture_get_data, RID, int)
 	BIND2(texture_set_flags, RID, uint32_t)
 	BIND1RC(uint32_t, texture_get_flags, RID)
@@ -169,7 +169,7 @@ public:
 
 	BIND1(textures_keep_original, bool)
 
-	BIND2(texture_set_proxy, RID, RID)
+	void texture_set_proxy(RID p_proxy, RID p_base);
 
 	BIND2(texture_set_force_redraw_if_visible, RID, bool)
 
@@ -239,6 +239,8 @@ public:
 	BIND2RC(Vector<PoolVector<uint8_t> >, mesh_surface_get_blend_shapes, RID, int)
 	BIND2RC(Vector<AABB>, mesh_surface_get_skeleton_aabb, RID, int)
 
+	BIND4(mesh_surface_set_lods, RID, int, const Vector<float> &, const Vector<PoolVector<uint8_t> > &)
+
 	BIND2(mesh_remove_surface, RID, int)
 	BIND1RC(int, mesh_get_surface_count, RID)
 
@@ -295,6 +297,7 @@ public:
 	BIND1RC(int, skeleton_get_bone_count, RID)
 	BIND3(skeleton_bone_set_transform, RID, int, const Transform &)
 	BIND2RC(Transform, skeleton_bone_get_transform, RID, int)
+	BIND2(skeleton_set_bone_transforms, RID, const Vector<Transform> &)
 	BIND3(skeleton_bone_set_transform_2d, RID, int, const Transform2D &)
 	BIND2RC(Transform2D, skeleton_bone_get_transform_2d, RID, int)
 	BIND2(skeleton_set_base_transform_2d, RID, const Transform2D &)
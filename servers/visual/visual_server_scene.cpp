@@ -1479,7 +1479,29 @@ void VisualServerScene::_update_instance_lightmap_captures(Instance *p_instance)
 	p_instance->lightmap_capture_data.write[0].a = interior ? 0.0f : 1.0f;
 }
 
-bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario) {
+void VisualServerScene::_instance_update_lod_error(Instance *p_instance, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, float p_screen_lod_threshold) {
+
+	if (p_screen_lod_threshold <= 0 || p_instance->base_type != VS::INSTANCE_MESH) {
+		p_instance->lod_error = 0;
+		return;
+	}
+
+	// largest error that projects below the threshold, measured from the closest point of the bounds
+	float distance = 1.0;
+	if (!p_cam_orthogonal) {
+		const AABB &aabb = p_instance->transformed_aabb;
+		Vector3 closest = p_cam_transform.origin;
+		closest.x = CLAMP(closest.x, aabb.position.x, aabb.position.x + aabb.size.x);
+		closest.y = CLAMP(closest.y, aabb.position.y, aabb.position.y + aabb.size.y);
+		closest.z = CLAMP(closest.z, aabb.position.z, aabb.position.z + aabb.size.z);
+		distance = closest.distance_to(p_cam_transform.origin);
+	}
+	Vector3 scale = p_instance->transform.basis.get_scale_abs();
+	float max_scale = MAX(scale.x, MAX(scale.y, scale.z));
+	p_instance->lod_error = max_scale > 0 ? p_screen_lod_threshold * 2.0 * distance / (p_cam_projection.matrix[1][1] * max_scale) : 0;
+}
+
+bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario, float p_screen_lod_threshold) {
 
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
@@ -1723,6 +1745,10 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 					instance->transformed_aabb.project_range_in_plane(Plane(z_vec, 0), min, max);
 					instance->depth = near_plane.distance_to(instance->transform.origin);
 					instance->depth_layer = 0;
+					if (instance->last_render_pass != render_pass) {
+						// not seen by the camera, so its error is still from another pass
+						_instance_update_lod_error(instance, p_cam_transform, p_cam_projection, p_cam_orthogonal, p_screen_lod_threshold);
+					}
 					if (max > z_max)
 						z_max = max;
 				}
@@ -1785,6 +1811,10 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 
 							instance->depth = near_plane.distance_to(instance->transform.origin);
 							instance->depth_layer = 0;
+							if (instance->last_render_pass != render_pass) {
+								// not seen by the camera, so its error is still from another pass
+								_instance_update_lod_error(instance, p_cam_transform, p_cam_projection, p_cam_orthogonal, p_screen_lod_threshold);
+							}
 						}
 					}
 
@@ -1838,6 +1868,10 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 							}
 							instance->depth = near_plane.distance_to(instance->transform.origin);
 							instance->depth_layer = 0;
+							if (instance->last_render_pass != render_pass) {
+								// not seen by the camera, so its error is still from another pass
+								_instance_update_lod_error(instance, p_cam_transform, p_cam_projection, p_cam_orthogonal, p_screen_lod_threshold);
+							}
 						}
 					}
 
@@ -1875,6 +1909,10 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 					}
 					instance->depth = near_plane.distance_to(instance->transform.origin);
 					instance->depth_layer = 0;
+					if (instance->last_render_pass != render_pass) {
+						// not seen by the camera, so its error is still from another pass
+						_instance_update_lod_error(instance, p_cam_transform, p_cam_projection, p_cam_orthogonal, p_screen_lod_threshold);
+					}
 				}
 			}
 
@@ -1933,7 +1971,7 @@ void VisualServerScene::render_camera(RID p_camera, RID p_scenario, Size2 p_view
 		} break;
 	}
 
-	_prepare_scene(camera->transform, camera_matrix, ortho, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+	_prepare_scene(camera->transform, camera_matrix, ortho, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID(), _get_screen_lod_threshold(p_viewport_size));
 	_render_scene(camera->transform, camera_matrix, ortho, camera->env, p_scenario, p_shadow_atlas, RID(), -1);
 #endif
 }
@@ -2012,17 +2050,17 @@ void VisualServerScene::render_camera(Ref<ARVRInterface> &p_interface, ARVRInter
 		mono_transform *= apply_z_shift;
 
 		// now prepare our scene with our adjusted transform projection matrix
-		_prepare_scene(mono_transform, combined_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+		_prepare_scene(mono_transform, combined_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID(), _get_screen_lod_threshold(p_viewport_size));
 	} else if (p_eye == ARVRInterface::EYE_MONO) {
 		// For mono render, prepare as per usual
-		_prepare_scene(cam_transform, camera_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+		_prepare_scene(cam_transform, camera_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID(), _get_screen_lod_threshold(p_viewport_size));
 	}
 
 	// And render our scene...
 	_render_scene(cam_transform, camera_matrix, false, camera->env, p_scenario, p_shadow_atlas, RID(), -1);
 };
 
-void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe) {
+void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, float p_screen_lod_threshold) {
 	// Note, in stereo rendering:
 	// - p_cam_transform will be a transform in the middle of our two eyes
 	// - p_cam_projection is a wider frustrum that encompasses both eyes
@@ -2192,6 +2230,8 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 
 			ins->depth = near_plane.distance_to(ins->transform.origin);
 			ins->depth_layer = CLAMP(int(ins->depth * 16 / z_far), 0, 15);
+
+			_instance_update_lod_error(ins, p_cam_transform, p_cam_projection, p_cam_orthogonal, p_screen_lod_threshold);
 		}
 
 		if (!keep) {
@@ -2243,7 +2283,7 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 
 		for (int i = 0; i < directional_shadow_count; i++) {
 
-			_light_instance_update_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario);
+			_light_instance_update_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario, p_screen_lod_threshold);
 		}
 	}
 
@@ -2342,7 +2382,7 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 
 			if (redraw) {
 				//must redraw!
-				light->shadow_dirty = _light_instance_update_shadow(ins, p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario);
+				light->shadow_dirty = _light_instance_update_shadow(ins, p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario, p_screen_lod_threshold);
 			}
 		}
 	}
@@ -2442,7 +2482,7 @@ bool VisualServerScene::_render_reflection_probe_step(Instance *p_instance, int
 			shadow_atlas = scenario->reflection_probe_shadow_atlas;
 		}
 
-		_prepare_scene(xform, cm, false, RID(), VSG::storage->reflection_probe_get_cull_mask(p_instance->base), p_instance->scenario->self, shadow_atlas, reflection_probe->instance);
+		_prepare_scene(xform, cm, false, RID(), VSG::storage->reflection_probe_get_cull_mask(p_instance->base), p_instance->scenario->self, shadow_atlas, reflection_probe->instance, 0);
 		_render_scene(xform, cm, false, RID(), p_instance->scenario->self, shadow_atlas, reflection_probe->instance, p_step);
 
 	} else {
@@ -3701,6 +3741,8 @@ VisualServerScene::VisualServerScene() {
 	render_pass = 1;
 	singleton = this;
 	_use_bvh = GLOBAL_DEF("rendering/quality/spatial_partitioning/use_bvh", true);
+	mesh_lod_bias = GLOBAL_DEF("rendering/quality/mesh_lod/lod_bias", 1.0);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/mesh_lod/lod_bias", PropertyInfo(Variant::REAL, "rendering/quality/mesh_lod/lod_bias", PROPERTY_HINT_RANGE, "0,8,0.01"));
 }
 
 VisualServerScene::~VisualServerScene() {
@@ -30,6 +30,7 @@
 
 #include "visual_server_viewport.h"
 
+#include "core/local_vector.h"
 #include "core/project_settings.h"
 #include "visual_server_canvas.h"
 #include "visual_server_globals.h"
@@ -79,6 +80,80 @@ void VisualServerViewport::_draw_3d(Viewport *p_viewport, ARVRInterface::Eyes p_
 	}
 }
 
+void VisualServerViewport::update_damage(Viewport *p_viewport, const Rect2 &p_clip_rect, bool p_force_full) {
+
+	Viewport::Damage &damage = p_viewport->damage;
+
+	damage.pass++;
+	damage.order = 0;
+	damage.item_count = 0;
+	damage.has_rect = false;
+	damage.has_back_buffer = false;
+	damage.full = p_force_full || damage.full_next;
+	damage.full_next = false;
+	damage.textures_changed = damage.texture_serial != texture_change_serial;
+
+	// the canvas modulate tints everything drawn on it
+	for (Map<RID, Viewport::CanvasData>::Element *E = p_viewport->canvas_map.front(); E; E = E->next()) {
+
+		const Color &modulate = static_cast<VisualServerCanvas::Canvas *>(E->get().canvas)->modulate;
+		if (E->get().modulate != modulate) {
+			E->get().modulate = modulate;
+			damage.full = true;
+		}
+	}
+
+	if (p_force_full) {
+		// nothing to track, every item counts as new once tracking resumes
+		damage.items.clear();
+		damage.texture_serial = texture_change_serial;
+		return;
+	}
+
+	// the item states are refreshed even when everything gets redrawn,
+	// so the next update can go back to drawing only what changed
+	for (Map<RID, Viewport::CanvasData>::Element *E = p_viewport->canvas_map.front(); E; E = E->next()) {
+
+		VisualServerCanvas::Canvas *canvas = static_cast<VisualServerCanvas::Canvas *>(E->get().canvas);
+		Transform2D xf = _canvas_get_transform(p_viewport, canvas, &E->get(), p_clip_rect.size);
+
+		VSG::canvas->canvas_update_damage(canvas, xf, p_clip_rect, damage);
+	}
+
+	damage.texture_serial = texture_change_serial;
+
+	// items that were not drawn this time leave a hole where they used to be
+	const uint64_t *k = NULL;
+	LocalVector<uint64_t> removed;
+	while ((k = damage.items.next(k))) {
+		const Viewport::Damage::ItemState &state = damage.items.get(*k);
+		if (state.pass != damage.pass) {
+			damage.add(state.rect);
+			removed.push_back(*k);
+		}
+	}
+	for (uint32_t i = 0; i < removed.size(); i++) {
+		damage.items.erase(removed[i]);
+	}
+
+	if (damage.full || !damage.has_rect) {
+		return;
+	}
+
+	if (damage.has_back_buffer) {
+		// back buffer copies read from outside the damaged region
+		damage.full = true;
+		return;
+	}
+
+	// leave some room for filtering and antialiasing
+	Rect2 rect = damage.rect.grow(2);
+	Point2 from = rect.position.floor();
+	Point2 to = (rect.position + rect.size).ceil();
+	damage.rect = Rect2(from, to - from).clip(p_clip_rect);
+	damage.has_rect = !damage.rect.has_no_area();
+}
+
 void VisualServerViewport::_draw_viewport(Viewport *p_viewport, ARVRInterface::Eyes p_eye) {
 
 	/* Camera should always be BEFORE any other 3D */
@@ -99,8 +174,36 @@ void VisualServerViewport::_draw_viewport(Viewport *p_viewport, ARVRInterface::E
 
 	bool can_draw_3d = !p_viewport->disable_3d && !p_viewport->disable_3d_by_usage && VSG::scene->camera_owner.owns(p_viewport->camera);
 
+	Color color = p_viewport->transparent_bg ? Color(0, 0, 0, 0) : clear_color;
+
+	bool use_damage = false;
+	p_viewport->damage.items_skipped = 0;
+
+	if (p_viewport->update_mode == VS::VIEWPORT_UPDATE_WHEN_DIRTY && !p_viewport->hide_canvas) {
+
+		bool force_full = can_draw_3d || scenario_draw_canvas_bg || p_viewport->use_arvr || p_viewport->viewport_render_direct_to_screen || p_viewport->damage.clear_color != color;
+		p_viewport->damage.clear_color = color;
+		update_damage(p_viewport, Rect2(0, 0, p_viewport->size.x, p_viewport->size.y), force_full);
+
+		if (!p_viewport->damage.full) {
+			if (!p_viewport->damage.has_rect) {
+				// nothing changed, the render target still holds the last update
+				p_viewport->damage.items_skipped = p_viewport->damage.item_count;
+				return;
+			}
+			use_damage = true;
+		}
+	}
+
+	// viewports showing this one through a ViewportTexture have to redraw it
+	texture_changed(VSG::storage->render_target_get_texture(p_viewport->render_target));
+
 	if (p_viewport->clear_mode != VS::VIEWPORT_CLEAR_NEVER) {
-		VSG::rasterizer->clear_render_target(p_viewport->transparent_bg ? Color(0, 0, 0, 0) : clear_color);
+		if (use_damage) {
+			VSG::rasterizer->clear_render_target_rect(p_viewport->damage.rect, color);
+		} else {
+			VSG::rasterizer->clear_render_target(color);
+		}
 		if (p_viewport->clear_mode == VS::VIEWPORT_CLEAR_ONLY_NEXT_FRAME) {
 			p_viewport->clear_mode = VS::VIEWPORT_CLEAR_NEVER;
 		}
@@ -242,7 +345,7 @@ void VisualServerViewport::_draw_viewport(Viewport *p_viewport, ARVRInterface::E
 				ptr = ptr->filter_next_ptr;
 			}
 
-			VSG::canvas->render_canvas(canvas, xform, canvas_lights, lights_with_mask, clip_rect, canvas_layer_id);
+			VSG::canvas->render_canvas(canvas, xform, canvas_lights, lights_with_mask, clip_rect, canvas_layer_id, use_damage ? &p_viewport->damage.rect : NULL, &p_viewport->damage.items_skipped);
 			i++;
 
 			if (scenario_draw_canvas_bg && E->key().get_layer() >= scenario_canvas_max_layer) {
@@ -297,7 +400,7 @@ void VisualServerViewport::draw_viewports() {
 
 		ERR_CONTINUE(!vp->render_target.is_valid());
 
-		bool visible = vp->viewport_to_screen_rect != Rect2() || vp->update_mode == VS::VIEWPORT_UPDATE_ALWAYS || vp->update_mode == VS::VIEWPORT_UPDATE_ONCE || (vp->update_mode == VS::VIEWPORT_UPDATE_WHEN_VISIBLE && VSG::storage->render_target_was_used(vp->render_target));
+		bool visible = vp->viewport_to_screen_rect != Rect2() || vp->update_mode == VS::VIEWPORT_UPDATE_ALWAYS || vp->update_mode == VS::VIEWPORT_UPDATE_ONCE || ((vp->update_mode == VS::VIEWPORT_UPDATE_WHEN_VISIBLE || vp->update_mode == VS::VIEWPORT_UPDATE_WHEN_DIRTY) && VSG::storage->render_target_was_used(vp->render_target));
 		visible = visible && vp->size.x > 1 && vp->size.y > 1;
 
 		if (!visible)
@@ -356,6 +459,7 @@ void VisualServerViewport::draw_viewports() {
 			vp->render_info[VS::VIEWPORT_RENDER_INFO_DRAW_CALLS_IN_FRAME] = VSG::storage->get_captured_render_info(VS::INFO_DRAW_CALLS_IN_FRAME);
 			vp->render_info[VS::VIEWPORT_RENDER_INFO_2D_ITEMS_IN_FRAME] = VSG::storage->get_captured_render_info(VS::INFO_2D_ITEMS_IN_FRAME);
 			vp->render_info[VS::VIEWPORT_RENDER_INFO_2D_DRAW_CALLS_IN_FRAME] = VSG::storage->get_captured_render_info(VS::INFO_2D_DRAW_CALLS_IN_FRAME);
+			vp->render_info[VS::VIEWPORT_RENDER_INFO_2D_ITEMS_SKIPPED_IN_FRAME] = vp->damage.items_skipped;
 
 			if (vp->viewport_to_screen_rect != Rect2() && (!vp->viewport_render_direct_to_screen || !VSG::rasterizer->is_low_end())) {
 				//copy to screen if set as such
@@ -403,6 +507,7 @@ void VisualServerViewport::viewport_set_size(RID p_viewport, int p_width, int p_
 
 	viewport->size = Size2(p_width, p_height);
 	VSG::storage->render_target_set_size(viewport->render_target, p_width, p_height);
+	viewport->damage.full_next = true;
 }
 
 void VisualServerViewport::viewport_set_active(RID p_viewport, bool p_active) {
@@ -432,6 +537,7 @@ void VisualServerViewport::viewport_set_clear_mode(RID p_viewport, VS::ViewportC
 	ERR_FAIL_COND(!viewport);
 
 	viewport->clear_mode = p_clear_mode;
+	viewport->damage.full_next = true;
 }
 
 void VisualServerViewport::viewport_attach_to_screen(RID p_viewport, const Rect2 &p_rect, int p_screen) {
@@ -498,6 +604,7 @@ void VisualServerViewport::viewport_set_update_mode(RID p_viewport, VS::Viewport
 	ERR_FAIL_COND(!viewport);
 
 	viewport->update_mode = p_mode;
+	viewport->damage.full_next = true;
 }
 void VisualServerViewport::viewport_set_vflip(RID p_viewport, bool p_enable) {
 
@@ -505,6 +612,7 @@ void VisualServerViewport::viewport_set_vflip(RID p_viewport, bool p_enable) {
 	ERR_FAIL_COND(!viewport);
 
 	VSG::storage->render_target_set_flag(viewport->render_target, RasterizerStorage::RENDER_TARGET_VFLIP, p_enable);
+	viewport->damage.full_next = true;
 }
 
 RID VisualServerViewport::viewport_get_texture(RID p_viewport) const {
@@ -528,6 +636,7 @@ void VisualServerViewport::viewport_set_hide_canvas(RID p_viewport, bool p_hide)
 	ERR_FAIL_COND(!viewport);
 
 	viewport->hide_canvas = p_hide;
+	viewport->damage.full_next = true;
 }
 void VisualServerViewport::viewport_set_disable_environment(RID p_viewport, bool p_disable) {
 
@@ -584,6 +693,8 @@ void VisualServerViewport::viewport_attach_canvas(RID p_viewport, RID p_canvas)
 	viewport->canvas_map[p_canvas].layer = 0;
 	viewport->canvas_map[p_canvas].sublayer = 0;
 	viewport->canvas_map[p_canvas].canvas = canvas;
+	viewport->canvas_map[p_canvas].modulate = canvas->modulate;
+	viewport->damage.full_next = true;
 }
 
 void VisualServerViewport::viewport_remove_canvas(RID p_viewport, RID p_canvas) {
@@ -596,6 +707,7 @@ void VisualServerViewport::viewport_remove_canvas(RID p_viewport, RID p_canvas)
 
 	viewport->canvas_map.erase(p_canvas);
 	canvas->viewports.erase(p_viewport);
+	viewport->damage.full_next = true;
 }
 void VisualServerViewport::viewport_set_canvas_transform(RID p_viewport, RID p_canvas, const Transform2D &p_offset) {
 
@@ -612,6 +724,7 @@ void VisualServerViewport::viewport_set_transparent_background(RID p_viewport, b
 
 	VSG::storage->render_target_set_flag(viewport->render_target, RasterizerStorage::RENDER_TARGET_TRANSPARENT, p_enabled);
 	viewport->transparent_bg = p_enabled;
+	viewport->damage.full_next = true;
 }
 
 void VisualServerViewport::viewport_set_global_canvas_transform(RID p_viewport, const Transform2D &p_transform) {
@@ -629,6 +742,7 @@ void VisualServerViewport::viewport_set_canvas_stacking(RID p_viewport, RID p_ca
 	ERR_FAIL_COND(!viewport->canvas_map.has(p_canvas));
 	viewport->canvas_map[p_canvas].layer = p_layer;
 	viewport->canvas_map[p_canvas].sublayer = p_sublayer;
+	viewport->damage.full_next = true;
 }
 
 void VisualServerViewport::viewport_set_shadow_atlas_size(RID p_viewport, int p_size) {
@@ -655,6 +769,7 @@ void VisualServerViewport::viewport_set_msaa(RID p_viewport, VS::ViewportMSAA p_
 	ERR_FAIL_COND(!viewport);
 
 	VSG::storage->render_target_set_msaa(viewport->render_target, p_msaa);
+	viewport->damage.full_next = true;
 }
 
 void VisualServerViewport::viewport_set_use_fxaa(RID p_viewport, bool p_fxaa) {
@@ -663,6 +778,7 @@ void VisualServerViewport::viewport_set_use_fxaa(RID p_viewport, bool p_fxaa) {
 	ERR_FAIL_COND(!viewport);
 
 	VSG::storage->render_target_set_use_fxaa(viewport->render_target, p_fxaa);
+	viewport->damage.full_next = true;
 }
 
 void VisualServerViewport::viewport_set_use_debanding(RID p_viewport, bool p_debanding) {
@@ -671,6 +787,7 @@ void VisualServerViewport::viewport_set_use_debanding(RID p_viewport, bool p_deb
 	ERR_FAIL_COND(!viewport);
 
 	VSG::storage->render_target_set_use_debanding(viewport->render_target, p_debanding);
+	viewport->damage.full_next = true;
 }
 
 void VisualServerViewport::viewport_set_hdr(RID p_viewport, bool p_enabled) {
@@ -679,6 +796,7 @@ void VisualServerViewport::viewport_set_hdr(RID p_viewport, bool p_enabled) {
 	ERR_FAIL_COND(!viewport);
 
 	VSG::storage->render_target_set_flag(viewport->render_target, RasterizerStorage::RENDER_TARGET_HDR, p_enabled);
+	viewport->damage.full_next = true;
 }
 
 void VisualServerViewport::viewport_set_usage(RID p_viewport, VS::ViewportUsage p_usage) {
@@ -717,6 +835,7 @@ void VisualServerViewport::viewport_set_usage(RID p_viewport, VS::ViewportUsage
 			viewport->disable_3d_by_usage = false;
 		} break;
 	}
+	viewport->damage.full_next = true;
 }
 
 int VisualServerViewport::viewport_get_render_info(RID p_viewport, VS::ViewportRenderInfo p_info) {
@@ -767,5 +886,55 @@ void VisualServerViewport::set_default_clear_color(const Color &p_color) {
 	clear_color = p_color;
 }
 
+void VisualServerViewport::texture_changed(RID p_texture) {
+
+	if (!p_texture.is_valid()) {
+		return;
+	}
+
+	uint32_t id = p_texture.get_id();
+	texture_change_serial++;
+	texture_changes.set(id, texture_change_serial);
+
+	// proxies show the contents of their base
+	const uint32_t *k = NULL;
+	while ((k = texture_proxies.next(k))) {
+		if (texture_proxies.get(*k) == id) {
+			texture_changes.set(*k, texture_change_serial);
+		}
+	}
+}
+
+void VisualServerViewport::texture_set_proxy(RID p_proxy, RID p_base) {
+
+	// AnimatedTexture sets the same base every frame, only a new one changes what the proxy shows
+	uint32_t base = p_base.get_id();
+	const uint32_t *current = texture_proxies.getptr(p_proxy.get_id());
+	if (current && *current == base) {
+		return;
+	}
+
+	if (p_base.is_valid()) {
+		texture_proxies.set(p_proxy.get_id(), base);
+	} else {
+		texture_proxies.erase(p_proxy.get_id());
+	}
+	texture_changed(p_proxy);
+}
+
+void VisualServerViewport::texture_removed(RID p_texture) {
+
+	texture_changes.erase(p_texture.get_id());
+	texture_proxies.erase(p_texture.get_id());
+}
+
+bool VisualServerViewport::texture_changed_since(RID p_texture, uint64_t p_serial) const {
+
+	const uint64_t *serial = texture_changes.getptr(p_texture.get_id());
+	return serial && *serial > p_serial;
+}
+
 VisualServerViewport::VisualServerViewport() {
+
+	texture_change_serial = 0;
 }
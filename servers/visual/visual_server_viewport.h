@@ -31,6 +31,7 @@
 #ifndef VISUALSERVERVIEWPORT_H
 #define VISUALSERVERVIEWPORT_H
 
+#include "core/hash_map.h"
 #include "core/self_list.h"
 #include "rasterizer.h"
 #include "servers/arvr/arvr_interface.h"
@@ -103,12 +104,71 @@ public:
 			Transform2D transform;
 			int layer;
 			int sublayer;
+			Color modulate; // canvas modulate of the last update, for VS::VIEWPORT_UPDATE_WHEN_DIRTY
 		};
 
 		Transform2D global_transform;
 
 		Map<RID, CanvasData> canvas_map;
 
+		// used by VS::VIEWPORT_UPDATE_WHEN_DIRTY, keeps the state every canvas item
+		// was last drawn with, to find the region of the render target that changed
+		struct Damage {
+
+			struct ItemState {
+				Rect2 rect;
+				Transform2D xform;
+				Color modulate;
+				Rect2 clip_rect;
+				RID material;
+				uint32_t command_version;
+				int command_count;
+				uint32_t order;
+				uint64_t pass;
+				bool volatile_content; // meshes, particles etc. that can change without new commands
+			};
+
+			HashMap<uint64_t, ItemState> items;
+			uint64_t pass;
+			uint32_t order;
+			int item_count;
+			int items_skipped;
+			bool has_back_buffer;
+
+			uint64_t texture_serial; // texture changes up to this one are already drawn
+			bool textures_changed; // some texture changed since the last update
+
+			Color clear_color; // the background changes everywhere when this does
+			Rect2 rect; // region to redraw this update
+			bool has_rect;
+			bool full; // redraw everything this update
+			bool full_next; // redraw everything on the next update
+
+			Damage() {
+				pass = 0;
+				order = 0;
+				item_count = 0;
+				items_skipped = 0;
+				has_back_buffer = false;
+				texture_serial = 0;
+				textures_changed = false;
+				has_rect = false;
+				full = true;
+				full_next = true;
+			}
+
+			_FORCE_INLINE_ void add(const Rect2 &p_rect) {
+				if (has_rect) {
+					rect = rect.merge(p_rect);
+				} else {
+					rect = p_rect;
+					has_rect = true;
+				}
+			}
+		};
+
+		Damage damage;
+
 		Viewport() {
 			update_mode = VS::VIEWPORT_UPDATE_WHEN_VISIBLE;
 			clear_mode = VS::VIEWPORT_CLEAR_ALWAYS;
@@ -150,7 +210,19 @@ private:
 	void _draw_3d(Viewport *p_viewport, ARVRInterface::Eyes p_eye);
 	void _draw_viewport(Viewport *p_viewport, ARVRInterface::Eyes p_eye = ARVRInterface::EYE_MONO);
 
+	// textures whose contents changed, so VS::VIEWPORT_UPDATE_WHEN_DIRTY can redraw the items using them
+	HashMap<uint32_t, uint64_t> texture_changes; // texture RID id -> change serial
+	HashMap<uint32_t, uint32_t> texture_proxies; // proxy RID id -> base RID id
+	uint64_t texture_change_serial;
+
 public:
+	void update_damage(Viewport *p_viewport, const Rect2 &p_clip_rect, bool p_force_full);
+
+	void texture_changed(RID p_texture);
+	void texture_set_proxy(RID p_proxy, RID p_base);
+	void texture_removed(RID p_texture);
+	bool texture_changed_since(RID p_texture, uint64_t p_serial) const;
+
 	RID viewport_create();
 
 	void viewport_set_use_arvr(RID p_viewport, bool p_use_arvr);
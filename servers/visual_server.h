@@ -320,6 +320,9 @@ public:
 	virtual Vector<AABB> mesh_surface_get_skeleton_aabb(RID p_mesh, int p_surface) const = 0;
 	Array _mesh_surface_get_skeleton_aabb_bind(RID p_mesh, int p_surface) const;
 
+	// simplified index arrays, sorted by increasing error, same format as the surface index array
+	virtual void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<float> &p_errors, const Vector<PoolVector<uint8_t> > &p_index_arrays) = 0;
+
 	virtual void mesh_remove_surface(RID p_mesh, int p_index) = 0;
 	virtual int mesh_get_surface_count(RID p_mesh) const = 0;
 
@@ -396,6 +399,8 @@ public:
 	virtual int skeleton_get_bone_count(RID p_skeleton) const = 0;
 	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform) = 0;
 	virtual Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const = 0;
+	// Sets the first p_transforms.size() bones at once.
+	virtual void skeleton_set_bone_transforms(RID p_skeleton, const Vector<Transform> &p_transforms) = 0;
 	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) = 0;
 	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const = 0;
 	virtual void skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform) = 0;
@@ -635,7 +640,8 @@ public:
 		VIEWPORT_UPDATE_DISABLED,
 		VIEWPORT_UPDATE_ONCE, //then goes to disabled, must be manually updated
 		VIEWPORT_UPDATE_WHEN_VISIBLE, // default
-		VIEWPORT_UPDATE_ALWAYS
+		VIEWPORT_UPDATE_ALWAYS,
+		VIEWPORT_UPDATE_WHEN_DIRTY, // 2D only, redraws the regions that changed
 	};
 
 	virtual void viewport_set_update_mode(RID p_viewport, ViewportUpdateMode p_mode) = 0;
@@ -705,6 +711,7 @@ public:
 		VIEWPORT_RENDER_INFO_DRAW_CALLS_IN_FRAME,
 		VIEWPORT_RENDER_INFO_2D_ITEMS_IN_FRAME,
 		VIEWPORT_RENDER_INFO_2D_DRAW_CALLS_IN_FRAME,
+		VIEWPORT_RENDER_INFO_2D_ITEMS_SKIPPED_IN_FRAME,
 		VIEWPORT_RENDER_INFO_MAX
 	};
 
@@ -1038,6 +1045,9 @@ public:
 		INFO_VIDEO_MEM_USED,
 		INFO_TEXTURE_MEM_USED,
 		INFO_VERTEX_MEM_USED,
+		INFO_SHADER_COMPILES_IN_PROGRESS,
+		INFO_SHADER_COMPILER_CACHE_HITS,
+		INFO_SHADER_COMPILER_CACHE_MISSES,
 	};
 
 	virtual uint64_t get_render_info(RenderInfo p_info) = 0;